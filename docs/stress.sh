@@ -0,0 +1,53 @@
+#!/bin/bash
+# Prueba de estres del servidor (make stress): se compila con ThreadSanitizer, se inicia con -S y se le envia con
+# -L una mezcla de publicaciones, amistades, feeds y recomendaciones. Falla si ThreadSanitizer reporta algo.
+
+EXEC=./build/loopweb.out
+SOCKET=./build/stress.sock
+SCRIPT=./build/stress.txt
+LOG=./build/stress.log
+LOAD_LOG=./build/stress_load.log
+REQUESTS=${1:-4000}
+
+# Comandos al azar (con semilla fija) entre los usuarios, bandas y generos de la red
+USERS=$(grep -o '"userName":"[^"]*"' ./build/users/users.json | cut -d'"' -f4 | tr '\n' ' ')
+BANDS=$(grep -o '"bands":\[[^]]*\]' ./build/users/users.json | grep -o '"[^"]*"' | grep -v bands | tr -d '"' | sort -u | tr '\n' ' ')
+GENRES=$(grep -o '"genres":\[[^]]*\]' ./build/users/users.json | grep -o '"[^"]*"' | grep -v genres | tr -d '"' | sort -u | tr '\n' ' ')
+awk -v n="$REQUESTS" -v users="$USERS" -v bands="$BANDS" -v genres="$GENRES" 'BEGIN{
+    srand(49);
+    u = split(users, user, " "); b = split(bands, band, " "); g = split(genres, genre, " ");
+    for(i = 0; i < n; i++){
+        r = rand();
+        name = user[int(rand()*u) + 1];
+        if(r < 0.35) printf "post %s Escuchando @%s con #%s (%d)\n", name, band[int(rand()*b) + 1], genre[int(rand()*g) + 1], i;
+        else if(r < 0.50) printf "befriend %s %s\n", name, user[int(rand()*u) + 1];
+        else if(r < 0.75) printf "feed %s %d\n", name, int(rand()*10) + 1;
+        else if(r < 0.95) printf "recs %s %d\n", name, int(rand()*5) + 1;
+        else printf "profile %s\n", name;
+    }
+}' > $SCRIPT
+
+rm -f $SOCKET
+TSAN_OPTIONS="halt_on_error=0" $EXEC -S $SOCKET > $LOG 2>&1 &
+SERVER=$!
+for i in $(seq 50); do # Esperamos a que el servidor cargue las tablas
+    [ -S $SOCKET ] && break
+    sleep 0.1
+done
+
+TSAN_OPTIONS="halt_on_error=0" $EXEC -L $SOCKET < $SCRIPT > $LOAD_LOG 2>&1
+LOAD=$?
+kill -INT $SERVER
+wait $SERVER
+SERVER=$?
+
+cat $LOAD_LOG
+if grep -q "ThreadSanitizer" $LOG $LOAD_LOG; then
+    echo "stress: ThreadSanitizer reporto problemas (ver $LOG y $LOAD_LOG)"
+    exit 1
+fi
+if [ $LOAD -ne 0 ] || [ $SERVER -ne 0 ] || ! grep -q "^$REQUESTS solicitudes en" $LOAD_LOG; then
+    echo "stress: no se recibieron todas las respuestas o un proceso termino con error (ver $LOG y $LOAD_LOG)"
+    exit 1
+fi
+echo "stress: sin reportes de ThreadSanitizer"
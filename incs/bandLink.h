@@ -38,6 +38,7 @@ void print_bandLinkList(BandLinkList linkList);
 BandLinkPosition find_bandLinkList_node(BandLinkList linkList, char* band);
 BandLinkPosition find_bandLinkList_prev_node(BandLinkPosition P, BandLinkList linkList);
 BandLinkPosition insert_bandLinkList_node_basicInfo(BandLinkPosition prevPosition, char* band);
+BandLinkPosition insert_bandLinkList_node_text(BandLinkPosition prevPosition, const char* band, size_t length);
 BandLinkPosition insert_bandLinkList_node_completeInfo(BandLinkPosition prevPosition, PtrToBand bandNode);
 void delete_bandLinkList_node(BandLinkPosition P, BandLinkList linkList);
 
@@ -8,6 +8,7 @@
 #define BANDS_H
 
 #define BANDS_TABLE_SIZE 20 /**< Tamaño de la tabla hash de bandas */
+#define BANDS_FILE "./build/bands.json" /**< Archivo donde se guarda la tabla */
 
 typedef struct _band Band;
 typedef Band* PtrToBand;
@@ -18,8 +19,12 @@ typedef struct _bandHashTable* BandTable;
 #include <stdbool.h>
 #include <string.h>
 #include <stdlib.h>
+#include <pthread.h>
+#include "hydration.h"
 #include "hash.h"
 #include "commentLink.h"
+#include "trigram.h"
+#include "prefixTrie.h"
 
 /** \struct _band
  * @brief Representa un banda en la lista de bandas
@@ -36,7 +41,10 @@ struct _band {
 struct _bandHashTable {
     BandList buckets[BANDS_TABLE_SIZE];  /**< Arreglo de punteros a listas enlazadas de bandas */
     int bandCount;                       /**< Contador de bandas */
+    TrigramIndex trigrams;               /**< Trigramas de los nombres de las bandas (se construye al necesitarse) */
+    PrefixTrie completions;              /**< Trie de los nombres de las bandas pesados por publicaciones (se construye al necesitarse) */
     bool modified;                       /**< Indica si la tabla ha sido modificada desde que se cargo */
+    pthread_rwlock_t lock;               /**< Candado de lectores y escritores para usar la tabla desde varios hilos (ver script.c) */
 };
 
 // Funciones para listas de bandas
@@ -62,7 +70,9 @@ BandPosition insert_bandTable_band(char* band, BandTable bandTable);
 void delete_bandTable_band(char* band, BandTable bandTable);
 void delete_bandTable(BandTable bandTable);
 BandPosition find_bandTable_band(char* band, BandTable bandTable);
-void save_bandTable(BandTable bandTable);
+bool save_bandTable(BandTable bandTable);
 BandLinkList get_loopweb_bands(BandTable table);
+TrigramIndex get_bandTable_trigrams(BandTable bandTable);
+PrefixTrie get_bandTable_completions(BandTable bandTable);
 
 #endif
\ No newline at end of file
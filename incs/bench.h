@@ -0,0 +1,78 @@
+/**
+ * @file bench.h
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Cabeceras para funciones de bench.c
+*/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#define BENCH_USERS 4000        /**< Usuarios de la red sintetica */
+#define BENCH_FRIENDS 8         /**< Amigos de cada usuario sintetico */
+#define BENCH_GENRES 40         /**< Generos distintos de la red sintetica */
+#define BENCH_BANDS 400         /**< Bandas distintas de la red sintetica */
+#define BENCH_USER_GENRES 3     /**< Generos de cada usuario sintetico */
+#define BENCH_USER_BANDS 5      /**< Bandas de cada usuario sintetico */
+#define BENCH_ROUNDS 20         /**< Repeticiones de cada medicion (se informa el promedio) */
+#define BENCH_COMMENTS 10000    /**< Publicaciones sinteticas */
+#define BENCH_TAG_PERIOD 12     /**< En promedio una de cada BENCH_TAG_PERIOD palabras de una publicacion es una etiqueta */
+#define BENCH_SEED 12345u       /**< Semilla de los datos sinteticos (asi cada ejecucion mide lo mismo) */
+#define BENCH_IDS 500000        /**< IDs de publicaciones que genera cada proceso en la prueba de colisiones */
+#define BENCH_ID_PROCESSES 2    /**< Procesos que generan IDs a la vez */
+#define BENCH_ID_THREADS 4      /**< Hilos que generan IDs en cada proceso */
+#define BENCH_ID_RATE 100000    /**< Publicaciones por segundo que debe sostener cada proceso */
+#define BENCH_GRAPH_USERS 1000000   /**< Usuarios de la red con grados en ley de potencias de `bench_friend_bfs` */
+#define BENCH_GRAPH_MIN_DEGREE 2    /**< Grado minimo de la red con grados en ley de potencias */
+#define BENCH_GRAPH_MAX_DEGREE 1000 /**< Grado maximo de la red con grados en ley de potencias */
+#define BENCH_GRAPH_EXPONENT 2.5    /**< Exponente de la ley de potencias de los grados (P(k) ~ k^-exponente) */
+#define BENCH_BFS_SOURCES 20        /**< Usuarios desde los que se buscan amigos posibles en `bench_friend_bfs` */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "errors.h"
+#include "user.h"
+#include "userLink.h"
+#include "graph.h"
+#include "genreLink.h"
+#include "bandLink.h"
+#include "comments.h"
+#include "commentLink.h"
+#include "tagScanner.h"
+#include "render.h"
+#include "utilities.h"
+#include "recommendations.h"
+#include "threadpool.h"
+#include "textIndex.h"
+
+// Funciones de medicion
+void bench_recommendations();
+void bench_tags();
+void bench_feed_render();
+void bench_comment_IDs();
+void bench_friend_bfs();
+void run_bench_ID_process(FILE* out);
+
+// Funciones de datos sinteticos
+UserTable create_bench_users(int count);
+UserTable create_bench_powerlaw_users(int count);
+char** create_bench_texts(int count, unsigned int* state);
+void delete_bench_texts(char** texts, int count);
+CommentPosition* create_bench_comments(int count, unsigned int* state);
+
+// Funciones auxiliares
+double bench_seconds();
+unsigned int bench_random(unsigned int* state);
+int scan_tags_scalar(const char* text, TagHandler handler, void* arg);
+UserLinkList find_possible_friends_list(UserPosition user, UserTable table, int maxDepth);
+void count_bench_tag(char mark, const char* tag, size_t length, void* arg);
+void generate_bench_IDs(void* arg, int worker, int first, int last);
+void print_commentNode_stdio(FILE* out, PtrToComment comment);
+void print_loopweb_stdio(FILE* out, const char* text);
+
+#endif
@@ -0,0 +1,40 @@
+/**
+ * @file bitmap.h
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Cabeceras para funciones de bitmap.c
+*/
+
+#ifndef BITMAP_H
+#define BITMAP_H
+
+typedef struct _bitmap* Bitmap;
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "errors.h"
+
+/** \struct _bitmap
+ * @brief Conjunto de enteros densos (IDs) representado con un bit por elemento
+*/
+struct _bitmap {
+    unsigned long long* words; /**< Palabras de 64 bits que almacenan el conjunto */
+    int wordCount;             /**< Cantidad de palabras reservadas */
+    int count;                 /**< Cantidad de elementos presentes en el conjunto */
+};
+
+// Funciones del bitmap
+Bitmap create_bitmap(int bits);
+void delete_bitmap(Bitmap bitmap);
+void clear_bitmap(Bitmap bitmap);
+void resize_bitmap(Bitmap bitmap, int bits);
+bool test_bitmap_bit(Bitmap bitmap, int bit);
+bool set_bitmap_bit(Bitmap bitmap, int bit);
+bool unset_bitmap_bit(Bitmap bitmap, int bit);
+int next_bitmap_bit(Bitmap bitmap, int from);
+
+// Operaciones de conjunto sobre bitmaps
+int intersection_count_bitmap(Bitmap a, Bitmap b);
+double jacardIndex_bitmap(Bitmap a, Bitmap b);
+
+#endif
@@ -27,6 +27,7 @@ typedef PtrToCommentLinkNode CommentLinkList;
 */
 struct _commentLinkNode {
     time_t commentID /*!< Nombre del Comentario */;
+    double coefficient;       /*!< Coeficiente del nodo (usado en varias funciones) */
     PtrToComment commentNode; /*!< Comentario en la red */
     CommentLinkPosition next; /*!< Posicion siguiente en la lista */
 };
@@ -9,6 +9,15 @@
 #define COMMENTS_PATH "./build/comments/"
 #define MAX_COMMENT_LENGTH 300
 #define COMMENTS_TABLE_SIZE 10 /**< Tamaño de la tabla hash de comentarios */
+#define RECENT_COMMENTS_PAGE 20 /**< Cantidad de publicaciones recientes que se muestran cuando un feed no tiene coincidencias */
+
+// IDs de comentarios: milisegundos desde COMMENT_ID_EPOCH_MS | proceso | secuencia (ver next_comment_ID)
+#define COMMENT_ID_EPOCH_MS 1577836800000LL  /**< Epoca de los IDs (2020-01-01 00:00:00 UTC) en milisegundos */
+#define COMMENT_ID_WORKER_BITS 10            /**< Bits del identificador del proceso que genera el ID */
+#define COMMENT_ID_SEQUENCE_BITS 12          /**< Bits de la secuencia dentro de un mismo milisegundo */
+#define COMMENT_ID_LEGACY_LIMIT ((time_t)1 << 32) /**< Los IDs menores son de la version anterior (segundos desde 1970) */
+#define COMMENT_WORKER_ENV "LOOPWEB_WORKER"   /**< Variable de entorno con el identificador de proceso preferido */
+#define COMMENT_WORKER_LOCK "./build/.commentWorker%d.lock" /**< Archivo con que un proceso reserva su identificador */
 
 typedef struct _commentNode CommentNode;
 typedef CommentNode* PtrToComment;
@@ -18,24 +27,36 @@ typedef struct _commentHashTable* CommentTable;
 
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 #include <time.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <pthread.h>
+#include "hydration.h"
 #include "errors.h"
 #include "hash.h"
 #include "user.h"
 #include "userLink.h"
 #include "genreLink.h"
 #include "commentLink.h"
+#include "textIndex.h"
+#include "tagScanner.h"
+#include "render.h"
 
 /** \struct _commentNode
  * @brief Estructura que representa un nodo de comentario.
 */
 struct _commentNode {
-    time_t ID;                    /**< Identificador del comentario */
+    time_t ID;                    /**< Identificador del comentario (ordenado por fecha, ver `comment_ID_to_time`) */
     char* text;                   /**< Texto del comentario */
     bool complete;               /**< Indica si los tags del comentario están completos */
     UserLinkPosition user;            /**< Usuario del comentario */
     GenreLinkList genres;         /**< Gustos musicales del comentario */
     BandLinkList bands;           /**< Bandas del comentario */
+    unsigned int rankStamp;       /**< Generacion del ultimo ranking de feed que marco este comentario */
+    int rankMatches;              /**< Cantidad de bandas y generos del usuario que coinciden con el comentario (valido si rankStamp es la generacion actual) */
     PtrToComment next;            /**< Puntero al siguiente nodo de la lista enlazada */
 };
 
@@ -45,11 +66,23 @@ struct _commentNode {
 struct _commentHashTable {
     CommentList buckets[COMMENTS_TABLE_SIZE];  /**< Arreglo de punteros a listas enlazadas de comentarios */
     int commentCount;                             /**< Contador de comentarios */
+    unsigned int rankGeneration;               /**< Generacion del ranking de feed actual (ver rankStamp) */
+    time_t* recentIDs;                         /**< Indice cronologico: IDs de todos los comentarios ordenados de mas antiguo a mas reciente */
+    int recentCount;                           /**< Cantidad de IDs en el indice cronologico */
+    int recentCapacity;                        /**< Capacidad reservada del indice cronologico */
+    bool recentLoading;                        /**< Indica que se esta leyendo comments.json: los IDs se agregan al final y se ordenan al terminar */
+    TextIndex textIndex;                       /**< Indice de las palabras de los textos (se construye al necesitarse) */
     bool modified;                             /**< Indica si la tabla ha sido modificada desde que se cargo */
+    pthread_rwlock_t lock;                     /**< Candado de lectores y escritores para usar la tabla desde varios hilos (ver script.c) */
 };
 
+extern uint64_t commentIDState;
+extern int commentWorkerID;
+extern int commentWorkerFd;
+
 // Funciones para un nodo de usuario
 void print_commentNode(PtrToComment comment);
+void render_commentNode(RenderBuffer buffer, PtrToComment comment);
 void save_commentNode(PtrToComment comment);
 
 // Funciones de la lista de usuarios
@@ -63,6 +96,7 @@ CommentPosition create_new_comment(time_t ID, const char *text, char* author);
 CommentPosition insert_CommentList_node(CommentPosition prevPosition, CommentPosition newNode);
 CommentPosition complete_commentList_node(CommentPosition P, char* text, char* author);
 bool delete_CommentList_node(CommentPosition P, CommentList commentList);
+void delete_commentNode(CommentPosition P);
 
 
 // Funciones de interaccion con el usuario
@@ -79,7 +113,24 @@ void delete_commentTable(CommentTable commentTable);
 CommentPosition find_commentTable_comment(time_t ID, CommentTable commentTable);
 void save_commentTable(CommentTable commentTable);
 
+// Indice cronologico de comentarios
+int find_recentIndex_position(CommentTable commentTable, time_t ID);
+void insert_recentIndex_ID(CommentTable commentTable, time_t ID);
+void sort_recentIndex(CommentTable commentTable);
+void delete_recentIndex_ID(CommentTable commentTable, time_t ID);
+CommentLinkList get_recent_comments(CommentTable commentTable, int n);
+
+// IDs de comentarios
+time_t next_comment_ID(CommentTable commentTable);
+void init_comment_worker();
+bool claim_comment_worker(int worker);
+time_t comment_ID_to_time(time_t ID);
+unsigned int comment_ID_hash(time_t ID);
+int compare_commentIDs(const void* a, const void* b);
+
 // Ordenamiento y completacion
 CommentPosition complete_comment_tags(CommentPosition comment);
+void insert_comment_tag(char mark, const char* tag, size_t length, void* arg);
+int replace_comment_tag(CommentPosition comment, char mark, const char* oldTag, const char* newTag);
 
 #endif
\ No newline at end of file
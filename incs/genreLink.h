@@ -38,6 +38,7 @@ void print_genreLinkList(GenreLinkList linkList);
 GenreLinkPosition find_genreLinkList_node(GenreLinkList linkList, char* genre);
 GenreLinkPosition find_genreLinkList_prev_node(GenreLinkPosition P, GenreLinkList linkList);
 GenreLinkPosition insert_genreLinkList_node_basicInfo(GenreLinkPosition prevPosition, char* genre);
+GenreLinkPosition insert_genreLinkList_node_text(GenreLinkPosition prevPosition, const char* genre, size_t length);
 GenreLinkPosition insert_genreLinkList_node_completeInfo(GenreLinkPosition prevPosition, PtrToGenre genreNode);
 void delete_genreLinkList_node(GenreLinkPosition P, GenreLinkList linkList);
 
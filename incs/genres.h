@@ -8,6 +8,7 @@
 #define GENRES_H
 
 #define GENRE_TABLE_SIZE 20 /**< Tamaño de la tabla hash de generos musicales */
+#define GENRES_FILE "./build/genres.json" /**< Archivo donde se guarda la tabla */
 
 typedef struct _genre Genre;
 typedef Genre* PtrToGenre;
@@ -18,8 +19,12 @@ typedef struct _genreTable* GenreTable;
 #include <stdbool.h>
 #include <string.h>
 #include <stdlib.h>
+#include <pthread.h>
+#include "hydration.h"
 #include "hash.h"
 #include "commentLink.h"
+#include "trigram.h"
+#include "prefixTrie.h"
 
 /** \struct _genre
  * @brief Representa un genero musical en la lista de generos
@@ -36,7 +41,10 @@ struct _genre {
 struct _genreTable {
     GenreList buckets[GENRE_TABLE_SIZE];  /**< Arreglo de punteros a listas enlazadas de generos musicales */
     int genreCount;                              /**< Contador de generos musicales */
+    TrigramIndex trigrams;                       /**< Trigramas de los nombres de los generos (se construye al necesitarse) */
+    PrefixTrie completions;                      /**< Trie de los nombres de los generos pesados por publicaciones (se construye al necesitarse) */
     bool modified;                              /**< Indica si la tabla ha sido modificada desde que se cargo */
+    pthread_rwlock_t lock;                      /**< Candado de lectores y escritores para usar la tabla desde varios hilos (ver script.c) */
 };
 
 // Funciones para listas de generos musicales
@@ -62,7 +70,9 @@ GenrePosition insert_genre(char* genre, GenreTable genresTable);
 void delete_genresTable_genre(char* genre, GenreTable genresTable);
 void delete_genresTable(GenreTable genresTable);
 GenrePosition find_genresTable_genre(char* genre, GenreTable genresTable);
-void save_genresTable(GenreTable bandTable);
+bool save_genresTable(GenreTable genresTable);
 GenreLinkList get_loopweb_genres(GenreTable table);
+TrigramIndex get_genresTable_trigrams(GenreTable genresTable);
+PrefixTrie get_genresTable_completions(GenreTable genresTable);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,119 @@
+/**
+ * @file graph.h
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Cabeceras para funciones de graph.c
+*/
+
+#ifndef GRAPH_H
+#define GRAPH_H
+
+typedef struct _friendGraph* FriendGraph;
+typedef struct _idQueue* IDQueue;
+typedef struct _graphSignals GraphSignals;
+typedef struct _searchSide SearchSide;
+typedef struct _graphSearch* GraphSearch;
+
+#define GRAPH_SIGNALS_BUFFER 256 /**< Amigos en comun que caben en el buffer local (sobre esto se reserva memoria) */
+#define GRAPH_PATH_MAX_DEPTH 16  /**< Grados de separacion maximos que se buscan entre dos usuarios */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "errors.h"
+#include "bitmap.h"
+#include "user.h"
+#include "userLink.h"
+
+/** \struct _friendGraph
+ * @brief Grafo de amistades sobre los IDs densos de los usuarios (listas de adyacencia ordenadas)
+*/
+struct _friendGraph {
+    int** adjacency;  /**< IDs de los amigos de cada usuario, ordenados de menor a mayor */
+    int* degree;      /**< Cantidad de amigos de cada usuario */
+    int* capacity;    /**< Capacidad reservada de cada lista de adyacencia */
+    int nodeCount;    /**< Cantidad de IDs cubiertos por el grafo */
+    int nodeCapacity; /**< Capacidad reservada de los arreglos de nodos */
+    int edgeCount;    /**< Cantidad de aristas (dirigidas) del grafo */
+};
+
+/** \struct _idQueue
+ * @brief Cola circular de IDs almacenada en un arreglo contiguo
+*/
+struct _idQueue {
+    int* items;   /**< Arreglo circular de IDs */
+    int head;     /**< Posicion del primer elemento */
+    int count;    /**< Cantidad de elementos en la cola */
+    int capacity; /**< Capacidad del arreglo */
+};
+
+/** \struct _graphSignals
+ * @brief Medidas de cercania entre dos usuarios segun sus amigos en comun
+*/
+struct _graphSignals {
+    int mutualFriends;         /**< Cantidad de amigos en comun */
+    double adamicAdar;         /**< Suma de 1/log(grado) de los amigos en comun */
+    double resourceAllocation; /**< Suma de 1/grado de los amigos en comun */
+};
+
+/** \struct _searchSide
+ * @brief Estado de uno de los dos lados de una busqueda en anchura bidireccional
+*/
+struct _searchSide {
+    unsigned int* stamp; /**< Generacion de la busqueda en que se visito cada ID (visitado si es la actual) */
+    int* parent;         /**< ID desde el que se llego a cada ID visitado */
+    int* frontier;       /**< IDs del nivel actual */
+    int* next;           /**< IDs del nivel siguiente */
+    int frontierSize;    /**< Cantidad de IDs del nivel actual */
+};
+
+/** \struct _graphSearch
+ * @brief Memoria reutilizable para buscar caminos entre usuarios
+ *
+ * Los visitados se marcan con la generacion de la busqueda, por lo que no hay que limpiar los arreglos entre
+ * busquedas y cada una cuesta solo lo que explora.
+*/
+struct _graphSearch {
+    SearchSide sides[2];     /**< Lado que parte del origen (0) y lado que parte del destino (1) */
+    unsigned int generation; /**< Generacion de la busqueda actual */
+    int capacity;            /**< Cantidad de IDs con espacio reservado */
+};
+
+// Funciones del grafo de amistades
+FriendGraph create_friendGraph(int nodeCapacity);
+void delete_friendGraph(FriendGraph graph);
+void ensure_friendGraph_node(FriendGraph graph, int ID);
+int find_friendGraph_position(FriendGraph graph, int from, int to);
+bool has_friendGraph_edge(FriendGraph graph, int from, int to);
+bool add_friendGraph_edge(FriendGraph graph, int from, int to);
+int friendGraph_degree(FriendGraph graph, int ID);
+int* friendGraph_neighbors(FriendGraph graph, int ID);
+FriendGraph build_friendGraph(UserTable table);
+FriendGraph get_friendGraph(UserTable table);
+GraphSignals friendGraph_signals(FriendGraph graph, int from, int to);
+
+// Funciones de interseccion de listas ordenadas de IDs
+int intersect_sorted_ids(const int* a, int sizeA, const int* b, int sizeB, int* out);
+int intersect_sorted_ids_scalar(const int* a, int sizeA, const int* b, int sizeB, int* out);
+
+// Funciones de busqueda de caminos
+GraphSearch create_graphSearch(int capacity);
+void delete_graphSearch(GraphSearch search);
+void ensure_graphSearch_capacity(GraphSearch search, int capacity);
+int expand_searchSide(GraphSearch search, FriendGraph graph, int side);
+UserLinkList find_friendship_path(GraphSearch search, UserTable table, int from, int to, int maxDepth);
+
+// Funciones de la cola circular de IDs
+IDQueue create_idQueue(int capacity);
+void delete_idQueue(IDQueue queue);
+bool is_empty_idQueue(IDQueue queue);
+void enqueue_idQueue(IDQueue queue, int ID);
+int dequeue_idQueue(IDQueue queue);
+
+// Funciones auxiliares
+int compare_ids(const void* a, const void* b);
+
+#endif
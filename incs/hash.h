@@ -8,9 +8,11 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include "errors.h"
 
 unsigned int jenkins_hash(char* key);
 unsigned int hashFile (char *filename);
+uint64_t mix_hash(uint64_t x);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,46 @@
+/**
+ * @file heap.h
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Cabeceras para funciones de heap.c
+*/
+
+#ifndef HEAP_H
+#define HEAP_H
+
+typedef struct _scoreHeapEntry ScoreHeapEntry;
+typedef struct _scoreHeap* ScoreHeap;
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include "errors.h"
+
+/** \struct _scoreHeapEntry
+ * @brief Elemento de un heap de puntajes
+*/
+struct _scoreHeapEntry {
+    double score; /**< Puntaje del elemento */
+    void* data;   /**< Elemento asociado al puntaje (no es propiedad del heap) */
+};
+
+/** \struct _scoreHeap
+ * @brief Min-heap acotado que conserva los K elementos de mayor puntaje
+*/
+struct _scoreHeap {
+    ScoreHeapEntry* entries; /**< Arreglo de elementos del heap */
+    int size;                /**< Cantidad de elementos almacenados */
+    int capacity;            /**< Cantidad maxima de elementos (K) */
+};
+
+// Funciones del heap de puntajes
+ScoreHeap create_scoreHeap(int capacity);
+void delete_scoreHeap(ScoreHeap heap);
+bool is_full_scoreHeap(ScoreHeap heap);
+double scoreHeap_min(ScoreHeap heap);
+bool push_scoreHeap(ScoreHeap heap, double score, void* data);
+int sort_scoreHeap(ScoreHeap heap);
+
+// Funciones auxiliares del heap
+void swap_scoreHeap_entries(ScoreHeapEntry* a, ScoreHeapEntry* b);
+void sift_down_scoreHeap(ScoreHeapEntry* entries, int size, int i);
+
+#endif
@@ -0,0 +1,29 @@
+/**
+ * @file hydration.h
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Cabeceras para funciones de hydration.c
+*/
+
+#ifndef HYDRATION_H
+#define HYDRATION_H
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // pthread_rwlockattr_setkind_np
+#endif
+#define HYDRATION_STRIPES 64 /**< Cantidad de candados que se reparten los nodos (potencia de 2) */
+
+#include <stdint.h>
+#include <pthread.h>
+
+// Funciones de los candados de completacion
+void lock_hydration(const void* node);
+void unlock_hydration(const void* node);
+
+// Funciones de los candados de las tablas
+void init_table_lock(pthread_rwlock_t* lock);
+
+// Funciones auxiliares
+pthread_mutex_t* get_hydration_lock(const void* node);
+void init_hydration_locks();
+
+#endif
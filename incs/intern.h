@@ -0,0 +1,43 @@
+/**
+ * @file intern.h
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Cabeceras para funciones de intern.c
+*/
+
+#ifndef INTERN_H
+#define INTERN_H
+
+#define INTERN_TABLE_SIZE 64 /**< Cantidad inicial de casillas de una tabla de internado */
+
+typedef struct _internTable* InternTable;
+
+#include <stdlib.h>
+#include <string.h>
+#include "errors.h"
+#include "hash.h"
+
+/** \struct _internTable
+ * @brief Tabla que asigna un ID denso (0, 1, 2, ...) a cada cadena distinta que recibe
+ *
+ * Usa direccionamiento abierto con sondeo lineal, por lo que buscar una cadena no reserva memoria.
+*/
+struct _internTable {
+    int* slots;         /**< Casillas de la tabla hash, cada una guarda un ID o -1 si esta libre */
+    int slotCapacity;   /**< Cantidad de casillas (siempre potencia de 2) */
+    char** names;       /**< Cadenas internadas, indexadas por su ID */
+    int count;          /**< Cantidad de cadenas internadas */
+    int nameCapacity;   /**< Capacidad reservada de names */
+};
+
+// Funciones de la tabla de internado
+InternTable create_internTable(InternTable table);
+void delete_internTable(InternTable table);
+int find_internTable_ID(InternTable table, char* name);
+int intern_string(InternTable table, char* name);
+char* get_interned_string(InternTable table, int ID);
+
+// Funciones auxiliares de la tabla de internado
+int find_internTable_slot(InternTable table, char* name);
+void grow_internTable(InternTable table);
+
+#endif
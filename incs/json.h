@@ -15,6 +15,7 @@
 #include "userLink.h"
 #include "genreLink.h"
 #include "bandLink.h"
+#include "hydration.h"
 
 UserTable get_users_from_file(const char *filePath, UserTable table);
 BandTable get_bands_from_file(const char* filePath, BandTable table);
@@ -22,6 +23,7 @@ GenreTable get_genres_from_file(const char* filePath, GenreTable genreTable);
 CommentTable get_comments_from_file(const char* filePath, CommentTable commentTable);
 UserPosition complete_user_from_json(UserPosition user);
 CommentPosition complete_comment_from_json(CommentPosition comment);
+int read_age_json(json_t *age_json);
 UserLinkList read_friends_json(json_t *friends_json);
 GenreLinkList read_genres_json(json_t *genres_json);
 BandLinkList read_band_json(json_t *comments_json);
@@ -0,0 +1,69 @@
+/**
+ * @file lsh.h
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Cabeceras para funciones de lsh.c
+*/
+
+#ifndef LSH_H
+#define LSH_H
+
+#define LSH_HASHES 32                    /**< Cantidad de funciones hash de la firma MinHash */
+#define LSH_ROWS 2                       /**< Valores de la firma por banda (mas filas = candidatos mas parecidos) */
+#define LSH_BANDS (LSH_HASHES/LSH_ROWS)  /**< Cantidad de bandas de la firma */
+#define LSH_MIN_BUCKETS 256              /**< Cantidad minima de buckets por banda (siempre una potencia de 2) */
+#define LSH_BAND_SALT 0x5BD1E995u        /**< Diferencia el hash de una banda del de un genero con el mismo nombre */
+
+typedef struct _lshBucket LshBucket;
+typedef struct _tasteIndex* TasteIndex;
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "errors.h"
+#include "bitmap.h"
+#include "user.h"
+
+/** \struct _lshBucket
+ * @brief Usuarios cuya firma cae en un mismo bucket de una banda
+*/
+struct _lshBucket {
+    int* IDs;     /**< IDs de los usuarios del bucket */
+    int count;    /**< Cantidad de usuarios del bucket */
+    int capacity; /**< Capacidad reservada de IDs */
+};
+
+/** \struct _tasteIndex
+ * @brief Indice LSH sobre firmas MinHash de los gustos (generos y bandas) de cada usuario
+ *
+ * Dos usuarios son candidatos si coinciden en todas las filas de al menos una banda, lo que ocurre con
+ * probabilidad 1 - (1 - J^LSH_ROWS)^LSH_BANDS, donde J es el indice de Jaccard entre sus gustos. Como hay al menos
+ * tantos buckets por banda como usuarios, cada bucket guarda en promedio menos de un usuario que no comparta la banda.
+*/
+struct _tasteIndex {
+    LshBucket* buckets[LSH_BANDS]; /**< Buckets de cada banda (bucketCount por banda) */
+    int bucketCount;               /**< Buckets por banda: se duplica cuando hay mas usuarios indexados que buckets */
+    int indexedCount;              /**< Cantidad de usuarios en el indice */
+    unsigned int* signatures;      /**< Firma de cada usuario (LSH_HASHES valores por ID) */
+    Bitmap indexed;                /**< IDs que estan actualmente en el indice */
+    int capacity;                  /**< Cantidad de IDs con espacio reservado en signatures */
+};
+
+// Funciones de las firmas MinHash
+unsigned int minhash_mix(unsigned int key, int hashIndex);
+bool compute_minhash_signature(UserPosition user, UserTable table, unsigned int* signature);
+unsigned int lsh_band_hash(const unsigned int* signature, int band);
+
+// Funciones del indice de gustos
+TasteIndex create_tasteIndex(int capacity);
+void delete_tasteIndex(TasteIndex index);
+LshBucket* create_lshBuckets(int count);
+void delete_lshBuckets(LshBucket* buckets, int count);
+void resize_tasteIndex(TasteIndex index, int bucketCount);
+void insert_lshBucket_ID(LshBucket* bucket, int ID);
+void delete_lshBucket_ID(LshBucket* bucket, int ID);
+void remove_tasteIndex_user(TasteIndex index, int ID);
+void update_tasteIndex_user(TasteIndex index, UserPosition user, UserTable table);
+int query_tasteIndex(TasteIndex index, int ID, Bitmap candidates);
+TasteIndex get_tasteIndex(UserTable table);
+
+#endif
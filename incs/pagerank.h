@@ -0,0 +1,74 @@
+/**
+ * @file pagerank.h
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Cabeceras para funciones de pagerank.c
+*/
+
+#ifndef PAGERANK_H
+#define PAGERANK_H
+
+typedef struct _tasteGraph* TasteGraph;
+typedef struct _walkJob WalkJob;
+
+#define PPR_WALKS 20000          /**< Cantidad de recorridos por defecto */
+#define PPR_TIME_LIMIT_MS 250    /**< Tiempo maximo (en milisegundos) para simular los recorridos */
+#define PPR_RESTART 0.15         /**< Probabilidad de volver al usuario de origen en cada paso */
+#define PPR_TASTE_PROB 0.3       /**< Probabilidad de saltar por una banda o genero en vez de por una amistad */
+#define PPR_MAX_STEPS 64         /**< Largo maximo de un recorrido */
+#define PPR_BATCH 256            /**< Recorridos por bloque (el tiempo maximo se revisa entre bloques) */
+#define PPR_SEED 0x9E3779B97F4A7C15ULL /**< Semilla base de los generadores de cada hilo */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include "errors.h"
+#include "bitmap.h"
+#include "graph.h"
+#include "user.h"
+#include "userLink.h"
+#include "threadpool.h"
+
+/** \struct _tasteGraph
+ * @brief Grafo bipartito usuario-gusto en formato CSR (listas de adyacencia contiguas)
+ *
+ * Los gustos comparten un mismo espacio de IDs: los generos van de 0 a genreCount-1 y las bandas siguen despues.
+*/
+struct _tasteGraph {
+    int* userOffsets; /**< Inicio de los gustos de cada usuario en userTags (userCount+1 valores) */
+    int* userTags;    /**< Gustos de cada usuario, uno tras otro */
+    int* tagOffsets;  /**< Inicio de los usuarios de cada gusto en tagUsers (tagCount+1 valores) */
+    int* tagUsers;    /**< Usuarios de cada gusto, uno tras otro */
+    int userCount;    /**< Cantidad de IDs de usuario cubiertos */
+    int tagCount;     /**< Cantidad de gustos (generos mas bandas) */
+    int genreCount;   /**< Cantidad de generos (primer ID de banda) */
+};
+
+/** \struct _walkJob
+ * @brief Trabajo compartido por los hilos que simulan recorridos aleatorios
+*/
+struct _walkJob {
+    FriendGraph friends;       /**< Grafo de amistades (solo lectura) */
+    TasteGraph tastes;         /**< Grafo usuario-gusto (solo lectura) */
+    int source;                /**< ID del usuario de origen */
+    unsigned int** visits;     /**< Visitas a cada usuario contadas por cada hilo */
+    unsigned long long* rng;   /**< Estado del generador aleatorio de cada hilo */
+    int* walks;                /**< Recorridos completados por cada hilo */
+    struct timespec deadline;  /**< Momento en que se dejan de simular bloques */
+};
+
+// Funciones del grafo usuario-gusto
+TasteGraph build_tasteGraph(UserTable table);
+void delete_tasteGraph(TasteGraph graph);
+TasteGraph get_tasteGraph(UserTable table);
+
+// Funciones de los recorridos aleatorios
+unsigned long long random_next(unsigned long long* state);
+int random_below(unsigned long long* state, int bound);
+double random_unit(unsigned long long* state);
+bool deadline_passed(const struct timespec* deadline);
+int random_walk_step(WalkJob* job, int current, unsigned long long* state);
+void random_walks_task(void* arg, int worker, int first, int last);
+UserLinkList compute_user_pagerank_recommendations(UserPosition user, UserTable table, ThreadPool pool, int walks, int timeLimitMs, int k);
+
+#endif
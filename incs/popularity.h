@@ -0,0 +1,80 @@
+/**
+ * @file popularity.h
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Cabeceras para funciones de popularity.c
+*/
+
+#ifndef POPULARITY_H
+#define POPULARITY_H
+
+typedef struct _popularity* Popularity;
+typedef struct _pageRankJob PageRankJob;
+
+#define POPULARITY_PATH "./build/popularity.txt"  /**< Archivo con la popularidad calculada de los usuarios */
+#define POPULARITY_SIZE 10                        /**< Cantidad de usuarios populares que se muestran por defecto */
+#define PAGERANK_DAMPING 0.85                     /**< Probabilidad de seguir una amistad en vez de saltar a cualquier usuario */
+#define PAGERANK_TOLERANCE 1e-9                   /**< Cambio total (norma L1) bajo el que se considera que el calculo convergio */
+#define PAGERANK_MAX_ITERATIONS 100               /**< Iteraciones maximas de un calculo completo */
+#define PAGERANK_REFRESH_ITERATIONS 20            /**< Iteraciones maximas al actualizar desde el resultado anterior */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "errors.h"
+#include "graph.h"
+#include "heap.h"
+#include "user.h"
+#include "userLink.h"
+#include "threadpool.h"
+#include "utilities.h"
+
+/** \struct _popularity
+ * @brief PageRank de cada usuario sobre el grafo de amistades
+*/
+struct _popularity {
+    double* rank;        /**< PageRank de cada ID (suma 1 entre los usuarios existentes) */
+    int count;           /**< Cantidad de IDs con PageRank */
+    int iterations;      /**< Iteraciones del ultimo calculo */
+    time_t computedAt;   /**< Momento en que se guardo */
+    uint64_t version;    /**< Version de la red con que se guardo, para saber si la red cambio despues */
+    FriendGraph inLinks; /**< Enlaces entrantes de cada usuario (grafo transpuesto), NULL si aun no se construyen */
+    bool outdated;       /**< Indica si cambiaron las amistades desde el ultimo calculo */
+    bool modified;       /**< Indica si cambio desde que se leyo o guardo */
+};
+
+/** \struct _pageRankJob
+ * @brief Trabajo compartido por los hilos durante una iteracion de PageRank
+*/
+struct _pageRankJob {
+    FriendGraph graph;   /**< Grafo de amistades (solo lectura) */
+    FriendGraph inLinks; /**< Usuarios que tienen a cada usuario como amigo (solo lectura) */
+    double* share;       /**< PageRank de cada usuario dividido por su cantidad de amigos */
+    double* rank;        /**< PageRank de la iteracion anterior */
+    double* next;        /**< PageRank de la iteracion actual */
+    bool* active;        /**< Indica si cada ID corresponde a un usuario existente */
+    double base;         /**< Valor que recibe cada usuario por saltos aleatorios y usuarios sin amigos */
+    double* delta;       /**< Cambio total (norma L1) calculado por cada hilo */
+};
+
+// Funciones de calculo de popularidad
+Popularity create_popularity(int count);
+void delete_popularity(Popularity popularity);
+FriendGraph build_pagerank_inLinks(FriendGraph graph, int nodes);
+void pagerank_iteration_task(void* arg, int worker, int first, int last);
+int compute_pagerank(UserTable table, ThreadPool pool, FriendGraph inLinks, double* rank, int maxIterations);
+Popularity compute_popularity(UserTable table, ThreadPool pool, Popularity previous);
+void update_popularity(Popularity popularity, UserTable table);
+void refresh_popularity(UserTable table, int from, int to);
+
+// Funciones de persistencia de la popularidad
+bool save_popularity(Popularity popularity, UserTable table);
+Popularity load_popularity(UserTable table);
+Popularity get_popularity(UserTable table);
+
+// Funciones de consulta de la popularidad
+UserLinkList get_popular_users(UserPosition user, UserTable table, int k);
+void print_popular_users(UserLinkList popular, UserTable table);
+
+#endif
@@ -0,0 +1,67 @@
+/**
+ * @file prefixTrie.h
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Cabeceras para funciones de prefixTrie.c
+*/
+
+#ifndef PREFIX_TRIE_H
+#define PREFIX_TRIE_H
+
+typedef struct _prefixTrie* PrefixTrie;
+typedef struct _trieNode TrieNode;
+
+#define TRIE_COMPLETIONS 5 /**< Cantidad de nombres completos que guarda cada nodo (y que devuelve una consulta) */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <ctype.h>
+#include "errors.h"
+#include "trigram.h"
+#include "utilities.h"
+
+/** \struct _trieNode
+ * @brief Nodo de un trie de nombres, con los nombres de mayor peso que comienzan con su prefijo
+*/
+struct _trieNode {
+    char key;                             /**< Caracter del nodo (en minusculas) */
+    bool terminal;                        /**< Indica si un nombre termina en este nodo */
+    int weight;                           /**< Peso del nombre que termina en este nodo */
+    char* name;                           /**< Nombre que termina en este nodo, con sus mayusculas originales */
+    TrieNode* child;                      /**< Primer hijo (los hijos estan ordenados por key) */
+    TrieNode* sibling;                    /**< Siguiente hermano */
+    TrieNode* top[TRIE_COMPLETIONS];      /**< Nodos terminales de mayor peso del subarbol, de mayor a menor */
+    int topCount;                         /**< Cantidad de nodos en top */
+};
+
+/** \struct _prefixTrie
+ * @brief Trie de nombres que devuelve los nombres de mayor peso que comienzan con un prefijo
+ *
+ * Cada nodo guarda los TRIE_COMPLETIONS nombres de mayor peso de su subarbol, por lo que una consulta solo recorre
+ * el prefijo. Al cambiar un nombre se recalculan los nodos de su camino, desde la hoja hasta la raiz.
+*/
+struct _prefixTrie {
+    TrieNode* root; /**< Nodo raiz (prefijo vacio) */
+    int count;      /**< Cantidad de nombres */
+};
+
+// Funciones del trie de prefijos
+PrefixTrie create_prefixTrie();
+void delete_prefixTrie(PrefixTrie trie);
+void delete_trieNode(TrieNode* node);
+TrieNode* find_trieNode_child(TrieNode* node, char key, bool create);
+int walk_prefixTrie(PrefixTrie trie, const char* name, bool create, TrieNode** path);
+void refresh_trieNode_top(TrieNode* node);
+void refresh_prefixTrie_path(TrieNode** path, int length);
+void insert_prefixTrie_name(PrefixTrie trie, const char* name, int weight);
+void add_prefixTrie_weight(PrefixTrie trie, const char* name, int delta);
+void remove_prefixTrie_name(PrefixTrie trie, const char* name);
+int complete_prefixTrie(PrefixTrie trie, const char* prefix, const char** names, int* weights);
+
+// Funciones de interaccion con el usuario
+const char* ask_name_suggestion(PrefixTrie trie, TrigramIndex trigrams, const char* name);
+
+// Funciones auxiliares
+bool trieNode_ranks_before(TrieNode* a, TrieNode* b);
+
+#endif
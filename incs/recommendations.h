@@ -0,0 +1,96 @@
+/**
+ * @file recommendations.h
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Cabeceras para funciones de recommendations.c
+*/
+
+#ifndef RECOMMENDATIONS_H
+#define RECOMMENDATIONS_H
+
+#define RECS_PATH "./build/recs/"        /**< Carpeta de las recomendaciones precalculadas */
+#define RECOMMENDATIONS_SIZE 10          /**< Cantidad de recomendaciones que se guardan por usuario */
+#define RECS_MAX_AGE (24*60*60)          /**< Antiguedad maxima (en segundos) de una recomendacion precalculada */
+#define RECS_PARALLEL_MIN 256            /**< Cantidad minima de candidatos para puntuarlos en paralelo */
+
+// Pesos por defecto del coeficiente de recomendacion
+#define RECS_AGE_WEIGHT 0.15             /**< Peso de la cercania de edades */
+#define RECS_AGE_DECAY 0.09              /**< Tasa de decaimiento exponencial por año de diferencia */
+#define RECS_GENRES_WEIGHT 0.3           /**< Peso del indice de Jaccard entre generos */
+#define RECS_BANDS_WEIGHT 0.3            /**< Peso del indice de Jaccard entre bandas */
+#define RECS_MUTUAL_WEIGHT 0.1           /**< Peso de la cantidad de amigos en comun */
+#define RECS_ADAMIC_ADAR_WEIGHT 0.1      /**< Peso del indice de Adamic-Adar */
+#define RECS_RESOURCE_WEIGHT 0.05        /**< Peso del indice de asignacion de recursos */
+
+typedef struct _recsJob RecsJob;
+typedef struct _scoreJob ScoreJob;
+typedef struct _recommendationWeights RecommendationWeights;
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include "errors.h"
+#include "user.h"
+#include "userLink.h"
+#include "lsh.h"
+#include "graph.h"
+#include "threadpool.h"
+#include "heap.h"
+
+/** \struct _recommendationWeights
+ * @brief Pesos de cada componente del coeficiente de recomendacion
+*/
+struct _recommendationWeights {
+    double age;                /**< Peso de la cercania de edades */
+    double ageDecay;           /**< Tasa de decaimiento exponencial por año de diferencia */
+    double genres;             /**< Peso del indice de Jaccard entre generos */
+    double bands;              /**< Peso del indice de Jaccard entre bandas */
+    double mutual;             /**< Peso de la cantidad de amigos en comun */
+    double adamicAdar;         /**< Peso del indice de Adamic-Adar */
+    double resourceAllocation; /**< Peso del indice de asignacion de recursos */
+};
+
+/** \struct _scoreJob
+ * @brief Trabajo compartido por los hilos que puntuan candidatos
+*/
+struct _scoreJob {
+    UserPosition user;             /**< Usuario al que se le recomienda */
+    UserPosition* candidates;      /**< Candidatos en un arreglo contiguo */
+    double* coefficients;          /**< Coeficiente calculado para cada candidato */
+    FriendGraph graph;             /**< Grafo de amistades (solo lectura durante el calculo) */
+    RecommendationWeights weights; /**< Pesos del coeficiente */
+    ThreadPool pool;               /**< Pool que ejecuta el trabajo (para usar el scratch de cada hilo) */
+};
+
+/** \struct _recsJob
+ * @brief Trabajo compartido por los hilos durante el precalculo de recomendaciones
+*/
+struct _recsJob {
+    UserTable table;    /**< Tabla de usuarios (solo lectura durante el calculo en paralelo) */
+    int k;              /**< Cantidad de recomendaciones a guardar por usuario */
+    time_t computedAt;  /**< Momento del precalculo, se guarda en cada archivo */
+    int* written;       /**< Cantidad de archivos escritos por cada hilo */
+};
+
+// Funciones de calculo de recomendaciones
+RecommendationWeights default_recommendation_weights();
+double saturate_signal(double value);
+double recommendation_coefficient(UserPosition user, UserPosition candidate, FriendGraph graph, RecommendationWeights weights);
+int prepare_recommendation_candidates(UserPosition user, UserLinkList candidates, UserTable table);
+void score_recommendations_task(void* arg, int worker, int first, int last);
+void score_recommendations(UserPosition user, UserLinkList candidates, RecommendationWeights weights, UserTable table, ThreadPool pool);
+void select_top_recommendations(UserLinkList candidates, int k);
+UserLinkList compute_user_recommendations(UserPosition user, UserTable table, ThreadPool pool, int k);
+
+// Funciones de recomendaciones precalculadas
+void prepare_recommendations(UserTable table);
+void precompute_recommendations_task(void* arg, int worker, int first, int last);
+int precompute_recommendations(UserTable table, int k);
+bool save_user_recommendations(UserPosition user, UserLinkList recommendations, int k, time_t computedAt, uint64_t version);
+bool is_stale_recommendation(time_t computedAt, uint64_t version, UserTable table);
+UserLinkList load_user_recommendations(UserPosition user, UserTable table, int k);
+
+#endif
@@ -0,0 +1,49 @@
+/**
+ * @file render.h
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Cabeceras para funciones de render.c
+*/
+
+#ifndef RENDER_H
+#define RENDER_H
+
+#define RENDER_BUFFER_SIZE 4096          /**< Capacidad inicial de un buffer de pantalla */
+#define RENDER_FLUSH_LIMIT (1 << 20)     /**< Tamaño a partir del cual el buffer se escribe antes de seguir creciendo */
+#define RENDER_DATE_LENGTH 32            /**< Espacio reservado para una fecha */
+
+typedef struct _renderBuffer* RenderBuffer;
+
+#include <stdlib.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include "errors.h"
+#include "utilities.h"
+
+/** \struct _renderBuffer
+ * @brief Buffer donde se arma una pantalla completa antes de escribirla con una sola llamada a write
+*/
+struct _renderBuffer {
+    char* data;      /**< Bytes de la pantalla */
+    size_t size;     /**< Bytes usados */
+    size_t capacity; /**< Capacidad reservada */
+    int fd;          /**< Descriptor donde se escribe la pantalla */
+};
+
+// Funciones del buffer de pantalla
+RenderBuffer create_renderBuffer(int fd);
+void delete_renderBuffer(RenderBuffer buffer);
+char* reserve_renderBuffer(RenderBuffer buffer, size_t length);
+void flush_renderBuffer(RenderBuffer buffer);
+
+// Funciones de escritura en el buffer
+void render_bytes(RenderBuffer buffer, const char* bytes, size_t length);
+void render_string(RenderBuffer buffer, const char* string);
+void render_format(RenderBuffer buffer, const char* format, ...);
+void render_date(RenderBuffer buffer, time_t time);
+void render_loopweb(RenderBuffer buffer, const char* text);
+
+#endif
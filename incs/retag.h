@@ -0,0 +1,83 @@
+/**
+ * @file retag.h
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Cabeceras para funciones de retag.c
+*/
+
+#ifndef RETAG_H
+#define RETAG_H
+
+#define RETAG_CHUNK 8 /**< Cantidad de publicaciones que toma un hilo a la vez (cada una es un archivo) */
+
+typedef struct _retagPosting RetagPosting;
+typedef struct _retagPostings RetagPostings;
+typedef struct _retagJob RetagJob;
+typedef struct _retagStats RetagStats;
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include "errors.h"
+#include "comments.h"
+#include "commentLink.h"
+#include "bands.h"
+#include "genres.h"
+#include "json.h"
+#include "threadpool.h"
+
+/** \struct _retagPosting
+ * @brief Enlace pendiente de una publicacion a una banda o genero
+*/
+struct _retagPosting {
+    int position;          /**< Posicion de la publicacion en el orden cronologico */
+    CommentLinkList* list; /**< Lista de publicaciones de la banda o genero */
+};
+
+/** \struct _retagPostings
+ * @brief Enlaces encontrados por un hilo, en orden cronologico (cada hilo toma bloques crecientes)
+*/
+struct _retagPostings {
+    RetagPosting* entries; /**< Enlaces encontrados */
+    int count;             /**< Cantidad de enlaces */
+    int capacity;          /**< Capacidad reservada de entries */
+    int read;              /**< Publicaciones leidas */
+    int bandLinks;         /**< Enlaces a bandas encontrados */
+    int genreLinks;        /**< Enlaces a generos encontrados */
+    int unknown;           /**< Etiquetas que no corresponden a una banda o genero de la red */
+};
+
+/** \struct _retagJob
+ * @brief Trabajo compartido por los hilos que re-etiquetan publicaciones
+*/
+struct _retagJob {
+    const time_t* IDs;        /**< IDs de las publicaciones, de mas antigua a mas reciente */
+    BandTable bands;          /**< Tabla de bandas (solo lectura durante el calculo en paralelo) */
+    GenreTable genres;        /**< Tabla de generos (solo lectura durante el calculo en paralelo) */
+    RetagPostings* postings;  /**< Enlaces encontrados por cada hilo */
+};
+
+/** \struct _retagStats
+ * @brief Resumen de un re-etiquetado
+*/
+struct _retagStats {
+    int comments;   /**< Publicaciones guardadas */
+    int read;       /**< Publicaciones que se pudieron leer */
+    int bandLinks;  /**< Enlaces a bandas creados */
+    int genreLinks; /**< Enlaces a generos creados */
+    int unknown;    /**< Etiquetas que no corresponden a una banda o genero de la red */
+    double seconds; /**< Duracion total, incluida la escritura de los archivos */
+    int threads;    /**< Cantidad de hilos usados */
+    bool saved;     /**< Indica si ambos archivos se reemplazaron */
+};
+
+// Funciones de re-etiquetado
+RetagStats retag_comments(const char* commentsFile, BandTable bands, GenreTable genres, ThreadPool pool);
+void retag_comments_task(void* arg, int worker, int first, int last);
+bool insert_retagPostings_entry(RetagPostings* postings, int position, CommentLinkList* list);
+void merge_retagPostings(RetagJob* job, int threads, RetagStats* stats);
+
+// Funciones auxiliares
+int compare_retagPostings(const void* a, const void* b);
+
+#endif
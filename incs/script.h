@@ -0,0 +1,80 @@
+/**
+ * @file script.h
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Cabeceras para funciones de script.c
+*/
+
+#ifndef SCRIPT_H
+#define SCRIPT_H
+
+#define SCRIPT_LINE_LENGTH (MAX_COMMENT_LENGTH + 256) /**< Largo maximo de una linea de comandos */
+#define SCRIPT_FEED_SIZE 10                            /**< Publicaciones por defecto del comando feed */
+
+// Tablas que un comando toma como escritor (ver lock_scriptSession)
+#define SCRIPT_LOCK_USERS 1     /**< Tabla de usuarios */
+#define SCRIPT_LOCK_BANDS 2     /**< Tabla de bandas */
+#define SCRIPT_LOCK_GENRES 4    /**< Tabla de generos */
+#define SCRIPT_LOCK_COMMENTS 8  /**< Tabla de comentarios */
+#define SCRIPT_LOCK_ALL (SCRIPT_LOCK_USERS | SCRIPT_LOCK_BANDS | SCRIPT_LOCK_GENRES | SCRIPT_LOCK_COMMENTS)
+
+typedef struct _scriptSession* ScriptSession;
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "errors.h"
+#include "user.h"
+#include "userLink.h"
+#include "userIndex.h"
+#include "comments.h"
+#include "commentLink.h"
+#include "bands.h"
+#include "genres.h"
+#include "json.h"
+#include "recommendations.h"
+#include "popularity.h"
+#include "render.h"
+#include "utilities.h"
+
+/** \struct _scriptSession
+ * @brief Tablas de LoopWeb cargadas una sola vez para ejecutar muchos comandos seguidos
+ *
+ * Los cambios no se guardan en cada comando: los perfiles y tablas solo se marcan como modificados y las
+ * publicaciones nuevas quedan en pending hasta `save_scriptSession`.
+*/
+struct _scriptSession {
+    UserTable users;          /**< Tabla de usuarios */
+    BandTable bands;          /**< Tabla de bandas */
+    GenreTable genres;        /**< Tabla de generos */
+    CommentTable comments;    /**< Tabla de comentarios */
+    CommentLinkList pending;  /**< Publicaciones nuevas que aun no se guardan en su archivo */
+    int commands;             /**< Comandos ejecutados (se suma con __atomic) */
+    int failures;             /**< Comandos que terminaron en error (se suma con __atomic) */
+};
+
+// Funciones de la sesion
+ScriptSession create_scriptSession();
+void save_scriptSession(ScriptSession session);
+void lock_scriptSession(ScriptSession session, int writes);
+void unlock_scriptSession(ScriptSession session);
+void delete_scriptSession(ScriptSession session);
+
+// Funciones de ejecucion de comandos
+int run_script(ScriptSession session, FILE* input, RenderBuffer out);
+bool execute_script_command(ScriptSession session, char* line, int lineNumber, RenderBuffer out);
+bool script_post(ScriptSession session, char* arguments, int lineNumber, RenderBuffer out);
+bool script_befriend(ScriptSession session, char* arguments, int lineNumber, RenderBuffer out);
+bool script_feed(ScriptSession session, char* arguments, int lineNumber, RenderBuffer out);
+bool script_recs(ScriptSession session, char* arguments, int lineNumber, RenderBuffer out);
+bool script_profile(ScriptSession session, char* arguments, int lineNumber, RenderBuffer out);
+
+// Funciones auxiliares
+char* next_script_word(char** cursor);
+int read_script_count(char* word, int defaultValue);
+UserPosition find_script_user(ScriptSession session, const char* username, int lineNumber, RenderBuffer out);
+bool script_error(int lineNumber, const char* message, const char* target, RenderBuffer out);
+void lock_table(pthread_rwlock_t* lock, bool write);
+
+#endif
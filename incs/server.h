@@ -0,0 +1,183 @@
+/**
+ * @file server.h
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Cabeceras para funciones de server.c
+*/
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#define SERVER_BACKLOG 128                          /**< Conexiones en espera de ser aceptadas */
+#define SERVER_INPUT_SIZE (SCRIPT_LINE_LENGTH + 2)  /**< Bytes que se guardan de una solicitud incompleta */
+#define SERVER_SAVE_INTERVAL 60                     /**< Segundos entre cada guardado periodico de las tablas */
+#define SERVER_EVENTS 256                           /**< Eventos que se leen en cada llamada a epoll_wait */
+#define SERVER_HISTOGRAM_BUCKETS 32                 /**< Rangos del histograma de latencia (potencias de 2 en microsegundos) */
+#define SERVER_VERB_COUNT 7                         /**< Tipos de solicitud con histograma propio (el ultimo agrupa el resto) */
+#define SERVER_LOAD_CONNECTIONS 16                  /**< Conexiones simultaneas del generador de carga */
+#define SERVER_MAX_PENDING 64                       /**< Solicitudes pendientes por cliente antes de dejar de leer su socket */
+
+typedef struct _server* Server;
+typedef struct _serverClient ServerClient;
+typedef struct _serverRequest ServerRequest;
+typedef struct _latencyHistogram LatencyHistogram;
+typedef struct _loadWorker LoadWorker;
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "errors.h"
+#include "script.h"
+#include "render.h"
+#include "threadpool.h"
+#include "utilities.h"
+
+/** \struct _latencyHistogram
+ * @brief Histograma de latencias: counts[i] cuenta las que duraron entre 2^i y 2^(i+1) microsegundos
+*/
+struct _latencyHistogram {
+    long counts[SERVER_HISTOGRAM_BUCKETS]; /**< Cantidad de latencias en cada rango */
+    long total;                            /**< Cantidad total de latencias */
+    double sum;                            /**< Suma de las latencias (microsegundos) */
+    double max;                            /**< Latencia maxima (microsegundos) */
+};
+
+/** \struct _serverRequest
+ * @brief Solicitud de un cliente, desde que se recibe hasta que su respuesta pasa a la salida del cliente
+*/
+struct _serverRequest {
+    ServerClient* client;      /**< Cliente que hizo la solicitud (NULL en el guardado periodico) */
+    char* line;                /**< Linea de la solicitud (NULL si no cabia en SERVER_INPUT_SIZE) */
+    int number;                /**< Numero de la solicitud dentro de su conexion */
+    int verb;                  /**< Tipo de solicitud (indice de serverVerbs) */
+    struct timespec received;  /**< Momento en que se recibio */
+    RenderBuffer response;     /**< Respuesta (la arma un trabajador) */
+    ServerRequest* next;       /**< Siguiente solicitud de la cola en que se encuentra */
+};
+
+/** \struct _serverClient
+ * @brief Conexion de un cliente al servidor
+ *
+ * Un cliente tiene a lo mas una solicitud en un trabajador; las siguientes esperan en pending, asi sus respuestas
+ * salen en el mismo orden de las solicitudes.
+*/
+struct _serverClient {
+    int fd;                         /**< Socket del cliente (no bloqueante, -1 si ya se cerro) */
+    char input[SERVER_INPUT_SIZE];  /**< Bytes recibidos que aun no forman una linea completa */
+    size_t inputSize;               /**< Bytes usados de input */
+    RenderBuffer output;            /**< Respuestas que aun no se envian */
+    size_t sent;                    /**< Bytes de output ya enviados */
+    int requests;                   /**< Solicitudes recibidas (se usa como numero de linea en los errores) */
+    ServerRequest* pending;         /**< Solicitudes que esperan a que termine la que esta en un trabajador */
+    ServerRequest* lastPending;     /**< Ultima solicitud de pending */
+    int pendingCount;               /**< Cantidad de solicitudes en pending (a lo mas SERVER_MAX_PENDING) */
+    bool throttled;                 /**< Indica que se dejo de leer el socket por tener SERVER_MAX_PENDING pendientes */
+    bool busy;                      /**< Indica que una solicitud del cliente esta en un trabajador */
+    bool closing;                   /**< Indica que el cliente no enviara mas solicitudes */
+    ServerClient* prev;             /**< Cliente anterior en la lista de clientes conectados */
+    ServerClient* next;             /**< Cliente siguiente en la lista de clientes conectados */
+};
+
+/** \struct _server
+ * @brief Servidor de LoopWeb: tablas cargadas una vez y atendidas por un socket de dominio Unix
+ *
+ * Un solo hilo atiende los sockets con epoll (edge-triggered) y pasa cada solicitud completa a un grupo fijo de
+ * trabajadores, que ejecutan el comando y le devuelven la respuesta por done, avisando con wakeFd. Cada solicitud
+ * es una linea con un comando de script.c y cada respuesta es "<largo>\n" seguido de los <largo> bytes que el
+ * comando escribiria en modo script.
+*/
+struct _server {
+    int listenFd;                 /**< Socket de escucha */
+    int spareFd;                  /**< Descriptor de reserva que se libera para rechazar conexiones al agotar los descriptores */
+    int epollFd;                  /**< Instancia de epoll */
+    int wakeFd;                   /**< eventfd con que los trabajadores avisan que hay respuestas en done */
+    char* path;                   /**< Ruta del socket */
+    ScriptSession session;        /**< Tablas de LoopWeb (cada comando toma sus candados, ver script.c) */
+    pthread_t* workers;           /**< Hilos trabajadores */
+    int workerCount;              /**< Cantidad de trabajadores */
+    pthread_mutex_t queueLock;    /**< Protege queue, done y shutdown */
+    pthread_cond_t queueReady;    /**< Avisa a los trabajadores que hay solicitudes (o que deben terminar) */
+    ServerRequest* queue;         /**< Solicitudes que esperan un trabajador, en orden de llegada */
+    ServerRequest* lastQueued;    /**< Ultima solicitud de queue */
+    ServerRequest* done;          /**< Solicitudes terminadas que el hilo de sockets aun no recoge */
+    bool shutdown;                /**< Indica a los trabajadores que deben terminar */
+    ServerClient* clients;        /**< Lista de clientes conectados */
+    int clientCount;              /**< Cantidad de clientes conectados */
+    LatencyHistogram latency[SERVER_VERB_COUNT]; /**< Latencia de cada tipo de solicitud, desde que se recibe hasta que se responde */
+    time_t lastSave;              /**< Momento del ultimo guardado */
+    long requests;                /**< Solicitudes atendidas */
+};
+
+/** \struct _loadWorker
+ * @brief Conexion del generador de carga: envia las lineas first, first + step, ... y mide cada respuesta
+*/
+struct _loadWorker {
+    const char* path;          /**< Ruta del socket del servidor */
+    char** lines;              /**< Solicitudes (compartidas por todas las conexiones) */
+    int count;                 /**< Cantidad de solicitudes */
+    int first;                 /**< Primera solicitud de esta conexion */
+    int step;                  /**< Distancia entre las solicitudes de esta conexion */
+    LatencyHistogram latency;  /**< Latencia de las respuestas recibidas */
+    int failed;                /**< Respuestas que comienzan con "err" */
+    bool ok;                   /**< Indica si la conexion recibio todas sus respuestas */
+};
+
+extern volatile sig_atomic_t serverStop;
+extern const char* serverVerbs[SERVER_VERB_COUNT];
+
+// Funciones del servidor
+Server create_server(const char* path);
+void delete_server(Server server);
+void run_server(Server server);
+void accept_server_clients(Server server);
+bool reject_server_client(Server server);
+void close_server_client(Server server, ServerClient* client);
+void delete_serverClient(ServerClient* client);
+
+// Funciones de atencion de clientes
+bool read_server_client(Server server, ServerClient* client);
+void parse_server_client_input(ServerClient* client);
+void queue_server_request(ServerClient* client, const char* line, size_t length);
+void dispatch_server_request(Server server, ServerClient* client);
+void queue_server_save(Server server);
+void enqueue_server_request(Server server, ServerRequest* request);
+void finish_server_requests(Server server);
+bool write_server_client(ServerClient* client);
+bool is_server_client_done(ServerClient* client);
+void delete_serverRequest(ServerRequest* request);
+
+// Funciones de los trabajadores
+void* server_worker(void* arg);
+void stop_server_workers(Server server);
+
+// Funciones de latencia
+void record_latency(LatencyHistogram* histogram, double micros);
+void merge_latency(LatencyHistogram* into, const LatencyHistogram* from);
+double latency_percentile(const LatencyHistogram* histogram, double p);
+void print_latency(const char* name, const LatencyHistogram* histogram);
+
+// Funciones del cliente
+int run_client(const char* path, FILE* input);
+int run_load(const char* path, FILE* input, int connections);
+void* load_worker(void* arg);
+int connect_to_server(const char* path);
+bool write_all(int fd, const char* data, size_t length);
+char* read_response(FILE* responses, char** payload, size_t* capacity, size_t* size);
+
+// Funciones auxiliares
+void stop_server(int signum);
+bool set_nonblocking(int fd);
+int server_request_verb(const char* line);
+double elapsed_micros(const struct timespec* start);
+
+#endif
@@ -0,0 +1,39 @@
+/**
+ * @file tagScanner.h
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Cabeceras para funciones de tagScanner.c
+*/
+
+#ifndef TAG_SCANNER_H
+#define TAG_SCANNER_H
+
+#define TAG_SCANNER_BLOCK 16 /**< Bytes que se revisan a la vez con SSE2 */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Funcion que recibe cada etiqueta encontrada en un texto
+ *
+ * @param mark Caracter que inicia la etiqueta ('#' para generos, '@' para bandas)
+ * @param tag Inicio de la etiqueta dentro del texto (sin @p mark y sin terminar en '\0')
+ * @param length Largo de la etiqueta
+ * @param arg Argumento entregado a `scan_tags`
+*/
+typedef void (*TagHandler)(char mark, const char* tag, size_t length, void* arg);
+
+// Funciones de busqueda de etiquetas
+int scan_tags(const char* text, TagHandler handler, void* arg);
+size_t find_tag_mark(const char* text, size_t position, size_t length);
+size_t find_tag_mark_scalar(const char* text, size_t position, size_t length);
+size_t find_tag_end(const char* text, size_t position, size_t length);
+size_t find_tag_end_scalar(const char* text, size_t position, size_t length);
+
+// Funciones auxiliares
+bool is_tag_char(unsigned char c);
+
+#endif
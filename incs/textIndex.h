@@ -0,0 +1,83 @@
+/**
+ * @file textIndex.h
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Cabeceras para funciones de textIndex.c
+*/
+
+#ifndef TEXT_INDEX_H
+#define TEXT_INDEX_H
+
+typedef struct _textIndex* TextIndex;
+typedef struct _textTerm TextTerm;
+
+#define TEXT_INDEX_INITIAL_TERMS 1024 /**< Capacidad inicial del diccionario de palabras (potencia de 2) */
+#define TEXT_TOKEN_LENGTH 64          /**< Largo maximo de una palabra indexada (las mas largas se cortan) */
+#define TEXT_MIN_TOKEN_LENGTH 2       /**< Largo minimo de una palabra para indexarla */
+#define TEXT_MAX_QUERY_TERMS 16       /**< Cantidad maxima de palabras de una busqueda */
+#define TEXT_SEARCH_RESULTS 20        /**< Cantidad de publicaciones que se muestran por busqueda */
+#define TEXT_VARINT_MAX_BYTES 10      /**< Bytes maximos de un entero de 64 bits codificado */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include "errors.h"
+#include "hash.h"
+#include "comments.h"
+#include "commentLink.h"
+#include "json.h"
+#include "utilities.h"
+
+/** \struct _textTerm
+ * @brief Palabra del diccionario y los comentarios que la contienen
+ *
+ * Los IDs de los comentarios se guardan de menor a mayor como diferencias con el anterior, cada una codificada en
+ * bytes de 7 bits (varint). Como los IDs son instantes de publicacion, las diferencias suelen caber en 2 o 3 bytes
+ * en vez de los 8 de un time_t.
+*/
+struct _textTerm {
+    char* word;              /**< Palabra en minusculas (NULL si la entrada esta libre) */
+    unsigned char* postings; /**< IDs de los comentarios codificados */
+    int size;                /**< Bytes usados de postings */
+    int capacity;            /**< Bytes reservados de postings */
+    int count;               /**< Cantidad de comentarios con la palabra */
+    time_t lastID;           /**< Mayor ID guardado, para agregar al final sin decodificar */
+};
+
+/** \struct _textIndex
+ * @brief Indice invertido de las palabras de los textos de los comentarios
+*/
+struct _textIndex {
+    TextTerm* terms;    /**< Diccionario de palabras (tabla hash con sondeo lineal) */
+    int termCount;      /**< Cantidad de palabras distintas */
+    int capacity;       /**< Cantidad de entradas del diccionario (potencia de 2) */
+    int commentCount;   /**< Cantidad de comentarios indexados */
+    size_t postingSize; /**< Bytes totales de las listas de apariciones */
+};
+
+// Funciones del indice de texto
+TextIndex create_textIndex(int capacity);
+void delete_textIndex(TextIndex index);
+TextTerm* find_textIndex_term(TextIndex index, const char* word);
+TextTerm* insert_textIndex_term(TextIndex index, const char* word);
+void grow_textIndex(TextIndex index);
+void insert_textTerm_ID(TextIndex index, TextTerm* term, time_t ID);
+int decode_textTerm_postings(TextTerm* term, time_t* IDs);
+void encode_textTerm_postings(TextIndex index, TextTerm* term, const time_t* IDs, int count);
+void insert_textIndex_comment(TextIndex index, CommentPosition comment);
+TextIndex build_textIndex(CommentTable commentTable);
+TextIndex get_textIndex(CommentTable commentTable);
+CommentLinkList search_textIndex(TextIndex index, CommentTable commentTable, const char* query, bool matchAll, int k, int* total);
+
+// Funciones de interaccion con el usuario
+void search_comments(CommentTable commentTable);
+
+// Funciones auxiliares
+int next_text_token(const char** cursor, char* token);
+int encode_varint(unsigned char* out, uint64_t value);
+uint64_t decode_varint(const unsigned char** in);
+int compare_textIDs(const void* a, const void* b);
+
+#endif
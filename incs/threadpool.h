@@ -0,0 +1,63 @@
+/**
+ * @file threadpool.h
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Cabeceras para funciones de threadpool.c
+*/
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+typedef struct _threadPool* ThreadPool;
+typedef struct _threadPoolWorker ThreadPoolWorker;
+typedef void (*ThreadTask)(void* arg, int worker, int first, int last);
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "errors.h"
+
+/** \struct _threadPoolWorker
+ * @brief Argumento de cada hilo del pool
+*/
+struct _threadPoolWorker {
+    ThreadPool pool; /**< Pool al que pertenece el hilo */
+    int index;       /**< Indice del hilo dentro del pool (0 a threadCount-1) */
+};
+
+/** \struct _threadPool
+ * @brief Conjunto de hilos reutilizables que ejecutan ciclos "for" en paralelo
+ *
+ * Cada trabajo es un rango [0, count) que los hilos reparten en bloques de @p chunk indices. Cada hilo tiene
+ * un buffer de trabajo propio (scratch) que se conserva entre trabajos.
+*/
+struct _threadPool {
+    pthread_t* threads;      /**< Hilos del pool */
+    ThreadPoolWorker* workers; /**< Argumento de cada hilo */
+    int threadCount;         /**< Cantidad de hilos */
+    pthread_mutex_t lock;    /**< Protege el estado del trabajo actual */
+    pthread_cond_t start;    /**< Avisa a los hilos que hay un trabajo nuevo (o que deben terminar) */
+    pthread_cond_t done;     /**< Avisa al llamador que todos los hilos terminaron el trabajo */
+    ThreadTask task;         /**< Funcion del trabajo actual */
+    void* arg;               /**< Argumento del trabajo actual */
+    int count;               /**< Cantidad de indices del trabajo actual */
+    int chunk;               /**< Cantidad de indices que toma un hilo a la vez */
+    int next;                /**< Siguiente indice sin asignar */
+    int active;              /**< Hilos que aun no terminan el trabajo actual */
+    unsigned int generation; /**< Numero del trabajo actual (cambia con cada trabajo) */
+    bool shutdown;           /**< Indica a los hilos que deben terminar */
+    void** scratch;          /**< Buffer de trabajo de cada hilo */
+    size_t* scratchSize;     /**< Tamaño (en bytes) del buffer de cada hilo */
+};
+
+// Funciones del pool de hilos
+ThreadPool create_threadPool(int threads);
+void delete_threadPool(ThreadPool pool);
+void run_threadPool(ThreadPool pool, ThreadTask task, void* arg, int count, int chunk);
+void* get_threadPool_scratch(ThreadPool pool, int worker, size_t size);
+int online_cores();
+
+// Funciones auxiliares del pool de hilos
+void* threadPool_worker(void* arg);
+
+#endif
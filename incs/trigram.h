@@ -0,0 +1,75 @@
+/**
+ * @file trigram.h
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Cabeceras para funciones de trigram.c
+*/
+
+#ifndef TRIGRAM_H
+#define TRIGRAM_H
+
+typedef struct _trigramIndex* TrigramIndex;
+typedef struct _trigramPostings TrigramPostings;
+
+#define TRIGRAM_SLOT_BITS 12                       /**< Bits del hash de un trigrama */
+#define TRIGRAM_SLOTS (1 << TRIGRAM_SLOT_BITS)     /**< Cantidad de listas de apariciones del indice */
+#define TRIGRAM_MAX_LENGTH 128                     /**< Caracteres de un nombre que se consideran al extraer trigramas */
+#define TRIGRAM_MIN_SIMILARITY 0.2                 /**< Similitud minima para sugerir un nombre */
+#define TRIGRAM_SUGGESTIONS 5                      /**< Cantidad de sugerencias que se muestran */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <ctype.h>
+#include "errors.h"
+#include "heap.h"
+#include "utilities.h"
+
+/** \struct _trigramPostings
+ * @brief IDs de los nombres que contienen un trigrama (o uno con el mismo hash)
+*/
+struct _trigramPostings {
+    int* IDs;     /**< IDs de los nombres, en orden de insercion */
+    int count;    /**< Cantidad de IDs */
+    int capacity; /**< Capacidad reservada del arreglo */
+};
+
+/** \struct _trigramIndex
+ * @brief Indice invertido de trigramas para encontrar nombres parecidos a uno mal escrito
+ *
+ * Cada nombre se pasa a minusculas, se rellena con dos espacios al inicio y uno al final, y se descompone en sus
+ * trigramas distintos. Una consulta solo recorre las listas de sus propios trigramas contando cuantos comparte con
+ * cada nombre, y la similitud es el indice de Jaccard entre ambos conjuntos de trigramas. Las colisiones del hash
+ * solo agregan candidatos, que la similitud deja fuera.
+*/
+struct _trigramIndex {
+    TrigramPostings slots[TRIGRAM_SLOTS]; /**< Lista de apariciones de cada hash de trigrama */
+    char** names;                         /**< Nombre de cada ID (NULL si no existe o fue quitado) */
+    int* trigramCounts;                   /**< Cantidad de trigramas distintos de cada nombre */
+    int* hits;                            /**< Trigramas compartidos con la consulta actual */
+    unsigned int* marks;                  /**< Consulta en la que se conto cada ID por ultima vez */
+    int* touched;                         /**< IDs alcanzados por la consulta actual */
+    unsigned int generation;              /**< Numero de la consulta actual */
+    int count;                            /**< Cantidad de IDs del indice (el mayor ID mas uno) */
+    int capacity;                         /**< Capacidad reservada de los arreglos por ID */
+};
+
+// Funciones del indice de trigramas
+TrigramIndex create_trigramIndex(int capacity);
+void delete_trigramIndex(TrigramIndex index);
+void ensure_trigramIndex_capacity(TrigramIndex index, int ID);
+int extract_trigrams(const char* name, unsigned int* trigrams);
+void insert_trigramIndex_name(TrigramIndex index, int ID, const char* name);
+void remove_trigramIndex_name(TrigramIndex index, int ID);
+int find_trigramIndex_name(TrigramIndex index, const char* name);
+const char* get_trigramIndex_name(TrigramIndex index, int ID);
+int search_trigramIndex(TrigramIndex index, const char* query, int k, int* IDs, double* scores);
+
+// Funciones de interaccion con el usuario
+int ask_trigramIndex_suggestion(TrigramIndex index, const char* name);
+
+// Funciones auxiliares
+unsigned int hash_trigram(unsigned char a, unsigned char b, unsigned char c);
+int compare_trigrams(const void* a, const void* b);
+
+#endif
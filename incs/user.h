@@ -14,12 +14,34 @@ typedef PtrToUser UserPosition;
 typedef PtrToUser UserList;
 typedef struct _userTable* UserTable;
 
-#define USER_TABLE_SIZE 20 /**< Tamaño de la tabla hash de usuarios */
+#define USER_TABLE_SIZE 20 /**< Tamaño inicial de la tabla hash de usuarios */
+#define USER_TABLE_LOAD 4  /**< Usuarios por bucket sobre los que se duplica la tabla hash de usuarios */
+#define USER_MIN_AGE 18    /**< Edad minima para registrarse */
+#define USER_MAX_AGE 99    /**< Edad maxima para registrarse (y maxima que se acepta al leer los archivos) */
+
+// Parametros del feed por relevancia
+#define FEED_RANK_SIZE 10         /**< Cantidad de publicaciones por defecto en el feed por relevancia */
+#define FEED_GRAVITY 1.5          /**< Exponente de decaimiento temporal de las publicaciones */
+#define FEED_TAGS_WEIGHT 0.5      /**< Peso de cada banda o genero del usuario presente en la publicacion */
+#define FEED_FRIEND_WEIGHT 1.0    /**< Peso de que el autor de la publicacion sea amigo del usuario */
+#define FEED_AFFINITY_WEIGHT 1.0  /**< Peso de la afinidad (Jaccard) entre el usuario y el autor */
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 #include "errors.h"
 #include "hash.h"
+#include "heap.h"
+#include "graph.h"
+#include "intern.h"
+#include "lsh.h"
+#include "pagerank.h"
+#include "popularity.h"
+#include "userIndex.h"
+#include "userFilter.h"
+#include "trigram.h"
+#include "recommendations.h"
+#include "threadpool.h"
+#include "bitmap.h"
 #include "bandLink.h"
 #include "commentLink.h"
 #include "genreLink.h"
@@ -32,6 +54,7 @@ typedef struct _userTable* UserTable;
 */
 struct _userNode {
     char* username;               /**< Nombre del usuario */
+    int ID;                       /**< Identificador denso del usuario dentro de su tabla (-1 si no pertenece a una) */
     int age;                      /**< Edad del usuario */
     char* nationality;            /**< Nacionalidad del usuario */
     char* description;            /**< Descripcion del usuario */
@@ -39,6 +62,10 @@ struct _userNode {
     BandLinkList bands;           /**< Bandas que le gustan al usuario */
     UserLinkList friends;         /**< Lista de enlaces a usuarios que son amigos de este usuario */
     CommentLinkList comments;     /**< Lista de comentarios hechos por el usuario */
+    Bitmap genreSet;              /**< Generos del usuario como IDs internados (NULL hasta que se necesite) */
+    Bitmap bandSet;               /**< Bandas del usuario como IDs internados (NULL hasta que se necesite) */
+    bool modified;                /**< Indica si el perfil cambio desde que se guardo en su archivo */
+    bool hydrated;                /**< Indica si el perfil ya se completo desde su archivo (se consulta con __atomic, ver complete_user_from_json) */
     PtrToUser next;               /**< Puntero al siguiente nodo de la lista enlazada */
 };
 
@@ -46,9 +73,26 @@ struct _userNode {
  * @brief Estructura que representa la tabla hash de usuarios.
 */
 struct _userTable {
-    UserList buckets[USER_TABLE_SIZE];   /**< Arreglo de punteros a listas enlazadas de usuarios */
+    UserList* buckets;                   /**< Arreglo de punteros a listas enlazadas de usuarios */
+    int bucketCount;                     /**< Cantidad de buckets (crece con los usuarios, ver USER_TABLE_LOAD) */
     int userCount;                       /**< Contador de usuarios */
+    PtrToUser* usersByID;                /**< Usuarios indexados por su ID denso (NULL si el usuario fue borrado) */
+    int idCount;                         /**< Cantidad de IDs asignados */
+    int idCapacity;                      /**< Capacidad reservada de usersByID */
+    FriendGraph graph;                   /**< Grafo de amistades sobre los IDs (se construye al necesitarse) */
+    InternTable genreNames;              /**< IDs densos de los generos presentes en los perfiles */
+    InternTable bandNames;               /**< IDs densos de las bandas presentes en los perfiles */
+    TasteIndex tasteIndex;               /**< Indice LSH de gustos (se construye al necesitarse) */
+    TasteGraph tasteGraph;               /**< Grafo usuario-gusto para los recorridos aleatorios (se construye al necesitarse) */
+    UserIndex nameIndex;                 /**< Usuarios ordenados por nombre (se construye al necesitarse) */
+    TrigramIndex nameTrigrams;           /**< Trigramas de los nombres de usuario por ID (se construye al necesitarse) */
+    AgeIndex ageIndex;                   /**< Usuarios ordenados por edad (se construye al necesitarse) */
+    NationalityIndex nationalityIndex;   /**< Usuarios de cada nacionalidad (se construye al necesitarse) */
+    Popularity popularity;               /**< PageRank de los usuarios (se lee o calcula al necesitarse) */
+    ThreadPool pool;                     /**< Hilos para calculos en paralelo sobre la tabla (se crean al necesitarse) */
+    uint64_t version;                    /**< Version de la red: suma de las huellas de sus usuarios y amistades (ver `user_version_hash`) */
     bool modified;                       /**< Indica si la tabla ha sido modificada desde que se cargo */
+    pthread_rwlock_t lock;               /**< Candado de lectores y escritores para usar la tabla desde varios hilos (ver script.c) */
 };
 
 // Funciones para un nodo de usuario
@@ -56,6 +100,14 @@ void save_userNode(PtrToUser user);
 void print_user(UserPosition user);
 CommentLinkList get_user_feed(UserPosition user, BandTable bandTable, GenreTable genreTable, CommentTable commentTable);
 void print_user_feed(UserPosition user, BandTable bandTable, GenreTable genreTable, CommentTable commentTable);
+double feed_time_decay(time_t commentTime, time_t now);
+void stamp_feed_candidates(CommentLinkList postings, CommentTable commentTable, unsigned int generation);
+void offer_feed_candidate(ScoreHeap heap, UserPosition user, CommentPosition comment, int matches, UserTable userTable, time_t now);
+CommentLinkList get_user_ranked_feed(UserPosition user, UserTable userTable, BandTable bandTable, GenreTable genreTable, CommentTable commentTable, int k);
+void print_user_ranked_feed(UserPosition user, UserTable userTable, BandTable bandTable, GenreTable genreTable, CommentTable commentTable, int k);
+UserPosition complete_user_tasteSets(UserPosition user, UserTable table);
+double genres_jacardIndex(UserPosition user1, UserPosition user2, UserTable table);
+double bands_jacardIndex(UserPosition user1, UserPosition user2, UserTable table);
 
 // Funciones de la lista de usuarios
 UserList create_empty_UserList(UserList userList);
@@ -80,14 +132,29 @@ UserTable create_userTable(UserTable table);
 void delete_userTable(UserTable table);
 UserPosition insert_userTable_node(UserTable table, const char *username, int age, const char *nationality, const char *description, GenreLinkList genres, BandLinkList bands, UserLinkList friends, CommentLinkList comments);
 UserPosition find_userTable_node(UserTable table, const char *username);
+unsigned int userTable_bucket(UserTable table, const char *username);
+void resize_userTable(UserTable table, int bucketCount);
+UserPosition find_userTable_node_byID(UserTable table, int ID);
 void delete_userTable_node(UserTable table, const char* username);
 void print_userTable(UserTable table);
+ThreadPool get_userTable_threadPool(UserTable table);
 void save_userTable(UserTable userTable);
+int save_modified_users(UserTable table);
+
+// Funciones de la version de la red
+uint64_t user_version_hash(const char* username);
+uint64_t friendship_version_hash(const char* user, const char* other);
+void add_userTable_friendships_version(UserTable table);
 
 // Funciones de loopweb relacionadas a usuarios
 void make_comment(char* userName, UserTable users, BandTable band, GenreTable genre, CommentTable comments);
+CommentPosition post_comment(UserPosition author, const char* text, BandTable bandTable, GenreTable genreTable, CommentTable comments, bool save);
+void link_comment_band(CommentPosition comment, BandPosition band, BandTable bandTable);
+void link_comment_genre(CommentPosition comment, GenrePosition genre, GenreTable genreTable);
+void publish_comment(CommentPosition comment, UserPosition author, BandTable bandTable, GenreTable genreTable, CommentTable comments, bool save);
 UserLinkList get_loopweb_users(UserTable table, bool print);
 void request_for_friendship(UserPosition user, UserLinkList possibleFriends, UserTable table);
+bool make_friendship(UserPosition user, UserPosition other, UserTable table, bool save);
 UserPosition create_user_profile(UserTable users, BandTable bands, GenreTable genres);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,74 @@
+/**
+ * @file userFilter.h
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Cabeceras para funciones de userFilter.c
+*/
+
+#ifndef USER_FILTER_H
+#define USER_FILTER_H
+
+typedef struct _ageIndex* AgeIndex;
+typedef struct _nationalityIndex* NationalityIndex;
+
+#define FILTER_ANY "*" /**< Valor que acepta cualquier nacionalidad o genero al filtrar */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "errors.h"
+#include "bitmap.h"
+#include "intern.h"
+#include "user.h"
+#include "userLink.h"
+#include "utilities.h"
+
+/** \struct _ageIndex
+ * @brief Usuarios ordenados por edad (y por ID a igual edad) en un arreglo contiguo
+ *
+ * Los usuarios de un rango de edades quedan en un rango contiguo del arreglo, que se encuentra con dos busquedas
+ * binarias.
+*/
+struct _ageIndex {
+    PtrToUser* users; /**< Usuarios ordenados por edad */
+    int count;        /**< Cantidad de usuarios en el indice */
+    int capacity;     /**< Capacidad reservada del arreglo */
+};
+
+/** \struct _nationalityIndex
+ * @brief IDs de los usuarios de cada nacionalidad como bitmaps
+*/
+struct _nationalityIndex {
+    InternTable names; /**< IDs densos de las nacionalidades */
+    Bitmap* users;     /**< Usuarios de cada nacionalidad, indexados por el ID de la nacionalidad */
+    int capacity;      /**< Capacidad reservada de users */
+};
+
+// Funciones del indice de edades
+void complete_filter_fields(UserTable table);
+AgeIndex create_ageIndex(int capacity);
+void delete_ageIndex(AgeIndex index);
+AgeIndex build_ageIndex(UserTable table);
+AgeIndex get_ageIndex(UserTable table);
+int find_ageIndex_position(AgeIndex index, int age, int ID);
+void insert_ageIndex_user(AgeIndex index, PtrToUser user);
+void remove_ageIndex_user(AgeIndex index, PtrToUser user);
+int find_ageIndex_range(AgeIndex index, int minAge, int maxAge, int* first);
+
+// Funciones del indice de nacionalidades
+NationalityIndex create_nationalityIndex();
+void delete_nationalityIndex(NationalityIndex index);
+NationalityIndex build_nationalityIndex(UserTable table);
+NationalityIndex get_nationalityIndex(UserTable table);
+void insert_nationalityIndex_user(NationalityIndex index, PtrToUser user);
+void remove_nationalityIndex_user(NationalityIndex index, PtrToUser user);
+Bitmap find_nationalityIndex_users(NationalityIndex index, const char* nationality);
+
+// Funciones de filtrado
+bool user_has_genre(PtrToUser user, int genreID, const char* genre);
+UserLinkList filter_users(UserTable table, int minAge, int maxAge, const char* nationality, const char* genre);
+
+// Funciones de interaccion con el usuario
+void print_filtered_users(UserLinkList users, UserTable table);
+void filter_users_menu(UserTable table);
+
+#endif
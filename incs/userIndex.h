@@ -0,0 +1,53 @@
+/**
+ * @file userIndex.h
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Cabeceras para funciones de userIndex.c
+*/
+
+#ifndef USER_INDEX_H
+#define USER_INDEX_H
+
+typedef struct _userIndex* UserIndex;
+
+#define USER_PAGE_SIZE 15 /**< Cantidad de usuarios por pagina al listar */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "errors.h"
+#include "trigram.h"
+#include "user.h"
+#include "utilities.h"
+
+/** \struct _userIndex
+ * @brief Usuarios ordenados alfabeticamente por nombre en un arreglo contiguo
+ *
+ * Una busqueda por prefijo son dos busquedas binarias, y todos los usuarios con el prefijo quedan en un rango
+ * contiguo del arreglo, por lo que cualquier pagina se obtiene en O(log n + pagina).
+*/
+struct _userIndex {
+    PtrToUser* users; /**< Usuarios ordenados por nombre */
+    int count;        /**< Cantidad de usuarios en el indice */
+    int capacity;     /**< Capacidad reservada del arreglo */
+};
+
+// Funciones del indice de nombres de usuario
+UserIndex create_userIndex(int capacity);
+void delete_userIndex(UserIndex index);
+UserIndex build_userIndex(UserTable table);
+UserIndex get_userIndex(UserTable table);
+int find_userIndex_position(UserIndex index, const char* username);
+void insert_userIndex_user(UserIndex index, PtrToUser user);
+void remove_userIndex_user(UserIndex index, PtrToUser user);
+int find_userIndex_prefix(UserIndex index, const char* prefix, int* first);
+TrigramIndex get_user_trigrams(UserTable table);
+
+// Funciones de interaccion con el usuario
+void print_userIndex_page(UserIndex index, int first, int count, int page);
+void browse_users(UserTable table);
+UserPosition suggest_user(UserTable table, const char* username);
+
+// Funciones auxiliares
+int compare_users_byName(const void* a, const void* b);
+
+#endif
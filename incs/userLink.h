@@ -12,6 +12,8 @@ typedef UserLinkNode *PtrToUserLinkNode;
 typedef PtrToUserLinkNode UserLinkPosition;
 typedef PtrToUserLinkNode UserLinkList;
 
+#define FRIENDS_SEARCH_DEPTH 3 /**< Distancia maxima (en amistades) a la que se buscan recomendaciones */
+
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
@@ -56,7 +58,8 @@ UserLinkPosition userLinkList_last(UserLinkList linkList);
 UserLinkPosition userLinkList_advance(UserLinkPosition P);
 
 // Otras funciones
-UserLinkPosition find_possible_friends(UserPosition user, UserTable table);
-void print_user_recommendations(UserPosition user, UserLinkList recommendations);
+UserLinkPosition find_possible_friends(UserPosition user, UserTable table, int maxDepth);
+void print_user_recommendations(UserPosition user, UserLinkList recommendations, UserTable table);
+void print_friendship_path(UserPosition user, UserPosition target, UserLinkList path);
 
 #endif
\ No newline at end of file
@@ -14,6 +14,7 @@
 #include <ctype.h>
 #include <time.h>
 #include "errors.h"
+#include "render.h"
 
 
 // Colores para texto
@@ -33,6 +34,7 @@
 void to_low_case(char* s1);
 void remove_punctuation(char* s1);
 char* get_only_fileName(char* file);
+void replace_string(char** str, const char* value);
 bool is_valid_extension(char* extension);
 void print_loopweb(char* str);
 
@@ -40,9 +42,6 @@ void print_loopweb(char* str);
 bool increasing(double a, double b);
 bool decreasing(double a, double b);
 
-// Tiempo
-void print_date(time_t time);
-
 // Otras funciones
 void print_loopweb_help();
 
@@ -134,6 +134,31 @@ BandLinkPosition insert_bandLinkList_node_basicInfo(BandLinkPosition prevPositio
     return newNode;
 }
 
+/**
+ * @brief Crea el nodo correspondiente a un enlace a una banda a partir de un fragmento de texto (sin apuntar a un nodo)
+ *
+ * @param prevPosition Puntero al nodo anterior al que se desea insertar
+ * @param band Inicio del nombre (no necesita terminar en '\0')
+ * @param length Largo del nombre
+ * @return Puntero al nodo creado
+ * @note Copia el nombre una sola vez, sin reservar un string temporal
+*/
+BandLinkPosition insert_bandLinkList_node_text(BandLinkPosition prevPosition, const char* band, size_t length){
+    BandLinkPosition newNode = (BandLinkPosition) malloc(sizeof(struct _bandLinkNode));
+    if (newNode == NULL) {
+        print_error(200, NULL, NULL);
+    }
+    newNode->band = malloc(length + 1);
+    if(newNode->band == NULL){
+        print_error(200, NULL, NULL);
+    }
+    memcpy(newNode->band, band, length);
+    newNode->band[length] = '\0';
+    newNode->next = prevPosition->next;
+    prevPosition->next = newNode;
+    return newNode;
+}
+
 /**
  * @brief Crea el nodo correspondiente a un enlace a una banda (apuntando a un nodo de banda)
  *
@@ -435,21 +460,41 @@ BandLinkList intersection_bandLinkList(BandLinkList list1, BandLinkList list2, i
 * @param list1 Primera lista de enlaces a bandas.
  * @param list2 Segunda lista de enlaces a bandas.
  * @return El índice de Jaccard de las dos listas de enlaces a bandas.
+ * @note No reserva memoria. Para comparar gustos entre usuarios se usan los bitmaps de `bands_jacardIndex`
 */
 double jacardIndex_bandLinkList(BandLinkList list1, BandLinkList list2)
 {
-    int unionSize = 0, intersectionSize = 0;
+    int size1 = 0, size2 = 0, intersectionSize = 0;
     double jacardIndex = 0;
-    BandLinkList unionList = union_bandLinkList(list1, list2, &unionSize);
-    BandLinkList intersectionList = intersection_bandLinkList(list1, list2, &intersectionSize);
+
+    // Contamos sin construir listas auxiliares: un elemento solo cuenta en su primera aparicion
+    BandLinkPosition current = bandLinkList_first(list1);
+    while (current != NULL) {
+        if (find_bandLinkList_node(list1, current->band) == current) {
+            size1++;
+            if (find_bandLinkList_node(list2, current->band) != NULL) {
+                intersectionSize++;
+            }
+        }
+        current = bandLinkList_advance(current);
+    }
+    current = bandLinkList_first(list2);
+    while (current != NULL) {
+        if (find_bandLinkList_node(list2, current->band) == current) {
+            size2++;
+        }
+        current = bandLinkList_advance(current);
+    }
+
+    int unionSize = size1 + size2 - intersectionSize;
     if(unionSize == 0 || intersectionSize == 0){
         jacardIndex = 0;
     }
-    jacardIndex = (double)intersectionSize / (double)unionSize;
+    else{
+        jacardIndex = (double)intersectionSize / (double)unionSize;
+    }
     #ifdef DEBUG
         printf("BANDS: unionSize: %d, intersectionSize: %d; jacardIndex: %lf\n", unionSize, intersectionSize, jacardIndex);
     #endif
-    delete_bandLinkList(unionList);
-    delete_bandLinkList(intersectionList);
     return jacardIndex;
 }
\ No newline at end of file
@@ -222,7 +222,10 @@ BandTable create_bandTable(BandTable bandTable)
         bandTable->bandCount = 0;
     }
 
+    bandTable->trigrams = NULL;
+    bandTable->completions = NULL;
     bandTable->modified = false;
+    init_table_lock(&bandTable->lock);
 
     return bandTable;
 }
@@ -255,6 +258,12 @@ BandPosition insert_bandTable_band(char* band, BandTable bandTable)
     BandPosition position = insert_bandList_band(bandTable->buckets[index], band);
     if (position != NULL) {
         bandTable->bandCount++;
+        if(bandTable->trigrams){
+            insert_trigramIndex_name(bandTable->trigrams, bandTable->trigrams->count, band);
+        }
+        if(bandTable->completions){
+            insert_prefixTrie_name(bandTable->completions, band, 0);
+        }
     }
     bandTable->modified = true;
     return position;
@@ -273,6 +282,12 @@ void delete_bandTable_band(char* band, BandTable bandTable)
         print_error(301, NULL, NULL);
         return;
     }
+    if(bandTable->trigrams){
+        remove_trigramIndex_name(bandTable->trigrams, find_trigramIndex_name(bandTable->trigrams, band));
+    }
+    if(bandTable->completions){
+        remove_prefixTrie_name(bandTable->completions, band);
+    }
     delete_bandList_band(position, bandTable->buckets[index]);
     bandTable->modified = true;
     bandTable->bandCount--;
@@ -287,6 +302,9 @@ void delete_bandTable(BandTable bandTable)
     for (int i = 0; i < BANDS_TABLE_SIZE; i++) {
         delete_bandList(bandTable->buckets[i]);
     }
+    delete_trigramIndex(bandTable->trigrams);
+    delete_prefixTrie(bandTable->completions);
+    pthread_rwlock_destroy(&bandTable->lock);
     free(bandTable);
 }
 
@@ -306,15 +324,19 @@ BandPosition find_bandTable_band(char* band, BandTable bandTable)
 /**
  * @brief Funcion para guardar una tabla de bandas en su archivo JSON correspondiente
  *
+ * La tabla se escribe en un archivo temporal que luego reemplaza al original con rename, asi el archivo queda con
+ * la version anterior o la nueva completa aunque el programa termine a mitad de la escritura.
+ *
  * @param bandTable Tabla de bandas a guardar
+ * @return TRUE si el archivo se reemplazo, FALSE si no se pudo escribir
 */
-void save_bandTable(BandTable bandTable)
+bool save_bandTable(BandTable bandTable)
 {
-    FILE* bandTableFile = fopen("./build/bands.json", "w");
+    FILE* bandTableFile = fopen(BANDS_FILE".tmp", "w");
     if (bandTableFile == NULL)
     {
-        print_error(100, "./build/bands.json", NULL);
-        return;
+        print_error(100, BANDS_FILE".tmp", NULL);
+        return false;
     }
 
     bool first = true;
@@ -351,7 +373,13 @@ void save_bandTable(BandTable bandTable)
         }
     }
     fprintf(bandTableFile, "\n]");
-    fclose(bandTableFile);
+    bool written = !ferror(bandTableFile);
+    if(fclose(bandTableFile) != 0 || !written || rename(BANDS_FILE".tmp", BANDS_FILE) != 0){
+        print_error(100, BANDS_FILE, NULL);
+        remove(BANDS_FILE".tmp");
+        return false;
+    }
+    return true;
 }
 
 // Funciones de LoopWeb relacionadas a bandas
@@ -386,4 +414,46 @@ BandLinkList get_loopweb_bands(BandTable table)
     }
     printf("\n\n");
     return allBands;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Obtiene el indice de trigramas de los nombres de las bandas, construyendolo si aun no existe
+ *
+ * @param bandTable Tabla de bandas
+ * @return Indice de trigramas de la tabla
+*/
+TrigramIndex get_bandTable_trigrams(BandTable bandTable)
+{
+    if(bandTable->trigrams == NULL){
+        bandTable->trigrams = create_trigramIndex(bandTable->bandCount);
+        for(int i=0; i<BANDS_TABLE_SIZE; i++){
+            for(BandPosition aux = bandTable->buckets[i]->next; aux != NULL; aux = aux->next){
+                insert_trigramIndex_name(bandTable->trigrams, bandTable->trigrams->count, aux->band);
+            }
+        }
+    }
+    return bandTable->trigrams;
+}
+
+/**
+ * @brief Obtiene el trie de los nombres de las bandas, pesados por su cantidad de publicaciones, construyendolo si aun no existe
+ *
+ * @param bandTable Tabla de bandas
+ * @return Trie de la tabla
+*/
+PrefixTrie get_bandTable_completions(BandTable bandTable)
+{
+    if(bandTable->completions == NULL){
+        bandTable->completions = create_prefixTrie();
+        for(int i=0; i<BANDS_TABLE_SIZE; i++){
+            for(BandPosition aux = bandTable->buckets[i]->next; aux != NULL; aux = aux->next){
+                int publications = 0;
+                for(CommentLinkPosition comment = aux->comments->next; comment != NULL; comment = comment->next){
+                    publications++;
+                }
+                insert_prefixTrie_name(bandTable->completions, aux->band, publications);
+            }
+        }
+    }
+    return bandTable->completions;
+}
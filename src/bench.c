@@ -0,0 +1,690 @@
+/**
+ * @file bench.c
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Mediciones de rendimiento de LoopWeb sobre datos sinteticos en memoria
+ *
+ * Los datos se generan con una semilla fija y no se leen ni escriben datos de ./build (solo se reservan
+ * identificadores de proceso para los IDs, ver `init_comment_worker`), por lo que las mediciones se pueden repetir y
+ * comparar entre versiones con `make bench`.
+*/
+#include "bench.h"
+
+// Funciones de medicion
+
+/**
+ * @brief Mide cuanto acelera el pool de hilos la puntuacion de candidatos a amigos
+ *
+ * Se puntua a todos los usuarios de la red sintetica como candidatos de uno solo, primero en el hilo actual y
+ * luego con pools de 2, 4, ... hilos (hasta la cantidad de nucleos, y al menos 4).
+*/
+void bench_recommendations()
+{
+    UserTable table = create_bench_users(BENCH_USERS);
+    UserPosition user = table->usersByID[0];
+    UserLinkList candidates = create_empty_userLinkList(NULL);
+    for(int ID=1; ID<table->idCount; ID++){
+        insert_userLinkList_node_completeInfo(candidates, table->usersByID[ID]);
+    }
+    RecommendationWeights weights = default_recommendation_weights();
+    score_recommendations(user, candidates, weights, table, NULL); // Construye los conjuntos de gustos y el grafo
+
+    printf("Puntuacion de %d candidatos (%d repeticiones, %d nucleos)\n", table->idCount - 1, BENCH_ROUNDS, online_cores());
+    double start = bench_seconds();
+    for(int i=0; i<BENCH_ROUNDS; i++){
+        score_recommendations(user, candidates, weights, table, NULL);
+    }
+    double serial = (bench_seconds() - start) / BENCH_ROUNDS;
+    printf("\t%-12s %10.3f ms\n", "sin pool", serial * 1000);
+
+    int maxThreads = online_cores() > 4 ? online_cores() : 4;
+    for(int threads = 2; threads <= maxThreads; threads *= 2){
+        ThreadPool pool = create_threadPool(threads);
+        start = bench_seconds();
+        for(int i=0; i<BENCH_ROUNDS; i++){
+            score_recommendations(user, candidates, weights, table, pool);
+        }
+        double parallel = (bench_seconds() - start) / BENCH_ROUNDS;
+        delete_threadPool(pool);
+        printf("\t%2d %-9s %10.3f ms   x%.2f\n", threads, "hilos", parallel * 1000, serial / parallel);
+    }
+
+    delete_userLinkList(candidates);
+    delete_userTable(table);
+}
+
+/**
+ * @brief Compara la busqueda de etiquetas con SSE2 (`scan_tags`) contra la misma busqueda de a un byte
+ *
+ * Ambas recorren las mismas BENCH_COMMENTS publicaciones y deben encontrar las mismas etiquetas.
+*/
+void bench_tags()
+{
+    unsigned int state = BENCH_SEED;
+    char** texts = create_bench_texts(BENCH_COMMENTS, &state);
+    size_t bytes = 0;
+    for(int i=0; i<BENCH_COMMENTS; i++){
+        bytes += strlen(texts[i]);
+    }
+
+    size_t scalarTags = 0, blockTags = 0;
+    double start = bench_seconds();
+    for(int r=0; r<BENCH_ROUNDS; r++){
+        for(int i=0; i<BENCH_COMMENTS; i++){
+            scan_tags_scalar(texts[i], count_bench_tag, &scalarTags);
+        }
+    }
+    double scalar = (bench_seconds() - start) / BENCH_ROUNDS;
+
+    start = bench_seconds();
+    for(int r=0; r<BENCH_ROUNDS; r++){
+        for(int i=0; i<BENCH_COMMENTS; i++){
+            scan_tags(texts[i], count_bench_tag, &blockTags);
+        }
+    }
+    double block = (bench_seconds() - start) / BENCH_ROUNDS;
+
+    printf("Busqueda de etiquetas en %d publicaciones (%.1f KB, %zu etiquetas)\n", BENCH_COMMENTS, bytes / 1024.0, blockTags / BENCH_ROUNDS);
+    printf("\t%-12s %10.3f ms %10.1f MB/s\n", "de a byte", scalar * 1000, bytes / scalar / 1e6);
+#ifdef __SSE2__
+    printf("\t%-12s %10.3f ms %10.1f MB/s   x%.2f\n", "SSE2", block * 1000, bytes / block / 1e6, scalar / block);
+#else
+    printf("\t%-12s %10.3f ms %10.1f MB/s   x%.2f (sin SSE2)\n", "scan_tags", block * 1000, bytes / block / 1e6, scalar / block);
+#endif
+    if(scalarTags != blockTags){
+        printf("\t"ANSI_COLOR_RED"Las busquedas encontraron distintas etiquetas (%zu y %zu)"ANSI_COLOR_RESET"\n", scalarTags, blockTags);
+    }
+    delete_bench_texts(texts, BENCH_COMMENTS);
+}
+
+/**
+ * @brief Mide cuanto demora mostrar un feed de BENCH_COMMENTS publicaciones
+ *
+ * Se compara la impresion anterior (printf y putchar por cada caracter sobre un FILE con buffer de linea, como
+ * stdout en una terminal) contra el buffer de pantalla de render.c, que escribe todo el feed con una sola llamada a
+ * write. Ambas escriben en /dev/null, asi se mide el armado de la pantalla y no la terminal.
+*/
+void bench_feed_render()
+{
+    unsigned int state = BENCH_SEED;
+    CommentPosition* comments = create_bench_comments(BENCH_COMMENTS, &state);
+    int fd = open("/dev/null", O_WRONLY);
+    FILE* out = fdopen(dup(fd), "w");
+    if(fd < 0 || out == NULL){
+        print_error(100, "/dev/null", NULL);
+        return;
+    }
+    setvbuf(out, NULL, _IOLBF, 0);
+
+    double start = bench_seconds();
+    for(int r=0; r<BENCH_ROUNDS; r++){
+        for(int i=0; i<BENCH_COMMENTS; i++){
+            print_commentNode_stdio(out, comments[i]);
+        }
+        fflush(out);
+    }
+    double stdio = (bench_seconds() - start) / BENCH_ROUNDS;
+
+    RenderBuffer measure = create_renderBuffer(-1); // Solo para saber el tamaño de la pantalla
+    for(int i=0; i<BENCH_COMMENTS; i++){
+        render_commentNode(measure, comments[i]);
+    }
+    size_t bytes = measure->size;
+    delete_renderBuffer(measure);
+
+    start = bench_seconds();
+    for(int r=0; r<BENCH_ROUNDS; r++){
+        RenderBuffer screen = create_renderBuffer(fd);
+        for(int i=0; i<BENCH_COMMENTS; i++){
+            render_commentNode(screen, comments[i]);
+        }
+        delete_renderBuffer(screen);
+    }
+    double render = (bench_seconds() - start) / BENCH_ROUNDS;
+
+    printf("Feed de %d publicaciones (%.1f KB por pantalla)\n", BENCH_COMMENTS, bytes / 1024.0);
+    printf("\t%-12s %10.3f ms\n", "printf", stdio * 1000);
+    printf("\t%-12s %10.3f ms   x%.2f\n", "render", render * 1000, stdio / render);
+
+    fclose(out);
+    close(fd);
+    for(int i=0; i<BENCH_COMMENTS; i++){
+        delete_commentNode(comments[i]);
+    }
+    free(comments);
+}
+
+/**
+ * @brief Prueba de estres de los IDs de publicaciones: varios procesos con varios hilos generan IDs a la vez
+ *
+ * Cada proceso debe sostener BENCH_ID_RATE publicaciones por segundo y ningun ID puede repetirse, ni dentro de un
+ * proceso ni entre procesos.
+ *
+ * @warning Debe llamarse antes de generar cualquier ID en este proceso: los procesos hijos heredan el identificador
+ * de proceso ya elegido (ver `init_comment_worker`)
+*/
+void bench_comment_IDs()
+{
+    FILE* inputs[BENCH_ID_PROCESSES];
+    pid_t children[BENCH_ID_PROCESSES];
+    for(int p=0; p<BENCH_ID_PROCESSES; p++){
+        int fds[2];
+        if(pipe(fds) < 0 || (children[p] = fork()) < 0){
+            print_error(204, NULL, NULL);
+        }
+        if(children[p] == 0){
+            close(fds[0]);
+            run_bench_ID_process(fdopen(fds[1], "w"));
+            _exit(0);
+        }
+        close(fds[1]);
+        inputs[p] = fdopen(fds[0], "r");
+    }
+
+    int total = BENCH_IDS * BENCH_ID_PROCESSES;
+    time_t* IDs = (time_t*)malloc(sizeof(time_t) * total);
+    if(IDs == NULL){
+        print_error(200, NULL, NULL);
+    }
+    printf("IDs de publicaciones (%d procesos x %d hilos, %d IDs por proceso)\n", BENCH_ID_PROCESSES, BENCH_ID_THREADS, BENCH_IDS);
+    bool ok = true;
+    for(int p=0; p<BENCH_ID_PROCESSES; p++){
+        double seconds = 0;
+        bool read = fread(&seconds, sizeof(double), 1, inputs[p]) == 1 && fread(&IDs[p * BENCH_IDS], sizeof(time_t), BENCH_IDS, inputs[p]) == BENCH_IDS;
+        fclose(inputs[p]);
+        waitpid(children[p], NULL, 0);
+        if(!read){
+            printf("\t"ANSI_COLOR_RED"El proceso %d no entrego sus IDs"ANSI_COLOR_RESET"\n", p);
+            free(IDs);
+            return;
+        }
+        int worker = (int)(((uint64_t)IDs[p * BENCH_IDS] >> COMMENT_ID_SEQUENCE_BITS) & ((1 << COMMENT_ID_WORKER_BITS) - 1));
+        double rate = BENCH_IDS / seconds;
+        printf("\tproceso %d    %10.3f ms %12.0f IDs/s   (identificador %d)\n", p, seconds * 1000, rate, worker);
+        ok = ok && rate >= BENCH_ID_RATE;
+    }
+
+    qsort(IDs, total, sizeof(time_t), compare_commentIDs);
+    int collisions = 0;
+    for(int i=1; i<total; i++){
+        if(IDs[i] == IDs[i - 1]){
+            collisions++;
+        }
+    }
+    printf("\t%d colisiones\n", collisions);
+    if(!ok){
+        printf("\t"ANSI_COLOR_RED"Un proceso genero menos de %d IDs/s"ANSI_COLOR_RESET"\n", BENCH_ID_RATE);
+    }
+    if(collisions > 0){
+        printf("\t"ANSI_COLOR_RED"Se repitieron IDs"ANSI_COLOR_RESET"\n");
+    }
+    free(IDs);
+}
+
+/**
+ * @brief Genera BENCH_IDS IDs con BENCH_ID_THREADS hilos y los envia, precedidos por los segundos que tomo generarlos
+ *
+ * @param out Archivo por el que se envian (se cierra)
+*/
+void run_bench_ID_process(FILE* out)
+{
+    time_t* IDs = (time_t*)malloc(sizeof(time_t) * BENCH_IDS);
+    if(IDs == NULL || out == NULL){
+        print_error(200, NULL, NULL);
+    }
+    ThreadPool pool = create_threadPool(BENCH_ID_THREADS);
+    double start = bench_seconds();
+    run_threadPool(pool, generate_bench_IDs, IDs, BENCH_IDS, 0);
+    double seconds = bench_seconds() - start;
+    delete_threadPool(pool);
+
+    if(fwrite(&seconds, sizeof(double), 1, out) != 1 || fwrite(IDs, sizeof(time_t), BENCH_IDS, out) != BENCH_IDS){
+        print_error(104, NULL, NULL);
+    }
+    fclose(out);
+    free(IDs);
+}
+
+/**
+ * @brief Compara la busqueda de amigos posibles (`find_possible_friends`: bitmap de visitados y cola circular sobre
+ * el grafo de IDs) contra la busqueda anterior con listas de enlaces, a distancia FRIENDS_SEARCH_DEPTH
+ *
+ * La red tiene BENCH_GRAPH_USERS usuarios con grados en ley de potencias (ver `create_bench_powerlaw_users`). Ambas
+ * busquedas parten de los mismos BENCH_BFS_SOURCES usuarios y deben encontrar la misma cantidad de candidatos.
+*/
+void bench_friend_bfs()
+{
+    double start = bench_seconds();
+    UserTable table = create_bench_powerlaw_users(BENCH_GRAPH_USERS);
+    double created = bench_seconds() - start;
+    FriendGraph graph = get_friendGraph(table);
+    int maxDegree = 0;
+    for(int ID=0; ID<graph->nodeCount; ID++){
+        if(graph->degree[ID] > maxDegree){
+            maxDegree = graph->degree[ID];
+        }
+    }
+
+    // Partimos de usuarios con amigos (sin amigos ambas busquedas terminan de inmediato)
+    unsigned int state = BENCH_SEED;
+    UserPosition sources[BENCH_BFS_SOURCES];
+    for(int i=0; i<BENCH_BFS_SOURCES; i++){
+        do{
+            sources[i] = table->usersByID[bench_random(&state) % table->idCount];
+        }while(graph->degree[sources[i]->ID] == 0);
+    }
+    delete_userLinkList(find_possible_friends(sources[0], table, FRIENDS_SEARCH_DEPTH)); // Construye el indice de gustos
+
+    long listCandidates = 0, graphCandidates = 0;
+    start = bench_seconds();
+    for(int i=0; i<BENCH_BFS_SOURCES; i++){
+        UserLinkList candidates = find_possible_friends_list(sources[i], table, FRIENDS_SEARCH_DEPTH);
+        for(UserLinkPosition aux = candidates->next; aux != NULL; aux = aux->next){
+            listCandidates++;
+        }
+        delete_userLinkList(candidates);
+    }
+    double list = (bench_seconds() - start) / BENCH_BFS_SOURCES;
+
+    start = bench_seconds();
+    for(int i=0; i<BENCH_BFS_SOURCES; i++){
+        UserLinkList candidates = find_possible_friends(sources[i], table, FRIENDS_SEARCH_DEPTH);
+        for(UserLinkPosition aux = candidates->next; aux != NULL; aux = aux->next){
+            graphCandidates++;
+        }
+        delete_userLinkList(candidates);
+    }
+    double bitmap = (bench_seconds() - start) / BENCH_BFS_SOURCES;
+
+    printf("Amigos posibles a distancia %d en una red de %d usuarios (%d amistades, grado maximo %d, creada en %.1f s)\n", FRIENDS_SEARCH_DEPTH, table->idCount, graph->edgeCount / 2, maxDegree, created);
+    printf("\t%d busquedas, %ld candidatos en promedio\n", BENCH_BFS_SOURCES, graphCandidates / BENCH_BFS_SOURCES);
+    printf("\t%-12s %10.3f ms\n", "listas", list * 1000);
+    printf("\t%-12s %10.3f ms   x%.2f\n", "bitmap", bitmap * 1000, list / bitmap);
+    if(listCandidates != graphCandidates){
+        printf("\t"ANSI_COLOR_RED"Las busquedas encontraron distintos candidatos (%ld y %ld)"ANSI_COLOR_RESET"\n", listCandidates, graphCandidates);
+    }
+    delete_userTable(table);
+}
+
+// Funciones de datos sinteticos
+
+/**
+ * @brief Crea una red sintetica de usuarios completos en memoria
+ *
+ * Cada usuario tiene BENCH_USER_GENRES generos, BENCH_USER_BANDS bandas y BENCH_FRIENDS amigos elegidos al azar.
+ * Como todos sus campos estan completos, `complete_user_from_json` nunca abre su archivo.
+ *
+ * @param count Cantidad de usuarios
+ * @return Tabla de usuarios creada
+*/
+UserTable create_bench_users(int count)
+{
+    const char* nationalities[] = {"Chile", "Argentina", "Peru", "Mexico", "Spain", "USA"};
+    unsigned int state = BENCH_SEED;
+    char name[32];
+    UserTable table = create_userTable(NULL);
+    for(int i=0; i<count; i++){
+        GenreLinkList genres = create_empty_genreLinkList(NULL);
+        for(int j=0; j<BENCH_USER_GENRES; j++){
+            snprintf(name, sizeof(name), "genero%u", bench_random(&state) % BENCH_GENRES);
+            if(!find_genreLinkList_node(genres, name)){
+                insert_genreLinkList_node_basicInfo(genres, name);
+            }
+        }
+        BandLinkList bands = create_empty_bandLinkList(NULL);
+        for(int j=0; j<BENCH_USER_BANDS; j++){
+            snprintf(name, sizeof(name), "banda%u", bench_random(&state) % BENCH_BANDS);
+            if(!find_bandLinkList_node(bands, name)){
+                insert_bandLinkList_node_basicInfo(bands, name);
+            }
+        }
+        UserLinkList friends = create_empty_userLinkList(NULL);
+        for(int j=0; j<BENCH_FRIENDS; j++){
+            unsigned int friend = bench_random(&state) % count;
+            snprintf(name, sizeof(name), "usuario%u", friend);
+            if(friend != (unsigned int)i && !find_userLinkList_node(friends, name)){
+                insert_userLinkList_node_basicInfo(friends, name);
+            }
+        }
+        snprintf(name, sizeof(name), "usuario%d", i);
+        insert_userTable_node(table, name, 18 + bench_random(&state) % 40, nationalities[bench_random(&state) % 6], "Usuario de prueba", genres, bands, friends, create_empty_commentLinkList(NULL));
+    }
+    return table;
+}
+
+/**
+ * @brief Crea una red sintetica grande cuyos grados siguen una ley de potencias, como las redes sociales reales
+ *
+ * Los grados se sortean entre BENCH_GRAPH_MIN_DEGREE y BENCH_GRAPH_MAX_DEGREE con P(k) ~ k^-BENCH_GRAPH_EXPONENT y
+ * las amistades se forman emparejando al azar esas puntas (modelo de configuracion), descartando las amistades con
+ * uno mismo y las repetidas. Los usuarios no tienen gustos, asi que quedan fuera del indice de gustos.
+ *
+ * @param count Cantidad de usuarios
+ * @return Tabla de usuarios creada, con su grafo de amistades ya construido
+*/
+UserTable create_bench_powerlaw_users(int count)
+{
+    unsigned int state = BENCH_SEED;
+    int* degrees = (int*)malloc(sizeof(int) * count);
+    if(degrees == NULL){
+        print_error(200, NULL, NULL);
+    }
+    size_t stubCount = 0;
+    for(int i=0; i<count; i++){
+        double u = (bench_random(&state) + 1.0) / 4294967296.0; // Uniforme en (0, 1]
+        double degree = BENCH_GRAPH_MIN_DEGREE * pow(u, -1.0 / (BENCH_GRAPH_EXPONENT - 1));
+        degrees[i] = degree > BENCH_GRAPH_MAX_DEGREE ? BENCH_GRAPH_MAX_DEGREE : (int)degree;
+        stubCount += degrees[i];
+    }
+    int* stubs = (int*)malloc(sizeof(int) * stubCount);
+    if(stubs == NULL){
+        print_error(200, NULL, NULL);
+    }
+    size_t position = 0;
+    for(int i=0; i<count; i++){
+        for(int j=0; j<degrees[i]; j++){
+            stubs[position++] = i;
+        }
+    }
+    for(size_t i=stubCount - 1; i>0; i--){ // Fisher-Yates
+        size_t j = bench_random(&state) % (i + 1);
+        int aux = stubs[i];
+        stubs[i] = stubs[j];
+        stubs[j] = aux;
+    }
+    FriendGraph graph = create_friendGraph(count);
+    for(size_t i=0; i+1<stubCount; i+=2){
+        if(stubs[i] != stubs[i + 1] && add_friendGraph_edge(graph, stubs[i], stubs[i + 1])){
+            add_friendGraph_edge(graph, stubs[i + 1], stubs[i]);
+        }
+    }
+    free(stubs);
+    free(degrees);
+
+    char name[32];
+    UserTable table = create_userTable(NULL);
+    for(int i=0; i<count; i++){
+        UserLinkList friends = create_empty_userLinkList(NULL);
+        UserLinkPosition last = friends;
+        for(int j=0; j<graph->degree[i]; j++){
+            snprintf(name, sizeof(name), "usuario%d", graph->adjacency[i][j]);
+            last = insert_userLinkList_node_basicInfo(last, name);
+        }
+        snprintf(name, sizeof(name), "usuario%d", i);
+        insert_userTable_node(table, name, 18 + bench_random(&state) % 40, "Chile", "Usuario de prueba", create_empty_genreLinkList(NULL), create_empty_bandLinkList(NULL), friends, create_empty_commentLinkList(NULL));
+    }
+    table->graph = graph; // Es el mismo que armaria `build_friendGraph` desde las listas de amigos, y los IDs son los indices
+    return table;
+}
+
+/**
+ * @brief Crea publicaciones sinteticas de hasta MAX_COMMENT_LENGTH - 1 caracteres
+ *
+ * Las palabras son minusculas de largo variable y en promedio una de cada BENCH_TAG_PERIOD es una etiqueta
+ * ('#' o '@' seguido de la palabra), como en las publicaciones reales.
+ *
+ * @param count Cantidad de publicaciones
+ * @param state Estado del generador pseudoaleatorio
+ * @return Arreglo de @p count textos
+*/
+char** create_bench_texts(int count, unsigned int* state)
+{
+    char** texts = (char**)malloc(sizeof(char*) * count);
+    if(texts == NULL){
+        print_error(200, NULL, NULL);
+    }
+    for(int i=0; i<count; i++){
+        int length = MAX_COMMENT_LENGTH / 2 + bench_random(state) % (MAX_COMMENT_LENGTH / 2);
+        texts[i] = (char*)malloc(length + 1);
+        if(texts[i] == NULL){
+            print_error(200, NULL, NULL);
+        }
+        int position = 0;
+        while(position < length){
+            unsigned int kind = bench_random(state) % BENCH_TAG_PERIOD;
+            if(kind == 0 || kind == 1){
+                texts[i][position++] = kind == 0 ? '#' : '@';
+            }
+            int word = 2 + bench_random(state) % 9;
+            for(int j=0; j<word && position < length; j++){
+                texts[i][position++] = 'a' + bench_random(state) % 26;
+            }
+            if(position < length){
+                texts[i][position++] = ' ';
+            }
+        }
+        texts[i][length] = '\0';
+    }
+    return texts;
+}
+
+/**
+ * @brief Borra las publicaciones sinteticas
+ *
+ * @param texts Arreglo de textos
+ * @param count Cantidad de textos
+*/
+void delete_bench_texts(char** texts, int count)
+{
+    for(int i=0; i<count; i++){
+        free(texts[i]);
+    }
+    free(texts);
+}
+
+/**
+ * @brief Crea publicaciones sinteticas completas (texto, autor y etiquetas) sin tabla de comentarios
+ *
+ * @param count Cantidad de publicaciones
+ * @param state Estado del generador pseudoaleatorio
+ * @return Arreglo de @p count comentarios
+*/
+CommentPosition* create_bench_comments(int count, unsigned int* state)
+{
+    char** texts = create_bench_texts(count, state);
+    CommentPosition* comments = (CommentPosition*)malloc(sizeof(CommentPosition) * count);
+    if(comments == NULL){
+        print_error(200, NULL, NULL);
+    }
+    char author[32];
+    for(int i=0; i<count; i++){
+        snprintf(author, sizeof(author), "usuario%u", bench_random(state) % BENCH_USERS);
+        comments[i] = complete_comment_tags(create_new_comment(next_comment_ID(NULL), texts[i], author));
+    }
+    delete_bench_texts(texts, count);
+    return comments;
+}
+
+// Funciones auxiliares
+
+/**
+ * @brief Obtiene el tiempo de un reloj monotono
+ *
+ * @return Segundos desde un momento fijo
+*/
+double bench_seconds()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Genera un numero pseudoaleatorio (xorshift32)
+ *
+ * @param state Estado del generador (distinto de 0), se actualiza
+ * @return Numero generado
+*/
+unsigned int bench_random(unsigned int* state)
+{
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/**
+ * @brief Igual que `scan_tags`, pero buscando de a un byte (la referencia de `bench_tags`)
+ *
+ * @param text Texto a recorrer
+ * @param handler Funcion que recibe cada etiqueta
+ * @param arg Argumento que se entrega a @p handler
+ * @return Cantidad de etiquetas encontradas
+*/
+int scan_tags_scalar(const char* text, TagHandler handler, void* arg)
+{
+    size_t length = strlen(text);
+    size_t position = find_tag_mark_scalar(text, 0, length);
+    int count = 0;
+    while(position < length){
+        char mark = text[position];
+        size_t end = find_tag_end_scalar(text, position + 1, length);
+        if(end > position + 1){
+            handler(mark, &text[position + 1], end - position - 1, arg);
+            count++;
+        }
+        position = find_tag_mark_scalar(text, end, length);
+    }
+    return count;
+}
+
+/**
+ * @brief Igual que `find_possible_friends`, pero con la busqueda anterior al grafo de IDs (la referencia de
+ * `bench_friend_bfs`)
+ *
+ * La cola y los visitados son listas de enlaces por nombre: cada usuario que se atiende se busca en la tabla, cada
+ * vecino se busca recorriendo los visitados y se atiende al mas antiguo de la cola recorriendola hasta el final. No
+ * agrega a los usuarios parecidos del indice de gustos.
+ *
+ * @param user Usuario a recomendar amigos
+ * @param table Tabla de usuarios
+ * @param maxDepth Distancia maxima (en amistades) a la que se buscan usuarios
+ * @return Lista de usuarios a distancia 2 hasta @p maxDepth (la distancia queda en coefficient)
+*/
+UserLinkList find_possible_friends_list(UserPosition user, UserTable table, int maxDepth)
+{
+    UserLinkList visited = create_empty_userLinkList(NULL);
+    UserLinkList queue = create_empty_userLinkList(NULL);
+    insert_userLinkList_node_basicInfo(queue, user->username);
+    insert_userLinkList_node_basicInfo(visited, user->username);
+
+    while(queue->next != NULL){
+        UserLinkPosition rear = userLinkList_last(queue);
+        int depth = (int)rear->coefficient;
+        UserPosition current = find_userTable_node(table, rear->userName);
+        if(current != NULL && depth < maxDepth){
+            complete_user_from_json(current);
+            for(UserLinkPosition friend = current->friends->next; friend != NULL; friend = friend->next){
+                if(!find_userLinkList_node(visited, friend->userName)){
+                    insert_userLinkList_node_basicInfo(queue, friend->userName)->coefficient = depth + 1;
+                    insert_userLinkList_node_basicInfo(visited, friend->userName)->coefficient = depth + 1;
+                }
+            }
+        }
+        delete_userLinkList_node(rear, queue);
+    }
+
+    // Eliminamos al usuario y a sus amigos directos
+    UserLinkPosition aux = visited->next;
+    while(aux != NULL){
+        UserLinkPosition next = aux->next;
+        if(aux->coefficient < 2){
+            delete_userLinkList_node(aux, visited);
+        }
+        aux = next;
+    }
+    delete_userLinkList(queue);
+    return visited;
+}
+
+/**
+ * @brief Cuenta una etiqueta encontrada (se usa como `TagHandler`)
+ *
+ * @param mark Caracter que inicia la etiqueta
+ * @param tag Inicio de la etiqueta
+ * @param length Largo de la etiqueta
+ * @param arg Puntero al contador (size_t)
+*/
+void count_bench_tag(char mark, const char* tag, size_t length, void* arg)
+{
+    (void)mark;
+    (void)tag;
+    (void)length;
+    (*(size_t*)arg)++;
+}
+
+/**
+ * @brief Tarea del pool de hilos: genera los IDs de publicaciones de un bloque
+ *
+ * @param arg Arreglo donde quedan los IDs
+ * @param worker Indice del hilo
+ * @param first Primer indice del bloque
+ * @param last Indice siguiente al ultimo del bloque
+*/
+void generate_bench_IDs(void* arg, int worker, int first, int last)
+{
+    (void)worker;
+    time_t* IDs = (time_t*)arg;
+    for(int i=first; i<last; i++){
+        IDs[i] = next_comment_ID(NULL);
+    }
+}
+
+/**
+ * @brief Imprime un comentario como lo hacia `print_commentNode` antes del buffer de pantalla (referencia de
+ * `bench_feed_render`)
+ *
+ * @param out Archivo donde se imprime
+ * @param comment Comentario a imprimir
+*/
+void print_commentNode_stdio(FILE* out, PtrToComment comment)
+{
+    fprintf(out, ANSI_COLOR_BLUE "%s " ANSI_COLOR_RESET "( ", comment->user->userName);
+    time_t time = comment_ID_to_time(comment->ID);
+    char date[RENDER_DATE_LENGTH];
+    strftime(date, RENDER_DATE_LENGTH, "%Y-%m-%d %H:%M:%S %Z", localtime(&time));
+    fprintf(out, "%s )\n", date);
+    print_loopweb_stdio(out, comment->text);
+    fprintf(out, "\n\n");
+}
+
+/**
+ * @brief Imprime un texto de LoopWeb como lo hacia `print_loopweb` antes del buffer de pantalla: copia el texto, lo
+ * separa con strtok y escribe cada caracter con putc
+ *
+ * @param out Archivo donde se imprime
+ * @param text Texto a imprimir
+*/
+void print_loopweb_stdio(FILE* out, const char* text)
+{
+    char* line = malloc(strlen(text) + 1);
+    if(line == NULL){
+        print_error(200, NULL, NULL);
+    }
+    strcpy(line, text);
+
+    char* token = strtok(line, " ");
+    while(token != NULL){
+        char* ptr = token;
+        while(*ptr != '\0'){
+            if(*ptr == '@' || *ptr == '#'){
+                fprintf(out, "%s%c", *ptr == '@' ? ANSI_COLOR_GREEN : ANSI_COLOR_RED, *ptr);
+                ptr++;
+                while(*ptr != '\0' && *ptr != '@' && *ptr != '#' && *ptr != '\n'){
+                    putc(*ptr, out);
+                    ptr++;
+                }
+                fprintf(out, ANSI_COLOR_RESET);
+            }
+            else{
+                putc(*ptr, out);
+                ptr++;
+            }
+        }
+        token = strtok(NULL, " ");
+        fprintf(out, " ");
+    }
+    fprintf(out, "\b");
+    free(line);
+}
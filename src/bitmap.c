@@ -0,0 +1,192 @@
+/**
+ * @file bitmap.c
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Conjuntos de IDs densos representados como mapas de bits
+*/
+#include "bitmap.h"
+
+/**
+ * @brief Crea un bitmap vacio
+ *
+ * @param bits Cantidad de bits iniciales (el bitmap crece si se usan bits mayores)
+ * @return Puntero al bitmap creado
+*/
+Bitmap create_bitmap(int bits)
+{
+    Bitmap bitmap = (Bitmap)malloc(sizeof(struct _bitmap));
+    if(bitmap == NULL){
+        print_error(200, NULL, NULL);
+    }
+    bitmap->wordCount = bits > 0 ? (bits + 63)/64 : 1;
+    bitmap->words = (unsigned long long*)calloc(bitmap->wordCount, sizeof(unsigned long long));
+    if(bitmap->words == NULL){
+        print_error(200, NULL, NULL);
+    }
+    bitmap->count = 0;
+    return bitmap;
+}
+
+/**
+ * @brief Borra un bitmap
+ *
+ * @param bitmap Bitmap a borrar
+*/
+void delete_bitmap(Bitmap bitmap)
+{
+    if(bitmap == NULL){
+        return;
+    }
+    free(bitmap->words);
+    free(bitmap);
+}
+
+/**
+ * @brief Vacia un bitmap sin liberar su memoria
+ *
+ * @param bitmap Bitmap a vaciar
+*/
+void clear_bitmap(Bitmap bitmap)
+{
+    memset(bitmap->words, 0, sizeof(unsigned long long) * bitmap->wordCount);
+    bitmap->count = 0;
+}
+
+/**
+ * @brief Asegura que el bitmap tenga espacio para al menos @p bits bits
+ *
+ * @param bitmap Bitmap a agrandar
+ * @param bits Cantidad de bits requerida
+*/
+void resize_bitmap(Bitmap bitmap, int bits)
+{
+    int words = (bits + 63)/64;
+    if(words <= bitmap->wordCount){
+        return;
+    }
+    unsigned long long* newWords = (unsigned long long*)realloc(bitmap->words, sizeof(unsigned long long) * words);
+    if(newWords == NULL){
+        print_error(200, NULL, NULL);
+    }
+    memset(newWords + bitmap->wordCount, 0, sizeof(unsigned long long) * (words - bitmap->wordCount));
+    bitmap->words = newWords;
+    bitmap->wordCount = words;
+}
+
+/**
+ * @brief Indica si un bit esta encendido
+ *
+ * @param bitmap Bitmap a consultar
+ * @param bit Bit a consultar
+ * @return TRUE si el bit esta encendido, FALSE en caso contrario
+*/
+bool test_bitmap_bit(Bitmap bitmap, int bit)
+{
+    if(bit < 0 || bit/64 >= bitmap->wordCount){
+        return false;
+    }
+    return (bitmap->words[bit/64] >> (bit % 64)) & 1ULL;
+}
+
+/**
+ * @brief Enciende un bit del bitmap
+ *
+ * @param bitmap Bitmap a modificar
+ * @param bit Bit a encender
+ * @return TRUE si el bit estaba apagado, FALSE si ya estaba encendido
+*/
+bool set_bitmap_bit(Bitmap bitmap, int bit)
+{
+    if(bit < 0){
+        return false;
+    }
+    resize_bitmap(bitmap, bit + 1);
+    unsigned long long mask = 1ULL << (bit % 64);
+    if(bitmap->words[bit/64] & mask){
+        return false;
+    }
+    bitmap->words[bit/64] |= mask;
+    bitmap->count++;
+    return true;
+}
+
+/**
+ * @brief Apaga un bit del bitmap
+ *
+ * @param bitmap Bitmap a modificar
+ * @param bit Bit a apagar
+ * @return TRUE si el bit estaba encendido, FALSE en caso contrario
+*/
+bool unset_bitmap_bit(Bitmap bitmap, int bit)
+{
+    if(!test_bitmap_bit(bitmap, bit)){
+        return false;
+    }
+    bitmap->words[bit/64] &= ~(1ULL << (bit % 64));
+    bitmap->count--;
+    return true;
+}
+
+/**
+ * @brief Busca el siguiente bit encendido a partir de una posicion
+ *
+ * @param bitmap Bitmap a recorrer
+ * @param from Primer bit a considerar
+ * @return Posicion del siguiente bit encendido, -1 si no hay mas
+ * @note Se saltan 64 bits a la vez, por lo que recorrer el conjunto cuesta O(bits/64 + elementos)
+*/
+int next_bitmap_bit(Bitmap bitmap, int from)
+{
+    if(from < 0){
+        from = 0;
+    }
+    int word = from/64;
+    if(word >= bitmap->wordCount){
+        return -1;
+    }
+    unsigned long long current = bitmap->words[word] & (~0ULL << (from % 64));
+    while(current == 0){
+        word++;
+        if(word >= bitmap->wordCount){
+            return -1;
+        }
+        current = bitmap->words[word];
+    }
+    return word*64 + __builtin_ctzll(current);
+}
+
+// Operaciones de conjunto sobre bitmaps
+
+/**
+ * @brief Cuenta los elementos presentes en dos bitmaps a la vez
+ *
+ * @param a Primer bitmap
+ * @param b Segundo bitmap
+ * @return Tamaño de la interseccion de @p a y @p b
+ * @note Se procesa una palabra de 64 bits por iteracion con popcount, sin reservar memoria
+*/
+int intersection_count_bitmap(Bitmap a, Bitmap b)
+{
+    int words = a->wordCount < b->wordCount ? a->wordCount : b->wordCount;
+    int count = 0;
+    for(int i=0; i<words; i++){
+        count += __builtin_popcountll(a->words[i] & b->words[i]);
+    }
+    return count;
+}
+
+/**
+ * @brief Calcula el indice de Jaccard entre dos bitmaps
+ *
+ * @param a Primer bitmap
+ * @param b Segundo bitmap
+ * @return |A ∩ B| / |A ∪ B|, 0 si ambos conjuntos estan vacios
+ * @note El tamaño de la union se obtiene como |A| + |B| - |A ∩ B| usando los contadores de cada bitmap
+*/
+double jacardIndex_bitmap(Bitmap a, Bitmap b)
+{
+    if(a == NULL || b == NULL || a->count == 0 || b->count == 0){
+        return 0;
+    }
+    int intersectionSize = intersection_count_bitmap(a, b);
+    return (double)intersectionSize / (double)(a->count + b->count - intersectionSize);
+}
@@ -125,6 +125,8 @@ CommentLinkPosition insert_commentLinkList_node_basicInfo(CommentLinkPosition pr
         print_error(200, NULL, NULL);
     }
     newNode->commentID = commentID;
+    newNode->coefficient = 0;
+    newNode->commentNode = NULL;
     newNode->next = prevPosition->next;
     prevPosition->next = newNode;
     return newNode;
@@ -143,6 +145,7 @@ CommentLinkPosition insert_commentLinkList_node_completeInfo(CommentLinkPosition
         print_error(200, NULL, NULL);
     }
     newNode->commentID = commentNode->ID;
+    newNode->coefficient = 0;
     newNode->commentNode = commentNode;
     newNode->next = prevPosition->next;
     prevPosition->next = newNode;
@@ -162,7 +165,7 @@ void delete_commentLinkList_node(CommentLinkPosition P, CommentLinkList linkList
     CommentLinkPosition prevNode = find_commentLinkList_prev_node(P, linkList);
     if(prevNode == NULL){
         char commentID[20];
-        strcpy(commentID, ctime(&P->commentID));
+        sprintf(commentID, "%ld", P->commentID);
         print_error(302, commentID, NULL);
         return;
     }
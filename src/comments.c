@@ -5,6 +5,11 @@
 */
 #include "comments.h"
 
+uint64_t commentIDState = 0;                        /**< Ultimo milisegundo y secuencia entregados por next_comment_ID */
+int commentWorkerID = 0;                            /**< Identificador de este proceso dentro de los IDs */
+int commentWorkerFd = -1;                           /**< Archivo COMMENT_WORKER_LOCK que reserva commentWorkerID */
+pthread_once_t commentWorkerOnce = PTHREAD_ONCE_INIT; /**< Inicializa commentWorkerID una sola vez */
+
 // Funciones para un nodo de comentario
 /**
  * @brief Imprime un nodo de comentario por terminal
@@ -12,16 +17,31 @@
  * @param comment Puntero al nodo de comentario
 */
 void print_commentNode(PtrToComment comment)
+{
+    RenderBuffer buffer = create_renderBuffer(STDOUT_FILENO);
+    render_commentNode(buffer, comment);
+    delete_renderBuffer(buffer);
+}
+
+/**
+ * @brief Agrega un nodo de comentario a un buffer de pantalla, con el mismo formato de `print_commentNode`
+ *
+ * @param buffer Buffer de pantalla
+ * @param comment Puntero al nodo de comentario
+*/
+void render_commentNode(RenderBuffer buffer, PtrToComment comment)
 {
     if(!comment || !comment->user->userName || !comment->text || !comment->bands || !comment->genres){
         print_error(202, NULL, NULL);
     }
 
-    printf(ANSI_COLOR_BLUE "%s " ANSI_COLOR_RESET "( ", comment->user->userName);
-    print_date(comment->ID);
-    printf(" )\n");
-    print_loopweb(comment->text);
-    printf("\n\n");
+    render_string(buffer, ANSI_COLOR_BLUE);
+    render_string(buffer, comment->user->userName);
+    render_string(buffer, " " ANSI_COLOR_RESET "( ");
+    render_date(buffer, comment_ID_to_time(comment->ID));
+    render_string(buffer, " )\n");
+    render_loopweb(buffer, comment->text);
+    render_string(buffer, "\n\n");
 }
 
 /**
@@ -207,6 +227,8 @@ CommentPosition create_new_comment(time_t ID, const char *text, char* author){
     newComment->bands = create_empty_bandLinkList(NULL);
     newComment->genres = create_empty_genreLinkList(NULL);
     newComment->complete = false;
+    newComment->rankStamp = 0;
+    newComment->rankMatches = 0;
     newComment->next = NULL;
     return newComment;
 }
@@ -285,13 +307,22 @@ bool delete_CommentList_node(CommentPosition P, CommentList commentList){
         return false;
     }
     prevNode->next = P->next;
+    delete_commentNode(P);
+    return true;
+}
+
+/**
+ * @brief Libera un nodo de comentario que no esta (o ya no esta) en una lista
+ *
+ * @param P Nodo a liberar
+*/
+void delete_commentNode(CommentPosition P){
     free(P->user->userName); // Lo eliminamos de esta manera porque P->user es el centinela de una lista y la funcion de eliminacion no toma en cuenta que el centinela tenga informeacion dentro
     delete_userLinkList(P->user);
     delete_genreLinkList(P->genres);
     delete_bandLinkList(P->bands);
     free(P->text);
     free(P);
-    return true;
 }
 
 // Funciones de interaccion con el usuario
@@ -352,7 +383,14 @@ CommentTable create_commentTable(CommentTable commentTable)
         commentTable->commentCount = 0;
     }
 
+    commentTable->rankGeneration = 0;
+    commentTable->recentIDs = NULL;
+    commentTable->recentCount = 0;
+    commentTable->recentCapacity = 0;
+    commentTable->recentLoading = false;
+    commentTable->textIndex = NULL;
     commentTable->modified = false;
+    init_table_lock(&commentTable->lock);
 
     return commentTable;
 }
@@ -382,10 +420,11 @@ void print_commentTable(CommentTable commentTable)
 */
 CommentPosition insert_commentTable_comment(CommentPosition comment, CommentTable commentTable)
 {
-    unsigned int index = comment->ID % COMMENTS_TABLE_SIZE;
+    unsigned int index = comment_ID_hash(comment->ID);
     CommentPosition position = insert_CommentList_node(commentTable->buckets[index], comment);
     if (position != NULL) {
         commentTable->commentCount++;
+        insert_recentIndex_ID(commentTable, comment->ID);
     }
     commentTable->modified = true;
     return position;
@@ -398,13 +437,14 @@ CommentPosition insert_commentTable_comment(CommentPosition comment, CommentTabl
 */
 void delete_commentTable_comment(time_t ID, CommentTable commentTable)
 {
-    int index = ID % COMMENTS_TABLE_SIZE;
+    unsigned int index = comment_ID_hash(ID);
     CommentPosition position = find_CommentList_node(commentTable->buckets[index], ID);
     if (position == NULL) {
         print_error(301, NULL, NULL);
         return;
     }
     delete_CommentList_node(position, commentTable->buckets[index]);
+    delete_recentIndex_ID(commentTable, ID);
     commentTable->modified = true;
     commentTable->commentCount--;
 }
@@ -418,6 +458,9 @@ void delete_commentTable(CommentTable commentTable)
     for (int i = 0; i < COMMENTS_TABLE_SIZE; i++) {
         delete_CommentList(commentTable->buckets[i]);
     }
+    free(commentTable->recentIDs);
+    delete_textIndex(commentTable->textIndex);
+    pthread_rwlock_destroy(&commentTable->lock);
     free(commentTable);
 }
 
@@ -429,7 +472,7 @@ void delete_commentTable(CommentTable commentTable)
 */
 CommentPosition find_commentTable_comment(time_t ID, CommentTable commentTable)
 {
-    int index = ID % COMMENTS_TABLE_SIZE;
+    unsigned int index = comment_ID_hash(ID);
     return find_CommentList_node(commentTable->buckets[index], ID);
 }
 
@@ -474,65 +517,335 @@ void save_commentTable(CommentTable commentTable)
     fclose(commentTableFile);
 }
 
+// Indice cronologico de comentarios
+
+/**
+ * @brief Busca la posicion de un ID en el indice cronologico (busqueda binaria)
+ *
+ * @param commentTable Tabla de comentarios
+ * @param ID ID a buscar
+ * @return Posicion del primer ID mayor o igual a @p ID (recentCount si todos son menores)
+*/
+int find_recentIndex_position(CommentTable commentTable, time_t ID)
+{
+    int low = 0, high = commentTable->recentCount;
+    while(low < high){
+        int mid = low + (high - low)/2;
+        if(commentTable->recentIDs[mid] < ID){
+            low = mid + 1;
+        }
+        else{
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/**
+ * @brief Agrega un ID al indice cronologico manteniendo el orden
+ *
+ * @param commentTable Tabla de comentarios
+ * @param ID ID del comentario agregado
+ * @note Los comentarios nuevos siempre son los mas recientes, por lo que el caso comun es agregar al final en O(1).
+ * Mientras se lee comments.json (recentLoading) los IDs llegan en el orden de los buckets, asi que solo se agregan al
+ * final y `sort_recentIndex` los ordena una vez al terminar.
+*/
+void insert_recentIndex_ID(CommentTable commentTable, time_t ID)
+{
+    if(commentTable->recentCount == commentTable->recentCapacity){
+        int newCapacity = commentTable->recentCapacity ? 2*commentTable->recentCapacity : 64;
+        time_t* newIDs = (time_t*)realloc(commentTable->recentIDs, sizeof(time_t) * newCapacity);
+        if(newIDs == NULL){
+            print_error(200, NULL, NULL);
+        }
+        commentTable->recentIDs = newIDs;
+        commentTable->recentCapacity = newCapacity;
+    }
+
+    int position = commentTable->recentCount;
+    if(!commentTable->recentLoading && position > 0 && commentTable->recentIDs[position - 1] > ID){ // Llego desordenado
+        position = find_recentIndex_position(commentTable, ID);
+        memmove(&commentTable->recentIDs[position + 1], &commentTable->recentIDs[position], sizeof(time_t) * (commentTable->recentCount - position));
+    }
+    commentTable->recentIDs[position] = ID;
+    commentTable->recentCount++;
+}
+
+/**
+ * @brief Ordena el indice cronologico despues de leer comments.json y vuelve a las inserciones ordenadas
+ *
+ * @param commentTable Tabla de comentarios
+*/
+void sort_recentIndex(CommentTable commentTable)
+{
+    qsort(commentTable->recentIDs, commentTable->recentCount, sizeof(time_t), compare_commentIDs);
+    commentTable->recentLoading = false;
+}
+
+/**
+ * @brief Elimina un ID del indice cronologico
+ *
+ * @param commentTable Tabla de comentarios
+ * @param ID ID del comentario eliminado
+*/
+void delete_recentIndex_ID(CommentTable commentTable, time_t ID)
+{
+    int position = find_recentIndex_position(commentTable, ID);
+    if(position >= commentTable->recentCount || commentTable->recentIDs[position] != ID){
+        return;
+    }
+    memmove(&commentTable->recentIDs[position], &commentTable->recentIDs[position + 1], sizeof(time_t) * (commentTable->recentCount - position - 1));
+    commentTable->recentCount--;
+}
+
+/**
+ * @brief Obtiene las @p n publicaciones mas recientes de toda la red
+ *
+ * @param commentTable Tabla de comentarios
+ * @param n Cantidad de publicaciones a obtener
+ * @return Lista de enlaces a comentarios de mas reciente a mas antiguo (sin leer los comentarios de disco)
+ * @note Costo O(n), independiente de la cantidad total de comentarios
+*/
+CommentLinkList get_recent_comments(CommentTable commentTable, int n)
+{
+    CommentLinkList recent = create_empty_commentLinkList(NULL);
+    CommentLinkPosition last = recent;
+    for(int i = commentTable->recentCount - 1; i >= 0 && n > 0; i--, n--){
+        last = insert_commentLinkList_node_basicInfo(last, commentTable->recentIDs[i]);
+    }
+    return recent;
+}
+
+// IDs de comentarios
+
+/**
+ * @brief Entrega el ID para una publicacion nueva
+ *
+ * El ID junta en 64 bits los milisegundos desde COMMENT_ID_EPOCH_MS, el identificador del proceso y una secuencia
+ * dentro del milisegundo, por lo que los IDs siguen ordenados por fecha y varias publicaciones en el mismo segundo (o
+ * desde varios procesos que comparten los archivos, ver `init_comment_worker`) no se repiten. El ultimo milisegundo y secuencia entregados se
+ * guardan en commentIDState y se avanzan con compare-and-swap, sin candados: si la secuencia se agota se usa el
+ * milisegundo siguiente, y si el reloj retrocede se sigue desde el ultimo valor entregado.
+ *
+ * @param commentTable Tabla de comentarios (los IDs nuevos quedan despues del mas reciente), o NULL
+ * @return ID de la publicacion
+*/
+time_t next_comment_ID(CommentTable commentTable)
+{
+    pthread_once(&commentWorkerOnce, init_comment_worker);
+
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    uint64_t millis = (uint64_t)((long long)now.tv_sec * 1000 + now.tv_nsec / 1000000 - COMMENT_ID_EPOCH_MS);
+
+    uint64_t floor = 0; // Milisegundo y secuencia del comentario mas reciente de la tabla
+    if(commentTable && commentTable->recentCount > 0){
+        time_t last = commentTable->recentIDs[commentTable->recentCount - 1];
+        if(last >= COMMENT_ID_LEGACY_LIMIT){
+            floor = ((uint64_t)last >> (COMMENT_ID_WORKER_BITS + COMMENT_ID_SEQUENCE_BITS) << COMMENT_ID_SEQUENCE_BITS)
+                  | ((uint64_t)last & ((1u << COMMENT_ID_SEQUENCE_BITS) - 1));
+        }
+    }
+
+    uint64_t state = __atomic_load_n(&commentIDState, __ATOMIC_RELAXED), next;
+    do{
+        next = millis << COMMENT_ID_SEQUENCE_BITS;
+        if(next <= state){
+            next = state + 1;
+        }
+        if(next <= floor){
+            next = floor + 1;
+        }
+    }while(!__atomic_compare_exchange_n(&commentIDState, &state, next, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+    return (time_t)((next >> COMMENT_ID_SEQUENCE_BITS << (COMMENT_ID_WORKER_BITS + COMMENT_ID_SEQUENCE_BITS))
+                  | ((uint64_t)commentWorkerID << COMMENT_ID_SEQUENCE_BITS)
+                  | (next & ((1u << COMMENT_ID_SEQUENCE_BITS) - 1)));
+}
+
+/**
+ * @brief Elige el identificador de este proceso dentro de los IDs (se llama una vez con pthread_once)
+ *
+ * Se parte del valor de la variable de entorno COMMENT_WORKER_ENV, o del PID si no existe, y se toma el primer
+ * identificador libre desde ahi. Cada proceso reserva el suyo con un candado sobre COMMENT_WORKER_LOCK mientras viva,
+ * asi dos procesos que comparten ./build nunca generan IDs con el mismo identificador (hasta 2^COMMENT_ID_WORKER_BITS
+ * procesos a la vez). Si el candado no se puede abrir se usa el identificador de partida sin reservarlo, con aviso.
+*/
+void init_comment_worker()
+{
+    int workers = 1 << COMMENT_ID_WORKER_BITS;
+    const char* configured = getenv(COMMENT_WORKER_ENV);
+    int first = configured ? atoi(configured) : (int)getpid();
+    first &= workers - 1;
+    for(int i=0; i<workers; i++){
+        int worker = (first + i) & (workers - 1);
+        if(claim_comment_worker(worker)){
+            commentWorkerID = worker;
+            return;
+        }
+        if(errno != EWOULDBLOCK){ // No se pudo abrir el candado (ya se aviso), tampoco se podran abrir los demas
+            commentWorkerID = first;
+            return;
+        }
+    }
+    print_error(306, NULL, NULL);
+    commentWorkerID = first;
+}
+
+/**
+ * @brief Intenta reservar un identificador de proceso para los IDs de comentarios
+ *
+ * El candado (flock) se suelta solo cuando el proceso termina, aunque termine sin guardar. Si el archivo del
+ * candado no se puede abrir (por ejemplo, si no existe ./build) se avisa con el error 307.
+ *
+ * @param worker Identificador a reservar
+ * @return TRUE si el identificador quedo reservado para este proceso, FALSE si lo tiene otro proceso (errno es
+ * EWOULDBLOCK) o si no se pudo abrir el candado
+*/
+bool claim_comment_worker(int worker)
+{
+    char path[64];
+    snprintf(path, sizeof(path), COMMENT_WORKER_LOCK, worker);
+    int fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if(fd < 0){
+        print_error(307, path, NULL);
+        return false;
+    }
+    if(flock(fd, LOCK_EX | LOCK_NB) < 0){
+        close(fd);
+        return false;
+    }
+    commentWorkerFd = fd;
+    return true;
+}
+
+/**
+ * @brief Obtiene el momento en que se publico un comentario a partir de su ID
+ *
+ * @param ID ID del comentario
+ * @return Momento de la publicacion en segundos (los IDs de la version anterior ya eran segundos)
+*/
+time_t comment_ID_to_time(time_t ID)
+{
+    if(ID < COMMENT_ID_LEGACY_LIMIT){
+        return ID;
+    }
+    long long millis = (long long)((uint64_t)ID >> (COMMENT_ID_WORKER_BITS + COMMENT_ID_SEQUENCE_BITS)) + COMMENT_ID_EPOCH_MS;
+    return (time_t)(millis / 1000);
+}
+
+/**
+ * @brief Calcula el bucket de un comentario en la tabla de comentarios
+ *
+ * Los bits bajos de un ID son la secuencia, que casi siempre es 0, por lo que se mezclan todos los bits (finalizador
+ * de splitmix64) antes de tomar el modulo.
+ *
+ * @param ID ID del comentario
+ * @return Indice del bucket, entre 0 y COMMENTS_TABLE_SIZE - 1
+*/
+unsigned int comment_ID_hash(time_t ID)
+{
+    uint64_t x = (uint64_t)ID;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return (unsigned int)(x % COMMENTS_TABLE_SIZE);
+}
+
+/**
+ * @brief Funcion de comparacion de IDs de comentarios para qsort (orden cronologico)
+ *
+ * @param a Puntero al primer ID
+ * @param b Puntero al segundo ID
+ * @return Negativo, cero o positivo segun el orden de los IDs
+*/
+int compare_commentIDs(const void* a, const void* b)
+{
+    time_t x = *(const time_t*)a, y = *(const time_t*)b;
+    return (x > y) - (x < y);
+}
+
 // Ordenamiento y completacion
+
+/**
+ * @brief Rehace las listas de bandas y generos de un comentario a partir de las etiquetas de su texto
+ *
+ * @param comment Comentario a completar
+ * @return El mismo comentario
+ * @note Las etiquetas se buscan con `scan_tags` y se copian directamente a los nodos de las listas
+*/
 CommentPosition complete_comment_tags(CommentPosition comment){
     #ifdef DEBUG
         printf("Agregando tags del nodo %ld\n", comment->ID);
     #endif
     comment->bands = create_empty_bandLinkList(comment->bands);
     comment->genres = create_empty_genreLinkList(comment->genres);
+    scan_tags(comment->text, insert_comment_tag, comment);
+    __atomic_store_n(&comment->complete, true, __ATOMIC_RELEASE); // Publica el texto y las etiquetas a los otros hilos (ver complete_comment_from_json)
+    return comment;
+}
 
-    // The existing implementation remains the same
-    char* ptr = comment->text;
-    char* tag_start = NULL;
-    char* tag_end = NULL;
-
-    while (*ptr) {
-        // Procesar hashtags para géneros
-        if (*ptr == '#') {
-            tag_start = ptr + 1;
-            tag_end = tag_start;
-
-            // Encontrar el final del hashtag
-            while (*tag_end && (isalnum(*tag_end) || *tag_end == '_')) {
-                tag_end++;
-            }
-            // Verificar si se encontró un tag válido
-            if (tag_end > tag_start) {
-                size_t tag_length = tag_end - tag_start;
-                char* genre = malloc(tag_length + 1);
-                strncpy(genre, tag_start, tag_length);
-                genre[tag_length] = '\0';
-                insert_genreLinkList_node_basicInfo(comment->genres, genre);
-                free(genre);
-            }
-            // Actualizar puntero
-            ptr = tag_end;
+/**
+ * @brief Agrega una etiqueta encontrada en el texto a las listas de un comentario (se usa como `TagHandler`)
+ *
+ * @param mark '#' para agregar un genero, '@' para agregar una banda
+ * @param tag Inicio de la etiqueta en el texto
+ * @param length Largo de la etiqueta
+ * @param arg Comentario al que se agrega la etiqueta
+*/
+void insert_comment_tag(char mark, const char* tag, size_t length, void* arg)
+{
+    CommentPosition comment = (CommentPosition)arg;
+    if(mark == '#'){
+        insert_genreLinkList_node_text(comment->genres, tag, length);
+    }
+    else{
+        insert_bandLinkList_node_text(comment->bands, tag, length);
+    }
+}
+
+/**
+ * @brief Reemplaza una etiqueta en el texto de un comentario (por ejemplo una banda mal escrita por la sugerida)
+ *
+ * @param comment Comentario a modificar
+ * @param mark Caracter que inicia la etiqueta ('@' para bandas, '#' para generos)
+ * @param oldTag Etiqueta a reemplazar, sin @p mark
+ * @param newTag Etiqueta nueva, sin @p mark
+ * @return Cantidad de apariciones reemplazadas
+ * @note Solo se reemplazan etiquetas completas, @p oldTag no puede ir seguida de otro caracter de etiqueta
+*/
+int replace_comment_tag(CommentPosition comment, char mark, const char* oldTag, const char* newTag)
+{
+    size_t oldLength = strlen(oldTag), newLength = strlen(newTag);
+    int count = 0;
+    for(char* ptr = strchr(comment->text, mark); ptr != NULL; ptr = strchr(ptr + 1, mark)){
+        if(strncmp(ptr + 1, oldTag, oldLength) == 0 && !isalnum((unsigned char)ptr[1 + oldLength]) && ptr[1 + oldLength] != '_'){
+            count++;
         }
-        // Procesar menciones para bandas
-        else if (*ptr == '@') {
-                tag_start = ptr + 1;
-                tag_end = tag_start;
-                // Encontrar el final de la mención
-                while (*tag_end && (isalnum(*tag_end) || *tag_end == '_')) {
-                    tag_end++;
-                }
-                // Verificar si se encontró un tag válido
-                if (tag_end > tag_start) {
-                    size_t tag_length = tag_end - tag_start;
-                    char* band = malloc(tag_length + 1);
-                    strncpy(band, tag_start, tag_length);
-                    band[tag_length] = '\0';
-                    insert_bandLinkList_node_basicInfo(comment->bands, band);
-                    free(band);
-                }
-                // Actualizar puntero
-                ptr = tag_end;
+    }
+    if(count == 0){
+        return 0;
+    }
+
+    char* text = (char*)malloc(strlen(comment->text) + count * newLength + 1);
+    if(text == NULL){
+        print_error(200, NULL, NULL);
+    }
+    char* out = text;
+    char* ptr = comment->text;
+    while(*ptr){
+        if(*ptr == mark && strncmp(ptr + 1, oldTag, oldLength) == 0 && !isalnum((unsigned char)ptr[1 + oldLength]) && ptr[1 + oldLength] != '_'){
+            *out++ = mark;
+            memcpy(out, newTag, newLength);
+            out += newLength;
+            ptr += 1 + oldLength;
         }
-        else {
-            ptr++;
+        else{
+            *out++ = *ptr++;
         }
     }
-    comment->complete = true;
-    return comment;
-}
\ No newline at end of file
+    *out = '\0';
+    free(comment->text);
+    comment->text = text;
+    return count;
+}
@@ -35,6 +35,15 @@ void print_error(int num, char* target, char* obs) {
         case 103:
             printf("Error al leer entrada por terminal\n");
             break;
+        case 104:
+            printf("No se pudo escribir en la salida\n");
+            break;
+        case 105:
+            printf("No se pudo abrir el socket %s\n", target);
+            break;
+        case 106:
+            printf("No se pudo conectar al servidor %s\n", target);
+            break;
         case 200:
             printf("No hay memoria disponible\n");
             exit(-1);
@@ -47,6 +56,10 @@ void print_error(int num, char* target, char* obs) {
             printf("Se intento acceder a un puntero nulo\n");
             exit(-1);
             break;
+        case 204:
+            printf("No se pudo crear un hilo de ejecucion\n");
+            exit(-1);
+            break;
         case 300:
             printf("Usuario %s no encontrado\n", target);
             break;
@@ -65,6 +78,12 @@ void print_error(int num, char* target, char* obs) {
         case 305:
             printf("Genero %s no encontrado\n", target);
             break;
+        case 306:
+            printf("No quedan identificadores de proceso libres para los IDs de publicaciones\n");
+            break;
+        case 307:
+            printf("No se pudo abrir %s, el identificador de proceso de los IDs de publicaciones queda sin reservar\n", target);
+            break;
         default:
             printf("Codigo de error desconocido\n");
     }
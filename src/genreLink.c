@@ -134,6 +134,31 @@ GenreLinkPosition insert_genreLinkList_node_basicInfo(GenreLinkPosition prevPosi
     return newNode;
 }
 
+/**
+ * @brief Crea el nodo correspondiente a un enlace a un genero a partir de un fragmento de texto (sin apuntar a un nodo)
+ *
+ * @param prevPosition Puntero al nodo anterior al que se desea insertar
+ * @param genre Inicio del nombre (no necesita terminar en '\0')
+ * @param length Largo del nombre
+ * @return Puntero al nodo creado
+ * @note Copia el nombre una sola vez, sin reservar un string temporal
+*/
+GenreLinkPosition insert_genreLinkList_node_text(GenreLinkPosition prevPosition, const char* genre, size_t length){
+    GenreLinkPosition newNode = (GenreLinkPosition) malloc(sizeof(struct _genreLinkNode));
+    if (newNode == NULL) {
+        print_error(200, NULL, NULL);
+    }
+    newNode->genre = malloc(length + 1);
+    if(newNode->genre == NULL){
+        print_error(200, NULL, NULL);
+    }
+    memcpy(newNode->genre, genre, length);
+    newNode->genre[length] = '\0';
+    newNode->next = prevPosition->next;
+    prevPosition->next = newNode;
+    return newNode;
+}
+
 /**
  * @brief Crea el nodo correspondiente a un enlace a un genero (apuntando a un nodo de genero)
  *
@@ -329,22 +354,42 @@ GenreLinkList intersection_genreLinkList(GenreLinkList list1, GenreLinkList list
 * @param list1 Primera lista de enlaces a generos.
  * @param list2 Segunda lista de enlaces a generos.
  * @return El índice de Jaccard de las dos listas de enlaces a generos.
+ * @note No reserva memoria. Para comparar gustos entre usuarios se usan los bitmaps de `genres_jacardIndex`
 */
 double jacardIndex_genreLinkList(GenreLinkList list1, GenreLinkList list2)
 {
-    int unionSize = 0, intersectionSize = 0;
+    int size1 = 0, size2 = 0, intersectionSize = 0;
     double jacardIndex = 0;
-    GenreLinkList unionList = union_genreLinkList(list1, list2, &unionSize);
-    GenreLinkList intersectionList = intersection_genreLinkList(list1, list2, &intersectionSize);
+
+    // Contamos sin construir listas auxiliares: un elemento solo cuenta en su primera aparicion
+    GenreLinkPosition current = genreLinkList_first(list1);
+    while (current != NULL) {
+        if (find_genreLinkList_node(list1, current->genre) == current) {
+            size1++;
+            if (find_genreLinkList_node(list2, current->genre) != NULL) {
+                intersectionSize++;
+            }
+        }
+        current = genreLinkList_advance(current);
+    }
+    current = genreLinkList_first(list2);
+    while (current != NULL) {
+        if (find_genreLinkList_node(list2, current->genre) == current) {
+            size2++;
+        }
+        current = genreLinkList_advance(current);
+    }
+
+    int unionSize = size1 + size2 - intersectionSize;
     if(unionSize == 0 || intersectionSize == 0){
         jacardIndex = 0;
     }
-    jacardIndex = (double)intersectionSize / (double)unionSize;
+    else{
+        jacardIndex = (double)intersectionSize / (double)unionSize;
+    }
     #ifdef DEBUG
         printf("GENRES: unionSize: %d, intersectionSize: %d; jacardIndex: %lf\n", unionSize, intersectionSize, jacardIndex);
     #endif
-    delete_genreLinkList(unionList);
-    delete_genreLinkList(intersectionList);
     return jacardIndex;
 }
 
@@ -220,7 +220,10 @@ GenreTable create_genresTable(GenreTable genresTable)
         genresTable->buckets[i] = create_empty_genreList(NULL);
         genresTable->genreCount = 0;
     }
+    genresTable->trigrams = NULL;
+    genresTable->completions = NULL;
     genresTable->modified = false;
+    init_table_lock(&genresTable->lock);
     return genresTable;
 }
 
@@ -252,6 +255,12 @@ GenrePosition insert_genre(char* genre, GenreTable genresTable)
     GenrePosition position = insert_genreList_genre(genresTable->buckets[index], genre);
     if (position != NULL) {
         genresTable->genreCount++;
+        if(genresTable->trigrams){
+            insert_trigramIndex_name(genresTable->trigrams, genresTable->trigrams->count, genre);
+        }
+        if(genresTable->completions){
+            insert_prefixTrie_name(genresTable->completions, genre, 0);
+        }
     }
     genresTable->modified = true;
     return position;
@@ -270,6 +279,12 @@ void delete_genresTable_genre(char* genre, GenreTable genresTable)
         print_error(301, NULL, NULL);
         return;
     }
+    if(genresTable->trigrams){
+        remove_trigramIndex_name(genresTable->trigrams, find_trigramIndex_name(genresTable->trigrams, genre));
+    }
+    if(genresTable->completions){
+        remove_prefixTrie_name(genresTable->completions, genre);
+    }
     delete_genreList_genre(position, genresTable->buckets[index]);
     genresTable->genreCount--;
     genresTable->modified = true;
@@ -284,6 +299,9 @@ void delete_genresTable(GenreTable genresTable)
     for (int i = 0; i < GENRE_TABLE_SIZE; i++) {
         delete_genreList(genresTable->buckets[i]);
     }
+    delete_trigramIndex(genresTable->trigrams);
+    delete_prefixTrie(genresTable->completions);
+    pthread_rwlock_destroy(&genresTable->lock);
     free(genresTable);
 }
 
@@ -302,27 +320,34 @@ GenrePosition find_genresTable_genre(char* genre, GenreTable genresTable)
 /**
  * @brief Funcion para guardar una tabla de generos musicales en su archivo JSON correspondiente
  *
- * @param bandTable Tabla de generos a guardar
+ * Igual que `save_bandTable`, se escribe un archivo temporal que luego reemplaza al original con rename.
+ *
+ * @param genresTable Tabla de generos a guardar
+ * @return TRUE si el archivo se reemplazo, FALSE si no se pudo escribir
 */
-void save_genresTable(GenreTable bandTable)
+bool save_genresTable(GenreTable genresTable)
 {
-    FILE* genresTableFile = fopen("./build/genres.json", "w");
+    FILE* genresTableFile = fopen(GENRES_FILE".tmp", "w");
     if (genresTableFile == NULL)
     {
-        print_error(100, "./build/genres.json", NULL);
-        return;
+        print_error(100, GENRES_FILE".tmp", NULL);
+        return false;
     }
 
+    bool first = true;
     fprintf(genresTableFile, "[\n");
-    for(int i=0; i<BANDS_TABLE_SIZE; i++)
+    for(int i=0; i<GENRE_TABLE_SIZE; i++)
     {
-        if(!bandTable->buckets[i]->next){
+        if(!genresTable->buckets[i]->next){
             continue;
         }
-        if(i != 0){
+        if(!first){
             fprintf(genresTableFile, ",\n");
         }
-        GenrePosition aux = bandTable->buckets[i]->next;
+        else{
+            first = false;
+        }
+        GenrePosition aux = genresTable->buckets[i]->next;
         while(aux != NULL){
             fprintf(genresTableFile, "\t{\n\t\t\"genre\":\"%s\",\n\t\t\"comments\":[", aux->genre);
             if(aux->comments->next){
@@ -343,7 +368,13 @@ void save_genresTable(GenreTable bandTable)
         }
     }
     fprintf(genresTableFile, "\n]");
-    fclose(genresTableFile);
+    bool written = !ferror(genresTableFile);
+    if(fclose(genresTableFile) != 0 || !written || rename(GENRES_FILE".tmp", GENRES_FILE) != 0){
+        print_error(100, GENRES_FILE, NULL);
+        remove(GENRES_FILE".tmp");
+        return false;
+    }
+    return true;
 }
 
 // Funciones de LoopWeb relacionadas a geberos
@@ -378,4 +409,46 @@ GenreLinkList get_loopweb_genres(GenreTable table)
     }
     printf("\n\n");
     return allGenres;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Obtiene el indice de trigramas de los nombres de las generos, construyendolo si aun no existe
+ *
+ * @param genresTable Tabla de generos
+ * @return Indice de trigramas de la tabla
+*/
+TrigramIndex get_genresTable_trigrams(GenreTable genresTable)
+{
+    if(genresTable->trigrams == NULL){
+        genresTable->trigrams = create_trigramIndex(genresTable->genreCount);
+        for(int i=0; i<GENRE_TABLE_SIZE; i++){
+            for(GenrePosition aux = genresTable->buckets[i]->next; aux != NULL; aux = aux->next){
+                insert_trigramIndex_name(genresTable->trigrams, genresTable->trigrams->count, aux->genre);
+            }
+        }
+    }
+    return genresTable->trigrams;
+}
+
+/**
+ * @brief Obtiene el trie de los nombres de las generos, pesados por su cantidad de publicaciones, construyendolo si aun no existe
+ *
+ * @param genresTable Tabla de generos
+ * @return Trie de la tabla
+*/
+PrefixTrie get_genresTable_completions(GenreTable genresTable)
+{
+    if(genresTable->completions == NULL){
+        genresTable->completions = create_prefixTrie();
+        for(int i=0; i<GENRE_TABLE_SIZE; i++){
+            for(GenrePosition aux = genresTable->buckets[i]->next; aux != NULL; aux = aux->next){
+                int publications = 0;
+                for(CommentLinkPosition comment = aux->comments->next; comment != NULL; comment = comment->next){
+                    publications++;
+                }
+                insert_prefixTrie_name(genresTable->completions, aux->genre, publications);
+            }
+        }
+    }
+    return genresTable->completions;
+}
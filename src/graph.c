@@ -0,0 +1,658 @@
+/**
+ * @file graph.c
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Grafo de amistades sobre IDs densos de usuarios y estructuras auxiliares para recorrerlo
+*/
+#include "graph.h"
+
+// Funciones del grafo de amistades
+
+/**
+ * @brief Crea un grafo de amistades vacio
+ *
+ * @param nodeCapacity Cantidad de nodos (IDs) a reservar inicialmente
+ * @return Puntero al grafo creado
+*/
+FriendGraph create_friendGraph(int nodeCapacity)
+{
+    FriendGraph graph = (FriendGraph)malloc(sizeof(struct _friendGraph));
+    if(graph == NULL){
+        print_error(200, NULL, NULL);
+    }
+    graph->nodeCount = 0;
+    graph->nodeCapacity = 0;
+    graph->edgeCount = 0;
+    graph->adjacency = NULL;
+    graph->degree = NULL;
+    graph->capacity = NULL;
+    if(nodeCapacity > 0){
+        ensure_friendGraph_node(graph, nodeCapacity - 1);
+    }
+    return graph;
+}
+
+/**
+ * @brief Borra un grafo de amistades
+ *
+ * @param graph Grafo a borrar
+*/
+void delete_friendGraph(FriendGraph graph)
+{
+    if(graph == NULL){
+        return;
+    }
+    for(int i=0; i<graph->nodeCount; i++){
+        free(graph->adjacency[i]);
+    }
+    free(graph->adjacency);
+    free(graph->degree);
+    free(graph->capacity);
+    free(graph);
+}
+
+/**
+ * @brief Asegura que el grafo tenga un nodo para el ID indicado (y todos los anteriores)
+ *
+ * @param graph Grafo a agrandar
+ * @param ID ID que debe existir en el grafo
+*/
+void ensure_friendGraph_node(FriendGraph graph, int ID)
+{
+    if(ID < graph->nodeCount){
+        return;
+    }
+    if(ID >= graph->nodeCapacity){
+        int newCapacity = graph->nodeCapacity ? graph->nodeCapacity : 64;
+        while(newCapacity <= ID){
+            newCapacity *= 2;
+        }
+        graph->adjacency = (int**)realloc(graph->adjacency, sizeof(int*) * newCapacity);
+        graph->degree = (int*)realloc(graph->degree, sizeof(int) * newCapacity);
+        graph->capacity = (int*)realloc(graph->capacity, sizeof(int) * newCapacity);
+        if(!graph->adjacency || !graph->degree || !graph->capacity){
+            print_error(200, NULL, NULL);
+        }
+        graph->nodeCapacity = newCapacity;
+    }
+    for(int i=graph->nodeCount; i<=ID; i++){
+        graph->adjacency[i] = NULL;
+        graph->degree[i] = 0;
+        graph->capacity[i] = 0;
+    }
+    graph->nodeCount = ID + 1;
+}
+
+/**
+ * @brief Busca la posicion de un vecino en la lista de adyacencia de un nodo (busqueda binaria)
+ *
+ * @param graph Grafo de amistades
+ * @param from Nodo cuya lista se recorre
+ * @param to Vecino a buscar
+ * @return Posicion del primer vecino mayor o igual a @p to
+*/
+int find_friendGraph_position(FriendGraph graph, int from, int to)
+{
+    int low = 0, high = graph->degree[from];
+    int* neighbors = graph->adjacency[from];
+    while(low < high){
+        int mid = low + (high - low)/2;
+        if(neighbors[mid] < to){
+            low = mid + 1;
+        }
+        else{
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/**
+ * @brief Indica si existe la arista @p from -> @p to
+ *
+ * @param graph Grafo de amistades
+ * @param from Nodo de origen
+ * @param to Nodo de destino
+ * @return TRUE si @p to es amigo de @p from, FALSE en caso contrario
+*/
+bool has_friendGraph_edge(FriendGraph graph, int from, int to)
+{
+    if(from < 0 || from >= graph->nodeCount){
+        return false;
+    }
+    int position = find_friendGraph_position(graph, from, to);
+    return position < graph->degree[from] && graph->adjacency[from][position] == to;
+}
+
+/**
+ * @brief Agrega la arista @p from -> @p to manteniendo ordenada la lista de adyacencia
+ *
+ * @param graph Grafo de amistades
+ * @param from Nodo de origen
+ * @param to Nodo de destino
+ * @return TRUE si la arista se agrego, FALSE si ya existia
+*/
+bool add_friendGraph_edge(FriendGraph graph, int from, int to)
+{
+    if(from < 0 || to < 0){
+        return false;
+    }
+    ensure_friendGraph_node(graph, from > to ? from : to);
+    int position = find_friendGraph_position(graph, from, to);
+    if(position < graph->degree[from] && graph->adjacency[from][position] == to){
+        return false;
+    }
+    if(graph->degree[from] == graph->capacity[from]){
+        int newCapacity = graph->capacity[from] ? 2*graph->capacity[from] : 4;
+        int* newNeighbors = (int*)realloc(graph->adjacency[from], sizeof(int) * newCapacity);
+        if(newNeighbors == NULL){
+            print_error(200, NULL, NULL);
+        }
+        graph->adjacency[from] = newNeighbors;
+        graph->capacity[from] = newCapacity;
+    }
+    int* neighbors = graph->adjacency[from];
+    memmove(&neighbors[position + 1], &neighbors[position], sizeof(int) * (graph->degree[from] - position));
+    neighbors[position] = to;
+    graph->degree[from]++;
+    graph->edgeCount++;
+    return true;
+}
+
+/**
+ * @brief Obtiene la cantidad de amigos de un usuario
+ *
+ * @param graph Grafo de amistades
+ * @param ID ID del usuario
+ * @return Grado del nodo (0 si el ID no esta en el grafo)
+*/
+int friendGraph_degree(FriendGraph graph, int ID)
+{
+    if(ID < 0 || ID >= graph->nodeCount){
+        return 0;
+    }
+    return graph->degree[ID];
+}
+
+/**
+ * @brief Obtiene los IDs de los amigos de un usuario
+ *
+ * @param graph Grafo de amistades
+ * @param ID ID del usuario
+ * @return Arreglo ordenado de IDs (de largo friendGraph_degree), NULL si no tiene amigos
+*/
+int* friendGraph_neighbors(FriendGraph graph, int ID)
+{
+    if(ID < 0 || ID >= graph->nodeCount){
+        return NULL;
+    }
+    return graph->adjacency[ID];
+}
+
+/**
+ * @brief Funcion de comparacion de IDs para qsort
+ *
+ * @param a Puntero al primer ID
+ * @param b Puntero al segundo ID
+ * @return Negativo, cero o positivo segun el orden de los IDs
+*/
+int compare_ids(const void* a, const void* b)
+{
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Construye el grafo de amistades a partir de las listas de amigos de la tabla de usuarios
+ *
+ * @param table Tabla de usuarios
+ * @return Grafo de amistades construido
+ * @note Los enlaces de amistad quedan completados (apuntando a su nodo de usuario). Costo O(V + E log d)
+*/
+FriendGraph build_friendGraph(UserTable table)
+{
+    FriendGraph graph = create_friendGraph(table->idCount);
+    for(int ID=0; ID<table->idCount; ID++){
+        UserPosition userNode = table->usersByID[ID];
+        if(userNode == NULL || userNode->friends == NULL){
+            continue;
+        }
+        // Agregamos al final y ordenamos una sola vez
+        UserLinkPosition friend = userNode->friends->next;
+        while(friend != NULL){
+            if(friend->userNode || complete_userLinkList_node(friend, table)){
+                if(graph->degree[ID] == graph->capacity[ID]){
+                    int newCapacity = graph->capacity[ID] ? 2*graph->capacity[ID] : 4;
+                    graph->adjacency[ID] = (int*)realloc(graph->adjacency[ID], sizeof(int) * newCapacity);
+                    if(graph->adjacency[ID] == NULL){
+                        print_error(200, NULL, NULL);
+                    }
+                    graph->capacity[ID] = newCapacity;
+                }
+                graph->adjacency[ID][graph->degree[ID]++] = friend->userNode->ID;
+            }
+            friend = friend->next;
+        }
+        qsort(graph->adjacency[ID], graph->degree[ID], sizeof(int), compare_ids);
+
+        // Eliminamos amistades repetidas
+        int unique = 0;
+        for(int i=0; i<graph->degree[ID]; i++){
+            if(unique == 0 || graph->adjacency[ID][unique - 1] != graph->adjacency[ID][i]){
+                graph->adjacency[ID][unique++] = graph->adjacency[ID][i];
+            }
+        }
+        graph->degree[ID] = unique;
+        graph->edgeCount += unique;
+    }
+    return graph;
+}
+
+/**
+ * @brief Obtiene el grafo de amistades de una tabla de usuarios, construyendolo si aun no existe
+ *
+ * @param table Tabla de usuarios
+ * @return Grafo de amistades de la tabla
+*/
+FriendGraph get_friendGraph(UserTable table)
+{
+    if(table->graph == NULL){
+        table->graph = build_friendGraph(table);
+    }
+    return table->graph;
+}
+
+/**
+ * @brief Calcula las medidas de amigos en comun entre dos usuarios
+ *
+ * El indice de Adamic-Adar y el de asignacion de recursos dan mas peso a los amigos en comun que tienen pocos
+ * amigos, ya que un amigo con muchas amistades dice poco sobre la cercania de dos personas.
+ *
+ * @param graph Grafo de amistades
+ * @param from ID del primer usuario
+ * @param to ID del segundo usuario
+ * @return Medidas calculadas (en cero si no tienen amigos en comun)
+ * @note Solo lee el grafo, puede llamarse desde varios hilos mientras nadie agregue aristas
+*/
+GraphSignals friendGraph_signals(FriendGraph graph, int from, int to)
+{
+    GraphSignals signals = {0, 0, 0};
+    int sizeA = friendGraph_degree(graph, from), sizeB = friendGraph_degree(graph, to);
+    if(sizeA == 0 || sizeB == 0){
+        return signals;
+    }
+
+    // Los amigos en comun no pueden ser mas que los de la lista mas corta
+    int buffer[GRAPH_SIGNALS_BUFFER];
+    int* common = buffer;
+    int maxCommon = sizeA < sizeB ? sizeA : sizeB;
+    if(maxCommon > GRAPH_SIGNALS_BUFFER){
+        common = (int*)malloc(sizeof(int) * maxCommon);
+        if(common == NULL){
+            print_error(200, NULL, NULL);
+        }
+    }
+
+    signals.mutualFriends = intersect_sorted_ids(friendGraph_neighbors(graph, from), sizeA, friendGraph_neighbors(graph, to), sizeB, common);
+    for(int i=0; i<signals.mutualFriends; i++){
+        // Las amistades pueden ser de un solo sentido (en users.json Ivan tiene a Abby, pero no al reves), por lo que un
+        // amigo en comun puede tener 0 o 1 amigos propios; se cuenta como si tuviera 2 para no dividir por log(1) = 0
+        int degree = friendGraph_degree(graph, common[i]);
+        if(degree < 2){
+            degree = 2;
+        }
+        signals.adamicAdar += 1.0 / log(degree);
+        signals.resourceAllocation += 1.0 / degree;
+    }
+
+    if(common != buffer){
+        free(common);
+    }
+    return signals;
+}
+
+// Funciones de interseccion de listas ordenadas de IDs
+
+/**
+ * @brief Intersecta dos listas ordenadas de IDs sin repetidos con un merge elemento a elemento
+ *
+ * @param a Primera lista
+ * @param sizeA Largo de la primera lista
+ * @param b Segunda lista
+ * @param sizeB Largo de la segunda lista
+ * @param out Arreglo donde se escriben los IDs en comun (con espacio para el largo menor), NULL para solo contarlos
+ * @return Cantidad de IDs en comun
+*/
+int intersect_sorted_ids_scalar(const int* a, int sizeA, const int* b, int sizeB, int* out)
+{
+    int i = 0, j = 0, count = 0;
+    while(i < sizeA && j < sizeB){
+        if(a[i] < b[j]){
+            i++;
+        }
+        else if(a[i] > b[j]){
+            j++;
+        }
+        else{
+            if(out){
+                out[count] = a[i];
+            }
+            count++;
+            i++;
+            j++;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Intersecta dos listas ordenadas de IDs sin repetidos
+ *
+ * Con SSE2 se comparan bloques de 4 IDs de cada lista a la vez: el bloque de @p b se rota 3 veces para comparar
+ * los 16 pares, y avanza el bloque cuyo ultimo ID es menor. Los elementos que sobran se intersectan con
+ * `intersect_sorted_ids_scalar`, que tambien se usa completa si SSE2 no esta disponible.
+ *
+ * @param a Primera lista
+ * @param sizeA Largo de la primera lista
+ * @param b Segunda lista
+ * @param sizeB Largo de la segunda lista
+ * @param out Arreglo donde se escriben los IDs en comun (con espacio para el largo menor), NULL para solo contarlos
+ * @return Cantidad de IDs en comun
+*/
+int intersect_sorted_ids(const int* a, int sizeA, const int* b, int sizeB, int* out)
+{
+    int i = 0, j = 0, count = 0;
+#ifdef __SSE2__
+    while(i + 4 <= sizeA && j + 4 <= sizeB){
+        __m128i blockA = _mm_loadu_si128((const __m128i*)&a[i]);
+        __m128i blockB = _mm_loadu_si128((const __m128i*)&b[j]);
+        __m128i matches = _mm_cmpeq_epi32(blockA, blockB);
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi32(blockA, _mm_shuffle_epi32(blockB, _MM_SHUFFLE(0, 3, 2, 1))));
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi32(blockA, _mm_shuffle_epi32(blockB, _MM_SHUFFLE(1, 0, 3, 2))));
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi32(blockA, _mm_shuffle_epi32(blockB, _MM_SHUFFLE(2, 1, 0, 3))));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(matches)); // Un bit por cada ID de a que esta en el bloque de b
+
+        // Los IDs en comun se escriben en orden
+        for(int lane = 0; lane < 4; lane++){
+            if(mask & (1 << lane)){
+                if(out){
+                    out[count] = a[i + lane];
+                }
+                count++;
+            }
+        }
+
+        int lastA = a[i + 3], lastB = b[j + 3];
+        if(lastA <= lastB){
+            i += 4;
+        }
+        if(lastB <= lastA){
+            j += 4;
+        }
+    }
+#endif
+    return count + intersect_sorted_ids_scalar(&a[i], sizeA - i, &b[j], sizeB - j, out ? &out[count] : NULL);
+}
+
+// Funciones de busqueda de caminos
+
+/**
+ * @brief Crea la memoria para buscar caminos entre usuarios
+ *
+ * @param capacity Cantidad de IDs a reservar inicialmente (crece si es necesario)
+ * @return Puntero a la busqueda creada
+*/
+GraphSearch create_graphSearch(int capacity)
+{
+    GraphSearch search = (GraphSearch)malloc(sizeof(struct _graphSearch));
+    if(search == NULL){
+        print_error(200, NULL, NULL);
+    }
+    for(int side=0; side<2; side++){
+        search->sides[side].stamp = NULL;
+        search->sides[side].parent = NULL;
+        search->sides[side].frontier = NULL;
+        search->sides[side].next = NULL;
+        search->sides[side].frontierSize = 0;
+    }
+    search->generation = 0;
+    search->capacity = 0;
+    ensure_graphSearch_capacity(search, capacity);
+    return search;
+}
+
+/**
+ * @brief Borra la memoria de busqueda de caminos
+ *
+ * @param search Busqueda a borrar
+*/
+void delete_graphSearch(GraphSearch search)
+{
+    if(search == NULL){
+        return;
+    }
+    for(int side=0; side<2; side++){
+        free(search->sides[side].stamp);
+        free(search->sides[side].parent);
+        free(search->sides[side].frontier);
+        free(search->sides[side].next);
+    }
+    free(search);
+}
+
+/**
+ * @brief Asegura que la busqueda tenga espacio para los IDs indicados
+ *
+ * @param search Busqueda a agrandar
+ * @param capacity Cantidad de IDs que deben caber
+*/
+void ensure_graphSearch_capacity(GraphSearch search, int capacity)
+{
+    if(capacity <= search->capacity){
+        return;
+    }
+    for(int side=0; side<2; side++){
+        SearchSide* aux = &search->sides[side];
+        aux->stamp = (unsigned int*)realloc(aux->stamp, sizeof(unsigned int) * capacity);
+        aux->parent = (int*)realloc(aux->parent, sizeof(int) * capacity);
+        aux->frontier = (int*)realloc(aux->frontier, sizeof(int) * capacity);
+        aux->next = (int*)realloc(aux->next, sizeof(int) * capacity);
+        if(aux->stamp == NULL || aux->parent == NULL || aux->frontier == NULL || aux->next == NULL){
+            print_error(200, NULL, NULL);
+        }
+        // Los IDs nuevos quedan como no visitados en toda generacion futura
+        memset(&aux->stamp[search->capacity], 0, sizeof(unsigned int) * (capacity - search->capacity));
+    }
+    search->capacity = capacity;
+}
+
+/**
+ * @brief Expande un nivel completo de uno de los lados de la busqueda
+ *
+ * @param search Busqueda en curso
+ * @param graph Grafo de amistades
+ * @param side Lado a expandir (0 o 1)
+ * @return ID en que ambos lados se encontraron, -1 si aun no se encuentran
+*/
+int expand_searchSide(GraphSearch search, FriendGraph graph, int side)
+{
+    SearchSide* own = &search->sides[side];
+    SearchSide* other = &search->sides[1 - side];
+    int nextSize = 0;
+
+    for(int i=0; i<own->frontierSize; i++){
+        int current = own->frontier[i];
+        int degree = friendGraph_degree(graph, current);
+        int* neighbors = friendGraph_neighbors(graph, current);
+        for(int j=0; j<degree; j++){
+            int neighbor = neighbors[j];
+            // Solo amistades mutuas: asi ambos lados recorren el mismo grafo no dirigido
+            if(own->stamp[neighbor] == search->generation || !has_friendGraph_edge(graph, neighbor, current)){
+                continue;
+            }
+            own->stamp[neighbor] = search->generation;
+            own->parent[neighbor] = current;
+            // Al expandir por niveles, el primer encuentro ya da un camino minimo
+            if(other->stamp[neighbor] == search->generation){
+                return neighbor;
+            }
+            own->next[nextSize++] = neighbor;
+        }
+    }
+
+    int* aux = own->frontier;
+    own->frontier = own->next;
+    own->next = aux;
+    own->frontierSize = nextSize;
+    return -1;
+}
+
+/**
+ * @brief Busca el camino de amistades mas corto entre dos usuarios con una busqueda en anchura bidireccional
+ *
+ * Se avanza un nivel a la vez desde el lado con la frontera mas pequeña, por lo que se exploran del orden de
+ * la raiz cuadrada de los usuarios que exploraria una busqueda desde un solo lado. Solo se siguen amistades
+ * presentes en las listas de ambos usuarios y no se carga ningun perfil.
+ *
+ * @param search Memoria de busqueda (del llamador, reutilizable entre busquedas)
+ * @param table Tabla de usuarios
+ * @param from ID del usuario de origen
+ * @param to ID del usuario de destino
+ * @param maxDepth Grados de separacion maximos a buscar
+ * @return Lista con los usuarios del camino (de @p from a @p to), NULL si no estan conectados a esa distancia
+*/
+UserLinkList find_friendship_path(GraphSearch search, UserTable table, int from, int to, int maxDepth)
+{
+    FriendGraph graph = get_friendGraph(table);
+    ensure_graphSearch_capacity(search, table->idCount > graph->nodeCount ? table->idCount : graph->nodeCount);
+    search->generation++;
+    if(search->generation == 0){ // La generacion dio la vuelta, limpiamos las marcas viejas
+        for(int side=0; side<2; side++){
+            memset(search->sides[side].stamp, 0, sizeof(unsigned int) * search->capacity);
+        }
+        search->generation = 1;
+    }
+
+    int ends[2] = {from, to};
+    for(int side=0; side<2; side++){
+        search->sides[side].stamp[ends[side]] = search->generation;
+        search->sides[side].parent[ends[side]] = -1;
+        search->sides[side].frontier[0] = ends[side];
+        search->sides[side].frontierSize = 1;
+    }
+
+    int meeting = from == to ? from : -1;
+    for(int depth = 0; meeting < 0 && depth < maxDepth; depth++){
+        if(search->sides[0].frontierSize == 0 || search->sides[1].frontierSize == 0){
+            break;
+        }
+        int side = search->sides[0].frontierSize <= search->sides[1].frontierSize ? 0 : 1;
+        meeting = expand_searchSide(search, graph, side);
+    }
+    if(meeting < 0){
+        return NULL;
+    }
+
+    // Armamos el camino: de from al encuentro (al reves) y del encuentro a to
+    UserLinkList path = create_empty_userLinkList(NULL);
+    for(int ID = meeting; ID >= 0; ID = search->sides[0].parent[ID]){
+        insert_userLinkList_node_completeInfo(path, table->usersByID[ID]);
+    }
+    UserLinkPosition last = userLinkList_last(path);
+    for(int ID = search->sides[1].parent[meeting]; ID >= 0; ID = search->sides[1].parent[ID]){
+        last = insert_userLinkList_node_completeInfo(last, table->usersByID[ID]);
+    }
+    return path;
+}
+
+// Funciones de la cola circular de IDs
+
+/**
+ * @brief Crea una cola circular de IDs
+ *
+ * @param capacity Capacidad inicial de la cola (crece si es necesario)
+ * @return Puntero a la cola creada
+*/
+IDQueue create_idQueue(int capacity)
+{
+    IDQueue queue = (IDQueue)malloc(sizeof(struct _idQueue));
+    if(queue == NULL){
+        print_error(200, NULL, NULL);
+    }
+    queue->capacity = capacity > 0 ? capacity : 16;
+    queue->items = (int*)malloc(sizeof(int) * queue->capacity);
+    if(queue->items == NULL){
+        print_error(200, NULL, NULL);
+    }
+    queue->head = 0;
+    queue->count = 0;
+    return queue;
+}
+
+/**
+ * @brief Borra una cola circular de IDs
+ *
+ * @param queue Cola a borrar
+*/
+void delete_idQueue(IDQueue queue)
+{
+    if(queue == NULL){
+        return;
+    }
+    free(queue->items);
+    free(queue);
+}
+
+/**
+ * @brief Indica si una cola esta vacia
+ *
+ * @param queue Cola a consultar
+ * @return TRUE si la cola esta vacia, FALSE en caso contrario
+*/
+bool is_empty_idQueue(IDQueue queue)
+{
+    return queue->count == 0;
+}
+
+/**
+ * @brief Agrega un ID al final de la cola
+ *
+ * @param queue Cola donde agregar
+ * @param ID ID a agregar
+*/
+void enqueue_idQueue(IDQueue queue, int ID)
+{
+    if(queue->count == queue->capacity){
+        // Duplicamos la capacidad dejando los elementos en orden desde la posicion 0
+        int newCapacity = 2*queue->capacity;
+        int* newItems = (int*)malloc(sizeof(int) * newCapacity);
+        if(newItems == NULL){
+            print_error(200, NULL, NULL);
+        }
+        for(int i=0; i<queue->count; i++){
+            newItems[i] = queue->items[(queue->head + i) % queue->capacity];
+        }
+        free(queue->items);
+        queue->items = newItems;
+        queue->head = 0;
+        queue->capacity = newCapacity;
+    }
+    queue->items[(queue->head + queue->count) % queue->capacity] = ID;
+    queue->count++;
+}
+
+/**
+ * @brief Saca el primer ID de la cola
+ *
+ * @param queue Cola de donde sacar
+ * @return ID extraido, -1 si la cola esta vacia
+*/
+int dequeue_idQueue(IDQueue queue)
+{
+    if(queue->count == 0){
+        return -1;
+    }
+    int ID = queue->items[queue->head];
+    queue->head = (queue->head + 1) % queue->capacity;
+    queue->count--;
+    return ID;
+}
@@ -71,3 +71,15 @@ unsigned int hashFile(char *filename) {
 
     return hash;
 }
+
+/**
+ * @brief Mezcla los bits de un entero de 64 bits (finalizador de splitmix64)
+ * @param x Valor a mezclar
+ * @return Valor mezclado: cambiar un bit de @p x cambia en promedio la mitad de los bits del resultado
+*/
+uint64_t mix_hash(uint64_t x)
+{
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
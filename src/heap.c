@@ -0,0 +1,151 @@
+/**
+ * @file heap.c
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Heap acotado de puntajes para seleccionar los K mejores elementos de una coleccion
+*/
+#include "heap.h"
+
+/**
+ * @brief Intercambia dos elementos del heap
+ *
+ * @param a Primer elemento
+ * @param b Segundo elemento
+*/
+void swap_scoreHeap_entries(ScoreHeapEntry* a, ScoreHeapEntry* b)
+{
+    ScoreHeapEntry aux = *a;
+    *a = *b;
+    *b = aux;
+}
+
+/**
+ * @brief Hunde un elemento del heap hasta restaurar la propiedad de min-heap
+ *
+ * @param entries Arreglo de elementos
+ * @param size Cantidad de elementos validos del arreglo
+ * @param i Posicion del elemento a hundir
+*/
+void sift_down_scoreHeap(ScoreHeapEntry* entries, int size, int i)
+{
+    while(2*i + 1 < size){
+        int child = 2*i + 1;
+        if(child + 1 < size && entries[child + 1].score < entries[child].score){
+            child++;
+        }
+        if(entries[i].score <= entries[child].score){
+            return;
+        }
+        swap_scoreHeap_entries(&entries[i], &entries[child]);
+        i = child;
+    }
+}
+
+/**
+ * @brief Crea un heap acotado de puntajes
+ *
+ * @param capacity Cantidad maxima de elementos que conservara el heap (K)
+ * @return Puntero al heap creado
+*/
+ScoreHeap create_scoreHeap(int capacity)
+{
+    if(capacity < 1){
+        capacity = 1;
+    }
+    ScoreHeap heap = (ScoreHeap)malloc(sizeof(struct _scoreHeap));
+    if(heap == NULL){
+        print_error(200, NULL, NULL);
+    }
+    heap->entries = (ScoreHeapEntry*)malloc(sizeof(ScoreHeapEntry) * capacity);
+    if(heap->entries == NULL){
+        print_error(200, NULL, NULL);
+    }
+    heap->size = 0;
+    heap->capacity = capacity;
+    return heap;
+}
+
+/**
+ * @brief Borra un heap de puntajes (los datos apuntados por los elementos no se liberan)
+ *
+ * @param heap Heap a borrar
+*/
+void delete_scoreHeap(ScoreHeap heap)
+{
+    if(heap == NULL){
+        return;
+    }
+    free(heap->entries);
+    free(heap);
+}
+
+/**
+ * @brief Indica si el heap ya contiene K elementos
+ *
+ * @param heap Heap a consultar
+ * @return TRUE si el heap esta lleno, FALSE en caso contrario
+*/
+bool is_full_scoreHeap(ScoreHeap heap)
+{
+    return heap->size >= heap->capacity;
+}
+
+/**
+ * @brief Obtiene el menor puntaje almacenado (el umbral para entrar al heap cuando esta lleno)
+ *
+ * @param heap Heap a consultar
+ * @return Menor puntaje del heap, 0 si el heap esta vacio
+*/
+double scoreHeap_min(ScoreHeap heap)
+{
+    if(heap->size == 0){
+        return 0;
+    }
+    return heap->entries[0].score;
+}
+
+/**
+ * @brief Ofrece un elemento al heap. Si el heap esta lleno solo se conserva si supera al menor puntaje
+ *
+ * @param heap Heap donde insertar
+ * @param score Puntaje del elemento
+ * @param data Elemento a insertar
+ * @return TRUE si el elemento quedo en el heap, FALSE si fue descartado
+ * @note Costo O(log K)
+*/
+bool push_scoreHeap(ScoreHeap heap, double score, void* data)
+{
+    if(heap->size < heap->capacity){
+        int i = heap->size++;
+        heap->entries[i].score = score;
+        heap->entries[i].data = data;
+        // Subimos el elemento hasta su posicion
+        while(i > 0 && heap->entries[(i - 1)/2].score > heap->entries[i].score){
+            swap_scoreHeap_entries(&heap->entries[(i - 1)/2], &heap->entries[i]);
+            i = (i - 1)/2;
+        }
+        return true;
+    }
+    if(score <= heap->entries[0].score){
+        return false;
+    }
+    heap->entries[0].score = score;
+    heap->entries[0].data = data;
+    sift_down_scoreHeap(heap->entries, heap->size, 0);
+    return true;
+}
+
+/**
+ * @brief Ordena los elementos del heap de mayor a menor puntaje (heapsort en el mismo arreglo)
+ *
+ * @param heap Heap a ordenar
+ * @return Cantidad de elementos ordenados en @p heap->entries
+ * @warning Luego de llamar a esta funcion el arreglo deja de ser un heap, solo debe recorrerse o borrarse
+*/
+int sort_scoreHeap(ScoreHeap heap)
+{
+    for(int last = heap->size - 1; last > 0; last--){
+        swap_scoreHeap_entries(&heap->entries[0], &heap->entries[last]);
+        sift_down_scoreHeap(heap->entries, last, 0);
+    }
+    return heap->size;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file hydration.c
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Candados para completar de forma perezosa los nodos leidos de disco desde varios hilos
+ *
+ * Los usuarios y comentarios se cargan sin su contenido y se completan desde su archivo la primera vez que se leen.
+ * Como esa lectura ocurre con la tabla tomada solo para lectura, dos hilos pueden intentar completar el mismo nodo:
+ * cada nodo tiene un indicador que se consulta con __atomic y, si aun no esta completo, se completa con el candado
+ * que le corresponde entre HYDRATION_STRIPES candados compartidos (uno por nodo ocuparia demasiada memoria).
+*/
+#include "hydration.h"
+
+pthread_mutex_t hydrationLocks[HYDRATION_STRIPES]; /**< Candados compartidos por todos los nodos */
+pthread_once_t hydrationOnce = PTHREAD_ONCE_INIT;  /**< Inicializa hydrationLocks una sola vez */
+
+// Funciones de los candados de completacion
+
+/**
+ * @brief Toma el candado con que se completa un nodo
+ *
+ * @param node Nodo a completar
+*/
+void lock_hydration(const void* node)
+{
+    pthread_mutex_lock(get_hydration_lock(node));
+}
+
+/**
+ * @brief Suelta el candado con que se completa un nodo
+ *
+ * @param node Nodo completado
+*/
+void unlock_hydration(const void* node)
+{
+    pthread_mutex_unlock(get_hydration_lock(node));
+}
+
+// Funciones de los candados de las tablas
+
+/**
+ * @brief Inicializa el candado de lectores y escritores de una tabla dando preferencia a los escritores
+ *
+ * Por defecto glibc prefiere a los lectores: un flujo constante de feeds y recomendaciones podria postergar para
+ * siempre una publicacion, una amistad o el guardado de las tablas.
+ *
+ * @param lock Candado a inicializar
+*/
+void init_table_lock(pthread_rwlock_t* lock)
+{
+    pthread_rwlockattr_t attributes;
+    pthread_rwlockattr_init(&attributes);
+    pthread_rwlockattr_setkind_np(&attributes, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+    pthread_rwlock_init(lock, &attributes);
+    pthread_rwlockattr_destroy(&attributes);
+}
+
+// Funciones auxiliares
+
+/**
+ * @brief Obtiene el candado que le corresponde a un nodo segun su direccion
+ *
+ * @param node Nodo
+ * @return Candado del nodo
+*/
+pthread_mutex_t* get_hydration_lock(const void* node)
+{
+    pthread_once(&hydrationOnce, init_hydration_locks);
+    uintptr_t address = (uintptr_t)node;
+    address ^= address >> 12; // Los nodos vienen de malloc: los bits bajos se repiten
+    return &hydrationLocks[(address >> 4) & (HYDRATION_STRIPES - 1)];
+}
+
+/**
+ * @brief Inicializa los candados compartidos (se llama una vez con pthread_once)
+*/
+void init_hydration_locks()
+{
+    for(int i=0; i<HYDRATION_STRIPES; i++){
+        pthread_mutex_init(&hydrationLocks[i], NULL);
+    }
+}
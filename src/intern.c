@@ -0,0 +1,156 @@
+/**
+ * @file intern.c
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Internado de cadenas: asigna IDs densos a nombres para operar sobre enteros en vez de strings
+*/
+#include "intern.h"
+
+/**
+ * @brief Crea una tabla de internado vacia
+ *
+ * @param table Tabla a vaciar, si es necesario
+ * @return Puntero a la tabla creada
+*/
+InternTable create_internTable(InternTable table)
+{
+    if(table != NULL){
+        delete_internTable(table);
+    }
+    table = (InternTable)malloc(sizeof(struct _internTable));
+    if(table == NULL){
+        print_error(200, NULL, NULL);
+    }
+    table->slotCapacity = INTERN_TABLE_SIZE;
+    table->slots = (int*)malloc(sizeof(int) * table->slotCapacity);
+    if(table->slots == NULL){
+        print_error(200, NULL, NULL);
+    }
+    for(int i=0; i<table->slotCapacity; i++){
+        table->slots[i] = -1;
+    }
+    table->names = NULL;
+    table->count = 0;
+    table->nameCapacity = 0;
+    return table;
+}
+
+/**
+ * @brief Borra una tabla de internado y todas sus cadenas
+ *
+ * @param table Tabla a borrar
+*/
+void delete_internTable(InternTable table)
+{
+    if(table == NULL){
+        return;
+    }
+    for(int i=0; i<table->count; i++){
+        free(table->names[i]);
+    }
+    free(table->names);
+    free(table->slots);
+    free(table);
+}
+
+/**
+ * @brief Busca la casilla donde esta (o donde deberia estar) una cadena
+ *
+ * @param table Tabla donde buscar
+ * @param name Cadena a buscar
+ * @return Indice de la casilla que contiene a @p name o de la primera casilla libre de su secuencia de sondeo
+*/
+int find_internTable_slot(InternTable table, char* name)
+{
+    unsigned int mask = table->slotCapacity - 1;
+    unsigned int slot = jenkins_hash(name) & mask;
+    while(table->slots[slot] != -1 && strcmp(table->names[table->slots[slot]], name) != 0){
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+/**
+ * @brief Duplica la cantidad de casillas de la tabla y reubica los IDs existentes
+ *
+ * @param table Tabla a agrandar
+*/
+void grow_internTable(InternTable table)
+{
+    free(table->slots);
+    table->slotCapacity *= 2;
+    table->slots = (int*)malloc(sizeof(int) * table->slotCapacity);
+    if(table->slots == NULL){
+        print_error(200, NULL, NULL);
+    }
+    for(int i=0; i<table->slotCapacity; i++){
+        table->slots[i] = -1;
+    }
+    for(int ID=0; ID<table->count; ID++){
+        table->slots[find_internTable_slot(table, table->names[ID])] = ID;
+    }
+}
+
+/**
+ * @brief Obtiene el ID de una cadena sin internarla
+ *
+ * @param table Tabla donde buscar
+ * @param name Cadena a buscar
+ * @return ID de la cadena, -1 si no ha sido internada
+*/
+int find_internTable_ID(InternTable table, char* name)
+{
+    return table->slots[find_internTable_slot(table, name)];
+}
+
+/**
+ * @brief Obtiene el ID de una cadena, internandola si no existia
+ *
+ * @param table Tabla donde internar
+ * @param name Cadena a internar
+ * @return ID denso de la cadena
+*/
+int intern_string(InternTable table, char* name)
+{
+    int slot = find_internTable_slot(table, name);
+    if(table->slots[slot] != -1){
+        return table->slots[slot];
+    }
+
+    if(table->count == table->nameCapacity){
+        int newCapacity = table->nameCapacity ? 2*table->nameCapacity : INTERN_TABLE_SIZE;
+        char** newNames = (char**)realloc(table->names, sizeof(char*) * newCapacity);
+        if(newNames == NULL){
+            print_error(200, NULL, NULL);
+        }
+        table->names = newNames;
+        table->nameCapacity = newCapacity;
+    }
+    int ID = table->count++;
+    table->names[ID] = (char*)malloc(strlen(name) + 1);
+    if(table->names[ID] == NULL){
+        print_error(200, NULL, NULL);
+    }
+    strcpy(table->names[ID], name);
+    table->slots[slot] = ID;
+
+    // Mantenemos el factor de carga bajo 1/2 para que el sondeo sea corto
+    if(2*table->count > table->slotCapacity){
+        grow_internTable(table);
+    }
+    return ID;
+}
+
+/**
+ * @brief Obtiene la cadena asociada a un ID
+ *
+ * @param table Tabla a consultar
+ * @param ID ID de la cadena
+ * @return Cadena internada, NULL si el ID no existe
+*/
+char* get_interned_string(InternTable table, int ID)
+{
+    if(ID < 0 || ID >= table->count){
+        return NULL;
+    }
+    return table->names[ID];
+}
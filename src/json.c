@@ -33,6 +33,7 @@ UserTable get_users_from_file(const char *filePath, UserTable table)
     }
 
     size_t total_users  = json_array_size(json);  // Tamano total de usuarios basado en el arreglo json
+    bool modified = table->modified; // Leer la tabla no la modifica, salvo que haya que migrarla
 
     // Leemos y procesamos cada uno de los usuarios
     for (size_t i = 0; i < total_users; i++) {
@@ -42,9 +43,40 @@ UserTable get_users_from_file(const char *filePath, UserTable table)
         const char *userName = json_string_value(json_object_get(user_json, "userName")); // almacena el nombre del usuario[i]
         json_t *friends_json = json_object_get(user_json, "friends"); // almacena los amigos del usuario[i]
         UserLinkList friends = read_friends_json(friends_json);
-        insert_userTable_node(table, userName, 0, "NULL", "NULL", NULL, NULL, friends, NULL);
+
+        // Campos para filtrar y recomendar sin leer el perfil
+        json_t *age_json = json_object_get(user_json, "age");
+        const char *nationality = json_string_value(json_object_get(user_json, "nationality"));
+        json_t *genres_json = json_object_get(user_json, "genres");
+        json_t *bands_json = json_object_get(user_json, "bands");
+        UserPosition user = insert_userTable_node(table, userName, read_age_json(age_json), nationality ? nationality : "NULL", "NULL", NULL, NULL, friends, NULL);
+        if(user == NULL){
+            continue;
+        }
+        if(age_json == NULL || nationality == NULL || genres_json == NULL || bands_json == NULL){
+            // Tabla de una version anterior: se completa desde el perfil y se guarda con los campos nuevos
+            complete_user_from_json(user);
+            modified = true;
+            continue;
+        }
+        user->genreSet = create_bitmap(table->genreNames->count);
+        for(size_t j = 0; j < json_array_size(genres_json); j++){
+            const char *genre = json_string_value(json_array_get(genres_json, j));
+            if(genre){
+                set_bitmap_bit(user->genreSet, intern_string(table->genreNames, (char*)genre));
+            }
+        }
+        user->bandSet = create_bitmap(table->bandNames->count);
+        for(size_t j = 0; j < json_array_size(bands_json); j++){
+            const char *band = json_string_value(json_array_get(bands_json, j));
+            if(band){
+                set_bitmap_bit(user->bandSet, intern_string(table->bandNames, (char*)band));
+            }
+        }
     }
     json_decref(json); // libera la memoria utilizada por el json
+    add_userTable_friendships_version(table);
+    table->modified = modified;
 
     return table;
 }
@@ -52,6 +84,9 @@ UserTable get_users_from_file(const char *filePath, UserTable table)
 /**
  * @brief Funcion para completar un usuario leido desde un archivo json
  *
+ * Se puede llamar desde varios hilos a la vez: el usuario se completa una sola vez, con su candado de
+ * hydration.c tomado, y luego `hydrated` evita volver a tomarlo.
+ *
  * @param user Puntero al usuario a completar
  * @return Puntero al usuario completado
 */
@@ -61,7 +96,13 @@ UserPosition complete_user_from_json(UserPosition user)
         print_error(202, NULL, NULL);
     }
 
+    if(__atomic_load_n(&user->hydrated, __ATOMIC_ACQUIRE)){
+        return user;
+    }
+    lock_hydration(user);
     if(user->bands && user->friends && user->comments && user->genres && user->nationality && user->description){
+        __atomic_store_n(&user->hydrated, true, __ATOMIC_RELEASE);
+        unlock_hydration(user);
         return user;
     }
 
@@ -71,6 +112,7 @@ UserPosition complete_user_from_json(UserPosition user)
     FILE *file = fopen(filePath, "r");  // Abre el archivo .json en modo lectura
     if (!file){
         print_error(100, (char*)filePath, NULL);
+        unlock_hydration(user);
         return user;
     }
     json_error_t error;     // declaracion de "variable" error basada en una funcion de la libreria jansson
@@ -78,9 +120,10 @@ UserPosition complete_user_from_json(UserPosition user)
     fclose(file);
     if (!json) {
         print_error(101, error.text, NULL);
+        unlock_hydration(user);
         return user;
     }
-    int age = (int)json_integer_value(json_object_get(json, "age")); // 0 si no existe
+    int age = read_age_json(json_object_get(json, "age"));
     const char *nationality = json_string_value(json_object_get(json, "nationality"));
     if(!nationality){
         nationality = "Empty";
@@ -100,6 +143,10 @@ UserPosition complete_user_from_json(UserPosition user)
     CommentLinkList comments = read_comments_json(comments_json);
 
     complete_userList_node(user, age, nationality, description, genres, bands, comments);
+    if(user->friends){
+        __atomic_store_n(&user->hydrated, true, __ATOMIC_RELEASE);
+    }
+    unlock_hydration(user);
 
     json_decref(json); // libera la memoria utilizada por el json
     return user;
@@ -108,6 +155,9 @@ UserPosition complete_user_from_json(UserPosition user)
 /**
  * @brief Funcion para completar un comentario leido desde un archivo json
  *
+ * Igual que `complete_user_from_json`, se puede llamar desde varios hilos: `complete` se consulta con __atomic y el
+ * comentario se lee con su candado de hydration.c tomado.
+ *
  * @param user Puntero al comentario a completar
  * @return Puntero al comentario completado
 */
@@ -117,12 +167,22 @@ CommentPosition complete_comment_from_json(CommentPosition comment)
         print_error(202, NULL, NULL);
     }
 
+    if(__atomic_load_n(&comment->complete, __ATOMIC_ACQUIRE)){ // El comentario ya fue leido (o creado en esta sesion)
+        return comment;
+    }
+    lock_hydration(comment);
+    if(comment->complete){ // Otro hilo lo completo mientras se esperaba el candado
+        unlock_hydration(comment);
+        return comment;
+    }
+
     // Crear estructura JSON
     char filePath[200];
     snprintf(filePath, 200, COMMENTS_PATH"%ld.json", comment->ID);
     FILE *file = fopen(filePath, "r");  // Abre el archivo .json en modo lectura
     if (!file){
         print_error(100, (char*)filePath, NULL);
+        unlock_hydration(comment);
         return comment;
     }
     json_error_t error;     // declaracion de "variable" error basada en una funcion de la libreria jansson
@@ -130,6 +190,7 @@ CommentPosition complete_comment_from_json(CommentPosition comment)
     fclose(file);
     if (!json) {
         print_error(101, error.text, NULL);
+        unlock_hydration(comment);
         return comment;
     }
     const char *text = json_string_value(json_object_get(json, "text")); // almacena el texto del comentario[i]
@@ -142,6 +203,7 @@ CommentPosition complete_comment_from_json(CommentPosition comment)
     }
 
     complete_commentList_node(comment, (char*)text, (char*)author);
+    unlock_hydration(comment);
 
     json_decref(json); // libera la memoria utilizada por el json
     return comment;
@@ -266,7 +328,8 @@ CommentTable get_comments_from_file(const char* filePath, CommentTable commentTa
 
     size_t total_comments = json_array_size(json);  // Tamano total de comentarios basado en el arreglo json
 
-    // Leemos y procesamos cada una de las bandas
+    // Leemos y procesamos cada uno de los comentarios (el indice cronologico se ordena una vez al final)
+    commentTable->recentLoading = true;
     for (size_t i = 0; i < total_comments; i++) {
         time_t comment = json_integer_value(json_array_get(json, i));  // obtener el valor comentario en el indice i del arreglo
         if (!comment) {
@@ -275,11 +338,32 @@ CommentTable get_comments_from_file(const char* filePath, CommentTable commentTa
         }
         insert_commentTable_comment(create_new_comment(comment, "NULL", "NULL"), commentTable);
     }
+    sort_recentIndex(commentTable);
     json_decref(json); // libera la memoria utilizada por el json
 
     return commentTable;
 }
 
+/**
+ * @brief Funcion para leer la edad de un usuario
+ *
+ * Las edades fuera de rango se descartan, ya que el indice de edades reserva una posicion por cada edad posible.
+ *
+ * @param age_json Puntero al entero json con la edad
+ * @return Edad leida, 0 si no existe o no es valida
+*/
+int read_age_json(json_t *age_json){
+    if(age_json == NULL){
+        return 0;
+    }
+    json_int_t age = json_integer_value(age_json);
+    if(age < 0 || age > USER_MAX_AGE){
+        print_error(302, NULL, "Edad no valida");
+        return 0;
+    }
+    return (int)age;
+}
+
 /**
  * @brief Funcion para leer el arreglo json de amigos y crear una lista de enlaces a usuarios
  *
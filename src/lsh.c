@@ -0,0 +1,344 @@
+/**
+ * @file lsh.c
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Firmas MinHash e indice LSH para encontrar usuarios con gustos parecidos sin compararlos a todos
+*/
+#include "lsh.h"
+
+// Funciones de las firmas MinHash
+
+/**
+ * @brief Funcion hash numero @p hashIndex de la familia MinHash
+ *
+ * @param key Elemento a dispersar
+ * @param hashIndex Indice de la funcion dentro de la familia (0 a LSH_HASHES-1)
+ * @return Valor hash del elemento
+*/
+unsigned int minhash_mix(unsigned int key, int hashIndex)
+{
+    unsigned int hash = key * 0x9E3779B1u + (unsigned int)(hashIndex + 1) * 0x85EBCA6Bu;
+    hash ^= hash >> 16;
+    hash *= 0x7FEB352Du;
+    hash ^= hash >> 15;
+    hash *= 0x846CA68Bu;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+/**
+ * @brief Calcula la firma MinHash de los gustos de un usuario
+ *
+ * Los generos y las bandas se tratan como un solo conjunto. Se dispersa el nombre de cada elemento (y no su ID
+ * internado) para que la firma no dependa del orden en que se cargaron los perfiles.
+ *
+ * @param user Usuario con sus conjuntos de gustos construidos
+ * @param table Tabla de usuarios, dueña de los IDs internados
+ * @param signature Arreglo de LSH_HASHES valores donde se escribe la firma
+ * @return TRUE si la firma es valida, FALSE si el usuario no tiene gustos
+*/
+bool compute_minhash_signature(UserPosition user, UserTable table, unsigned int* signature)
+{
+    Bitmap genres = user->genreSet;
+    Bitmap bands = user->bandSet;
+    if(genres->count == 0 && bands->count == 0){
+        return false;
+    }
+    for(int i=0; i<LSH_HASHES; i++){
+        signature[i] = ~0u;
+    }
+    for(int ID = next_bitmap_bit(genres, 0); ID != -1; ID = next_bitmap_bit(genres, ID + 1)){
+        unsigned int key = jenkins_hash(get_interned_string(table->genreNames, ID));
+        for(int i=0; i<LSH_HASHES; i++){
+            unsigned int hash = minhash_mix(key, i);
+            if(hash < signature[i]){
+                signature[i] = hash;
+            }
+        }
+    }
+    for(int ID = next_bitmap_bit(bands, 0); ID != -1; ID = next_bitmap_bit(bands, ID + 1)){
+        unsigned int key = jenkins_hash(get_interned_string(table->bandNames, ID)) ^ LSH_BAND_SALT;
+        for(int i=0; i<LSH_HASHES; i++){
+            unsigned int hash = minhash_mix(key, i);
+            if(hash < signature[i]){
+                signature[i] = hash;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Calcula el hash de una banda de una firma
+ *
+ * @param signature Firma MinHash
+ * @param band Banda de la firma
+ * @return Hash de la banda, su bucket son los bits bajos (ver bucketCount)
+*/
+unsigned int lsh_band_hash(const unsigned int* signature, int band)
+{
+    unsigned int hash = 0;
+    for(int r=0; r<LSH_ROWS; r++){
+        hash = minhash_mix(hash ^ signature[band*LSH_ROWS + r], r);
+    }
+    return hash;
+}
+
+// Funciones del indice de gustos
+
+/**
+ * @brief Crea un indice de gustos vacio
+ *
+ * @param capacity Cantidad de IDs para los que se reserva espacio inicialmente
+ * @return Puntero al indice creado
+*/
+TasteIndex create_tasteIndex(int capacity)
+{
+    TasteIndex index = (TasteIndex)malloc(sizeof(struct _tasteIndex));
+    if(index == NULL){
+        print_error(200, NULL, NULL);
+    }
+    index->capacity = capacity > 0 ? capacity : 64;
+    index->bucketCount = LSH_MIN_BUCKETS;
+    while(index->bucketCount < index->capacity){
+        index->bucketCount *= 2;
+    }
+    for(int b=0; b<LSH_BANDS; b++){
+        index->buckets[b] = create_lshBuckets(index->bucketCount);
+    }
+    index->indexedCount = 0;
+    index->signatures = (unsigned int*)malloc(sizeof(unsigned int) * LSH_HASHES * index->capacity);
+    if(index->signatures == NULL){
+        print_error(200, NULL, NULL);
+    }
+    index->indexed = create_bitmap(index->capacity);
+    return index;
+}
+
+/**
+ * @brief Borra un indice de gustos
+ *
+ * @param index Indice a borrar
+*/
+void delete_tasteIndex(TasteIndex index)
+{
+    if(index == NULL){
+        return;
+    }
+    for(int b=0; b<LSH_BANDS; b++){
+        delete_lshBuckets(index->buckets[b], index->bucketCount);
+    }
+    free(index->signatures);
+    delete_bitmap(index->indexed);
+    free(index);
+}
+
+/**
+ * @brief Crea los buckets vacios de una banda
+ *
+ * @param count Cantidad de buckets
+ * @return Arreglo de buckets
+*/
+LshBucket* create_lshBuckets(int count)
+{
+    LshBucket* buckets = (LshBucket*)calloc(count, sizeof(LshBucket));
+    if(buckets == NULL){
+        print_error(200, NULL, NULL);
+    }
+    return buckets;
+}
+
+/**
+ * @brief Borra los buckets de una banda
+ *
+ * @param buckets Arreglo de buckets
+ * @param count Cantidad de buckets
+*/
+void delete_lshBuckets(LshBucket* buckets, int count)
+{
+    for(int k=0; k<count; k++){
+        free(buckets[k].IDs);
+    }
+    free(buckets);
+}
+
+/**
+ * @brief Cambia la cantidad de buckets por banda y redistribuye a los usuarios indexados
+ *
+ * Las firmas ya estan guardadas, por lo que solo se recalcula el hash de cada banda.
+ *
+ * @param index Indice de gustos
+ * @param bucketCount Nueva cantidad de buckets por banda (potencia de 2)
+*/
+void resize_tasteIndex(TasteIndex index, int bucketCount)
+{
+    for(int b=0; b<LSH_BANDS; b++){
+        delete_lshBuckets(index->buckets[b], index->bucketCount);
+        index->buckets[b] = create_lshBuckets(bucketCount);
+    }
+    index->bucketCount = bucketCount;
+    for(int ID = next_bitmap_bit(index->indexed, 0); ID != -1; ID = next_bitmap_bit(index->indexed, ID + 1)){
+        unsigned int* signature = &index->signatures[(size_t)ID * LSH_HASHES];
+        for(int b=0; b<LSH_BANDS; b++){
+            insert_lshBucket_ID(&index->buckets[b][lsh_band_hash(signature, b) & (bucketCount - 1)], ID);
+        }
+    }
+}
+
+/**
+ * @brief Agrega un ID a un bucket
+ *
+ * @param bucket Bucket a modificar
+ * @param ID ID a agregar
+*/
+void insert_lshBucket_ID(LshBucket* bucket, int ID)
+{
+    if(bucket->count == bucket->capacity){
+        int newCapacity = bucket->capacity ? 2*bucket->capacity : 4;
+        int* newIDs = (int*)realloc(bucket->IDs, sizeof(int) * newCapacity);
+        if(newIDs == NULL){
+            print_error(200, NULL, NULL);
+        }
+        bucket->IDs = newIDs;
+        bucket->capacity = newCapacity;
+    }
+    bucket->IDs[bucket->count++] = ID;
+}
+
+/**
+ * @brief Quita un ID de un bucket (el orden de los IDs del bucket no se conserva)
+ *
+ * @param bucket Bucket a modificar
+ * @param ID ID a quitar
+*/
+void delete_lshBucket_ID(LshBucket* bucket, int ID)
+{
+    for(int i=0; i<bucket->count; i++){
+        if(bucket->IDs[i] == ID){
+            bucket->IDs[i] = bucket->IDs[--bucket->count];
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Quita a un usuario del indice
+ *
+ * @param index Indice de gustos
+ * @param ID ID del usuario
+*/
+void remove_tasteIndex_user(TasteIndex index, int ID)
+{
+    if(!unset_bitmap_bit(index->indexed, ID)){
+        return;
+    }
+    unsigned int* signature = &index->signatures[(size_t)ID * LSH_HASHES];
+    for(int b=0; b<LSH_BANDS; b++){
+        delete_lshBucket_ID(&index->buckets[b][lsh_band_hash(signature, b) & (index->bucketCount - 1)], ID);
+    }
+    index->indexedCount--;
+}
+
+/**
+ * @brief Inserta o actualiza la firma de un usuario en el indice
+ *
+ * @param index Indice de gustos
+ * @param user Usuario con sus conjuntos de gustos construidos
+ * @param table Tabla de usuarios
+ * @note Los usuarios sin gustos quedan fuera del indice (su firma no se parece a nada)
+*/
+void update_tasteIndex_user(TasteIndex index, UserPosition user, UserTable table)
+{
+    int ID = user->ID;
+    if(ID < 0){
+        return;
+    }
+    remove_tasteIndex_user(index, ID);
+
+    if(ID >= index->capacity){
+        int newCapacity = index->capacity;
+        while(ID >= newCapacity){
+            newCapacity *= 2;
+        }
+        unsigned int* newSignatures = (unsigned int*)realloc(index->signatures, sizeof(unsigned int) * LSH_HASHES * newCapacity);
+        if(newSignatures == NULL){
+            print_error(200, NULL, NULL);
+        }
+        index->signatures = newSignatures;
+        index->capacity = newCapacity;
+    }
+
+    unsigned int* signature = &index->signatures[(size_t)ID * LSH_HASHES];
+    if(!compute_minhash_signature(user, table, signature)){
+        return;
+    }
+    for(int b=0; b<LSH_BANDS; b++){
+        insert_lshBucket_ID(&index->buckets[b][lsh_band_hash(signature, b) & (index->bucketCount - 1)], ID);
+    }
+    set_bitmap_bit(index->indexed, ID);
+    if(++index->indexedCount > index->bucketCount){
+        resize_tasteIndex(index, 2*index->bucketCount);
+    }
+}
+
+/**
+ * @brief Busca usuarios con gustos parecidos a los de un usuario
+ *
+ * Solo se revisan los buckets del usuario, por lo que el costo depende del tamaño de esos buckets y no
+ * de la cantidad total de usuarios.
+ *
+ * @param index Indice de gustos
+ * @param ID ID del usuario
+ * @param candidates Bitmap donde se encienden los IDs de los usuarios parecidos (sin incluir a @p ID)
+ * @return Cantidad de candidatos nuevos encendidos en @p candidates
+*/
+int query_tasteIndex(TasteIndex index, int ID, Bitmap candidates)
+{
+    if(!test_bitmap_bit(index->indexed, ID)){
+        return 0;
+    }
+    int found = 0;
+    unsigned int* signature = &index->signatures[(size_t)ID * LSH_HASHES];
+    for(int b=0; b<LSH_BANDS; b++){
+        LshBucket* bucket = &index->buckets[b][lsh_band_hash(signature, b) & (index->bucketCount - 1)];
+        for(int i=0; i<bucket->count; i++){
+            int other = bucket->IDs[i];
+            // Descartamos los que solo comparten el bucket por colision y no la banda completa
+            if(other == ID || memcmp(&index->signatures[(size_t)other * LSH_HASHES + b*LSH_ROWS], &signature[b*LSH_ROWS], sizeof(unsigned int) * LSH_ROWS) != 0){
+                continue;
+            }
+            if(set_bitmap_bit(candidates, other)){
+                found++;
+            }
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief Obtiene el indice de gustos de una tabla de usuarios, construyendolo si aun no existe
+ *
+ * @param table Tabla de usuarios
+ * @return Indice de gustos de la tabla
+ * @note Los gustos de cada usuario se leen de users.json junto con la tabla, por lo que construirlo no abre ningun
+ * perfil; luego se mantiene al (re)construir los conjuntos de gustos de cada usuario en `complete_user_tasteSets`
+*/
+TasteIndex get_tasteIndex(UserTable table)
+{
+    if(table->tasteIndex != NULL){
+        return table->tasteIndex;
+    }
+    table->tasteIndex = create_tasteIndex(table->idCount);
+    for(int ID=0; ID<table->idCount; ID++){
+        UserPosition user = table->usersByID[ID];
+        if(user == NULL){
+            continue;
+        }
+        if(user->genreSet && user->bandSet){
+            update_tasteIndex_user(table->tasteIndex, user, table);
+        }
+        else{
+            complete_user_tasteSets(user, table); // Inserta al usuario en el indice (sus gustos ya estan en memoria)
+        }
+    }
+    return table->tasteIndex;
+}
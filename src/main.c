@@ -15,10 +15,24 @@
 #include "bands.h"
 #include "bandLink.h"
 #include "json.h"
+#include "recommendations.h"
+#include "popularity.h"
+#include "retag.h"
+#include "script.h"
+#include "server.h"
+#include "bench.h"
 #include "utilities.h"
 
 void admin_mode();
 void user_mode(char *user_name);
+void precompute_mode();
+void popular_mode(UserTable loopwebUsers);
+void retag_mode(UserTable loopwebUsers, BandTable loopwebBands, GenreTable loopwebGenres);
+void script_mode(const char* path);
+void serve_mode(const char* path);
+void client_mode(const char* path);
+void load_mode(const char* path);
+void bench_mode();
 
 int main(int argc, char* argv[])
 {
@@ -34,11 +48,17 @@ int main(int argc, char* argv[])
         {"help", no_argument, 0, 'h'},
         {"administrador", no_argument, 0, 'a'},
         {"user", required_argument, 0, 'u'},
+        {"precompute-recs", no_argument, 0, 'p'},
+        {"script", required_argument, 0, 's'},
+        {"serve", required_argument, 0, 'S'},
+        {"client", required_argument, 0, 'c'},
+        {"load", required_argument, 0, 'L'},
+        {"bench", no_argument, 0, 'b'},
         {0, 0, 0, 0} // Terminador
     };
 
     // Analizar opciones
-    if ((opt = getopt_long(argc, argv, "hau:", long_options, NULL)) != -1) {
+    if ((opt = getopt_long(argc, argv, "hau:ps:S:c:L:b", long_options, NULL)) != -1) {
         switch (opt) {
             case 'a': // Modo Admin
                 admin_mode();
@@ -46,6 +66,24 @@ int main(int argc, char* argv[])
             case 'u': // Modo usuario
                 user_mode(optarg);
                 break;
+            case 'p': // Precalculo de recomendaciones
+                precompute_mode();
+                break;
+            case 's': // Archivo de comandos
+                script_mode(optarg);
+                break;
+            case 'S': // Servidor residente
+                serve_mode(optarg);
+                break;
+            case 'c': // Cliente del servidor
+                client_mode(optarg);
+                break;
+            case 'L': // Generador de carga para el servidor
+                load_mode(optarg);
+                break;
+            case 'b': // Mediciones de rendimiento
+                bench_mode();
+                break;
             case '?': // Error
                 return 0;
                 break;
@@ -66,21 +104,23 @@ void admin_mode()
 {
     int terminate = 0;
     UserTable loopWebUsers = get_users_from_file(USERS_PATH"users.json", NULL);
-    UserLinkList allUsers;
-    BandTable loopwebBands = get_bands_from_file("./build/bands.json", NULL);
+    BandTable loopwebBands = get_bands_from_file(BANDS_FILE, NULL);
     BandLinkList allBands;
-    GenreTable loopwebGenres = get_genres_from_file("./build/genres.json", NULL);
+    GenreTable loopwebGenres = get_genres_from_file(GENRES_FILE, NULL);
     GenreLinkList allGenres;
 
     while(!terminate)
     {
         printf(CLEAR_SCREEN"\t\tUsted a ingresado como administrador\n");
         printf("Que desea hacer?\n");
-        printf("\t1. Listar todos los usuarios y ver un perfil\n");
+        printf("\t1. Buscar usuarios y ver un perfil\n");
         printf("\t2. Listar todas las bandas y artistas de la base de datos\n");
         printf("\t3. Listar todos los generos y artistas de la base de datos\n");
         printf("\t4. Crear un nuevo usuario\n");
-        printf("\t5. Salir\n");
+        printf("\t5. Calcular la popularidad de los usuarios\n");
+        printf("\t6. Filtrar usuarios por edad, nacionalidad y genero\n");
+        printf("\t7. Re-etiquetar todas las publicaciones\n");
+        printf("\t8. Salir\n");
         int option;
         do{
             printf("Opcion: ");
@@ -88,26 +128,11 @@ void admin_mode()
                 print_error(103, NULL, NULL);
                 continue;
             }
-        }while(option < 1 || option > 5);
+        }while(option < 1 || option > 8);
 
         switch(option){
-            case 1: // Listar todos los usuarios
-                allUsers = get_loopweb_users(loopWebUsers, true);
-                printf("Desea ver el perfil de un usuario? Ingrese el numero que aparece junto al usuario deseado (0 para salir): ");
-                if(scanf("%d", &option) != 1){
-                    print_error(103, NULL, NULL);
-                    continue;
-                }
-                if(option >= 1 && option <= loopWebUsers->userCount){
-                    UserLinkPosition aux = allUsers;
-                    for(int i=0; i<option; i++){
-                        aux = aux->next;
-                    }
-                    if(aux){
-                        print_user(aux->userNode);
-                    }
-                }
-                delete_userLinkList(allUsers);
+            case 1: // Buscar usuarios y ver un perfil
+                browse_users(loopWebUsers);
                 break;
             case 2: // Listar todas las bandas y artistas de la base de datos
                 allBands = get_loopweb_bands(loopwebBands);
@@ -120,7 +145,16 @@ void admin_mode()
             case 4: // Crear un nuevo usuario
                 create_user_profile(loopWebUsers, loopwebBands, loopwebGenres);
                 break;
-            case 5: // Salir
+            case 5: // Calcular la popularidad de los usuarios
+                popular_mode(loopWebUsers);
+                break;
+            case 6: // Filtrar usuarios por edad, nacionalidad y genero
+                filter_users_menu(loopWebUsers);
+                break;
+            case 7: // Reconstruir las publicaciones de cada banda y genero desde los textos
+                retag_mode(loopWebUsers, loopwebBands, loopwebGenres);
+                break;
+            case 8: // Salir
                 printf("Nos vemos pronto\n");
                 terminate = 1;
                 continue;
@@ -143,6 +177,8 @@ void admin_mode()
         save_genresTable(loopwebGenres);
     if(loopWebUsers->modified)
         save_userTable(loopWebUsers);
+    if(loopWebUsers->popularity && loopWebUsers->popularity->modified)
+        save_popularity(loopWebUsers->popularity, loopWebUsers);
 
     delete_bandTable(loopwebBands);
     delete_genresTable(loopwebGenres);
@@ -162,14 +198,20 @@ void user_mode(char *userName)
     UserPosition user = find_userTable_node(loopwebUsers, userName); // Comprobamos que el usuario exista
     if(!user){
         print_error(300, userName, NULL);
-        delete_userTable(loopwebUsers);
-        return;
+        user = suggest_user(loopwebUsers, userName);
+        if(!user){
+            delete_userTable(loopwebUsers);
+            return;
+        }
+        userName = user->username;
     }
-    BandTable loopwebBands = get_bands_from_file("./build/bands.json", NULL);
-    GenreTable loopwebGenres = get_genres_from_file("./build/genres.json", NULL);
+    BandTable loopwebBands = get_bands_from_file(BANDS_FILE, NULL);
+    GenreTable loopwebGenres = get_genres_from_file(GENRES_FILE, NULL);
     CommentTable loopwebComments = get_comments_from_file(COMMENTS_PATH"comments.json", NULL);
 
     UserLinkList possibleFriends;
+    GraphSearch search = NULL;
+    char targetName[200];
 
     while(!terminate)
     {
@@ -179,9 +221,15 @@ void user_mode(char *userName)
         printf("\t1. Ver perfiles de mis amigos\n");
         printf("\t2. Ver mi propio perfil\n");
         printf("\t3. Ver me feed de publicaciones\n");
-        printf("\t4. Realizar una publicacion\n");
-        printf("\t5. Ver mis recomendaciones de amigos\n");
-        printf("\t6. Salir\n");
+        printf("\t4. Ver mi feed por relevancia\n");
+        printf("\t5. Realizar una publicacion\n");
+        printf("\t6. Ver mis recomendaciones de amigos\n");
+        printf("\t7. Ver recomendaciones por recorridos aleatorios\n");
+        printf("\t8. Explorar usuarios populares\n");
+        printf("\t9. Ver como estoy conectado con otro usuario\n");
+        printf("\t10. Buscar usuarios\n");
+        printf("\t11. Buscar publicaciones\n");
+        printf("\t12. Salir\n");
         int option;
         do{
             printf("Opcion: ");
@@ -189,7 +237,7 @@ void user_mode(char *userName)
                 print_error(103, NULL, NULL);
                 continue;
             }
-        }while(option < 1 || option > 6);
+        }while(option < 1 || option > 12);
 
         switch(option){
             case 1: // Ver perfiles de mis amigos
@@ -211,42 +259,87 @@ void user_mode(char *userName)
             case 3: // Ver me feed de publicaciones
                 print_user_feed(user, loopwebBands, loopwebGenres, loopwebComments);
                 break;
-            case 4: // Realizar una publicacion
+            case 4: // Ver mi feed por relevancia
+                printf("Cuantas publicaciones desea ver? (0 para %d): ", FEED_RANK_SIZE);
+                if(scanf("%d", &option) != 1){
+                    print_error(103, NULL, NULL);
+                    continue;
+                }
+                print_user_ranked_feed(user, loopwebUsers, loopwebBands, loopwebGenres, loopwebComments, option > 0 ? option : FEED_RANK_SIZE);
+                break;
+            case 5: // Realizar una publicacion
                 make_comment(userName, loopwebUsers, loopwebBands, loopwebGenres, loopwebComments);
                 break;
-            case 5: // Ver mis recomendaciones de amigos
-                possibleFriends = find_possible_friends(user, loopwebUsers);
-
-                UserLinkPosition aux = possibleFriends->next;
-                while(aux != NULL){
-                    complete_userLinkList_node(aux, loopwebUsers);
-                    if(aux == NULL){
-                        continue;
-                    }
-                    complete_user_from_json(aux->userNode);
-
-                    /* Se calcula el coeficiente para cada usuario como sigue:
-                       - Un 20% del valor dado por la diferencia de edades
-                       - Un 40% del valor dado por el indice de Jaccard entre los generos de ambos usuarios
-                       - Un 60% del valor dado por el indice de Jaccard entre las bandas de ambos usuarios
-                    Esto da un maximo del indice de 1.0 */
-                    aux->coefficient = 0;
-                    #ifdef DEBUG
-                        printf("%s AND %s\n", aux->userName, user->username);
-                    #endif
-                    aux->coefficient += 0.2 * pow(EULER, -0.09*abs(user->age - aux->userNode->age)); // Coeficiente de edad (Lo tomamos como una variable aleatoria de tipo exponencial)
-                    aux->coefficient += 0.4 * jacardIndex_genreLinkList(user->genres, aux->userNode->genres);
-                    aux->coefficient += 0.4 * jacardIndex_bandLinkList(user->bands, aux->userNode->bands);
-
-                    aux = aux->next;
+            case 6: // Ver mis recomendaciones de amigos
+                printf("Cuantas recomendaciones desea ver? (0 para %d): ", RECOMMENDATIONS_SIZE);
+                if(scanf("%d", &option) != 1){
+                    print_error(103, NULL, NULL);
+                    continue;
+                }
+                option = option > 0 ? option : RECOMMENDATIONS_SIZE;
+                user = complete_user_from_json(user);
+                // Usamos las recomendaciones precalculadas (--precompute-recs) si siguen vigentes y alcanzan
+                possibleFriends = option <= RECOMMENDATIONS_SIZE ? load_user_recommendations(user, loopwebUsers, option) : NULL;
+                if(possibleFriends == NULL){
+                    possibleFriends = compute_user_recommendations(user, loopwebUsers, get_userTable_threadPool(loopwebUsers), option);
                 }
-                sort_userLinkList_byCoefficient(&possibleFriends->next);
 
-                print_user_recommendations(user, possibleFriends);
+                print_user_recommendations(user, possibleFriends, loopwebUsers);
+                request_for_friendship(user, possibleFriends, loopwebUsers);
+                delete_userLinkList(possibleFriends);
+                break;
+            case 7: // Ver recomendaciones por recorridos aleatorios
+                printf("Cuantos recorridos desea simular? (0 para %d): ", PPR_WALKS);
+                if(scanf("%d", &option) != 1){
+                    print_error(103, NULL, NULL);
+                    continue;
+                }
+                user = complete_user_from_json(user);
+                possibleFriends = compute_user_pagerank_recommendations(user, loopwebUsers, get_userTable_threadPool(loopwebUsers), option > 0 ? option : PPR_WALKS, PPR_TIME_LIMIT_MS, RECOMMENDATIONS_SIZE);
+                print_user_recommendations(user, possibleFriends, loopwebUsers);
+                request_for_friendship(user, possibleFriends, loopwebUsers);
+                delete_userLinkList(possibleFriends);
+                break;
+            case 8: // Explorar usuarios populares
+                printf("Cuantos usuarios desea ver? (0 para %d): ", POPULARITY_SIZE);
+                if(scanf("%d", &option) != 1){
+                    print_error(103, NULL, NULL);
+                    continue;
+                }
+                user = complete_user_from_json(user);
+                possibleFriends = get_popular_users(user, loopwebUsers, option > 0 ? option : POPULARITY_SIZE);
+                print_popular_users(possibleFriends, loopwebUsers);
                 request_for_friendship(user, possibleFriends, loopwebUsers);
                 delete_userLinkList(possibleFriends);
                 break;
-            case 6: // Salir
+            case 9: // Ver como estoy conectado con otro usuario
+                printf("Ingrese el nombre del usuario: ");
+                if(scanf("%199s", targetName) != 1){
+                    print_error(103, NULL, NULL);
+                    continue;
+                }
+                UserPosition target = find_userTable_node(loopwebUsers, targetName);
+                if(target == NULL){
+                    print_error(300, targetName, NULL);
+                    target = suggest_user(loopwebUsers, targetName);
+                    if(target == NULL){
+                        break;
+                    }
+                }
+                if(search == NULL){
+                    search = create_graphSearch(loopwebUsers->idCount);
+                }
+                possibleFriends = find_friendship_path(search, loopwebUsers, user->ID, target->ID, GRAPH_PATH_MAX_DEPTH);
+                print_friendship_path(user, target, possibleFriends);
+                delete_userLinkList(possibleFriends);
+                break;
+            case 10: // Buscar usuarios
+                browse_users(loopwebUsers);
+                break;
+            case 11: // Buscar publicaciones por su texto
+                search_comments(loopwebComments);
+                break;
+            case 12: // Salir
                 printf("Nos vemos pronto\n");
                 terminate = 1;
                 continue;
@@ -271,9 +364,167 @@ void user_mode(char *userName)
         save_commentTable(loopwebComments);
     if(loopwebUsers->modified)
         save_userTable(loopwebUsers);
+    if(loopwebUsers->popularity && loopwebUsers->popularity->modified)
+        save_popularity(loopwebUsers->popularity, loopwebUsers);
 
     delete_bandTable(loopwebBands);
     delete_genresTable(loopwebGenres);
     delete_commentTable(loopwebComments);
+    delete_graphSearch(search);
     delete_userTable(loopwebUsers);
-}
\ No newline at end of file
+}
+/**
+ * @brief Funcion para precalcular las recomendaciones de amistad de todos los usuarios de la red
+ *
+ * Las recomendaciones se calculan en paralelo (un hilo por nucleo) y se guardan en RECS_PATH, desde donde
+ * el modo usuario las lee mientras sigan vigentes.
+*/
+void precompute_mode()
+{
+    UserTable loopwebUsers = get_users_from_file(USERS_PATH"users.json", NULL);
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int written = precompute_recommendations(loopwebUsers, RECOMMENDATIONS_SIZE);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    printf("Recomendaciones precalculadas para "ANSI_COLOR_CYAN"%d"ANSI_COLOR_RESET" usuarios en %.3f s (%d hilos)\n", written, seconds, get_userTable_threadPool(loopwebUsers)->threadCount);
+
+    delete_userTable(loopwebUsers);
+}
+
+/**
+ * @brief Funcion para recalcular la popularidad (PageRank) de todos los usuarios de la red y guardarla
+ *
+ * @param loopwebUsers Tabla de usuarios
+*/
+void popular_mode(UserTable loopwebUsers)
+{
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    Popularity popularity = compute_popularity(loopwebUsers, get_userTable_threadPool(loopwebUsers), NULL);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    delete_popularity(loopwebUsers->popularity);
+    loopwebUsers->popularity = popularity;
+    save_popularity(popularity, loopwebUsers);
+
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    printf(CLEAR_SCREEN"Popularidad calculada en "ANSI_COLOR_CYAN"%d"ANSI_COLOR_RESET" iteraciones, %.3f s (%d hilos)\n\n", popularity->iterations, seconds, get_userTable_threadPool(loopwebUsers)->threadCount);
+    UserLinkList popular = get_popular_users(NULL, loopwebUsers, POPULARITY_SIZE);
+    print_popular_users(popular, loopwebUsers);
+    delete_userLinkList(popular);
+}
+
+/**
+ * @brief Funcion para reconstruir las publicaciones de cada banda y genero a partir de los textos de las publicaciones
+ *
+ * @param loopwebUsers Tabla de usuarios (se usa su pool de hilos)
+ * @param loopwebBands Tabla de bandas
+ * @param loopwebGenres Tabla de generos
+*/
+void retag_mode(UserTable loopwebUsers, BandTable loopwebBands, GenreTable loopwebGenres)
+{
+    RetagStats stats = retag_comments(COMMENTS_PATH"comments.json", loopwebBands, loopwebGenres, get_userTable_threadPool(loopwebUsers));
+
+    printf(CLEAR_SCREEN"Se re-etiquetaron "ANSI_COLOR_CYAN"%d"ANSI_COLOR_RESET" publicaciones en %.3f s (%.0f publicaciones/s, %d hilos)\n", stats.read, stats.seconds, stats.seconds > 0 ? stats.read / stats.seconds : 0, stats.threads);
+    printf("\t%d enlaces a bandas y %d enlaces a generos\n", stats.bandLinks, stats.genreLinks);
+    if(stats.unknown > 0){
+        printf("\t%d etiquetas no corresponden a bandas o generos de la red\n", stats.unknown);
+    }
+    if(stats.read < stats.comments){
+        printf("\t%d publicaciones no se pudieron leer\n", stats.comments - stats.read);
+    }
+    if(!stats.saved){
+        printf("\tNo se pudieron reemplazar los archivos de bandas y generos\n");
+    }
+}
+
+/**
+ * @brief Funcion para ejecutar un archivo de comandos (o la entrada estandar si es "-") sin menus ni pausas
+ *
+ * Las tablas se cargan una sola vez y los cambios se guardan al terminar o con el comando "save". Ver script.c para
+ * los comandos disponibles.
+ *
+ * @param path Ruta del archivo de comandos
+*/
+void script_mode(const char* path)
+{
+    FILE* input = strcmp(path, "-") == 0 ? stdin : fopen(path, "r");
+    if(input == NULL){
+        print_error(100, (char*)path, NULL);
+        return;
+    }
+
+    ScriptSession session = create_scriptSession();
+    RenderBuffer out = create_renderBuffer(STDOUT_FILENO);
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    run_script(session, input, out);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    render_format(out, "# %d comandos en %.3f s (%.0f comandos/s), %d errores\n", session->commands, seconds, seconds > 0 ? session->commands / seconds : 0, session->failures);
+    delete_renderBuffer(out);
+    delete_scriptSession(session);
+    if(input != stdin){
+        fclose(input);
+    }
+}
+
+/**
+ * @brief Funcion para mantener las tablas cargadas y atender comandos por un socket de dominio Unix
+ *
+ * El servidor termina con SIGINT o SIGTERM, guardando antes lo que haya cambiado e imprimiendo la latencia de
+ * cada tipo de solicitud.
+ *
+ * @param path Ruta del socket
+*/
+void serve_mode(const char* path)
+{
+    Server server = create_server(path);
+    if(server == NULL){
+        return;
+    }
+    printf("Servidor escuchando en "ANSI_COLOR_CYAN"%s"ANSI_COLOR_RESET" (Ctrl+C para terminar)\n", path);
+    fflush(stdout);
+    run_server(server);
+    printf("\nSe atendieron %ld solicitudes con %d trabajadores, guardando...\n", server->requests, server->workerCount);
+    for(int i=0; i<SERVER_VERB_COUNT; i++){
+        print_latency(serverVerbs[i], &server->latency[i]);
+    }
+    delete_server(server);
+}
+
+/**
+ * @brief Funcion para enviar al servidor los comandos de la entrada estandar, una linea por solicitud
+ *
+ * @param path Ruta del socket del servidor
+*/
+void client_mode(const char* path)
+{
+    run_client(path, stdin);
+}
+
+/**
+ * @brief Funcion para medir el servidor: reparte los comandos de la entrada estandar entre SERVER_LOAD_CONNECTIONS
+ * conexiones simultaneas e imprime la tasa de solicitudes y su latencia
+ *
+ * @param path Ruta del socket del servidor
+*/
+void load_mode(const char* path)
+{
+    run_load(path, stdin, SERVER_LOAD_CONNECTIONS);
+}
+
+/**
+ * @brief Funcion para medir el rendimiento de LoopWeb sobre datos sinteticos, sin leer ni escribir los datos de ./build
+*/
+void bench_mode()
+{
+    bench_comment_IDs(); // Primero: sus procesos hijos eligen su propio identificador para los IDs
+    bench_recommendations();
+    bench_tags();
+    bench_feed_render();
+    bench_friend_bfs();
+}
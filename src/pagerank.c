@@ -0,0 +1,330 @@
+/**
+ * @file pagerank.c
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Recomendaciones por PageRank personalizado, estimado con recorridos aleatorios con reinicio
+*/
+#include "pagerank.h"
+
+// Funciones del grafo usuario-gusto
+
+/**
+ * @brief Construye el grafo usuario-gusto con los generos y bandas de todos los usuarios de la tabla
+ *
+ * @param table Tabla de usuarios
+ * @return Puntero al grafo creado
+ * @note Usa los gustos de cada usuario leidos desde users.json (a traves del indice de gustos), sin abrir perfiles
+*/
+TasteGraph build_tasteGraph(UserTable table)
+{
+    get_tasteIndex(table);
+
+    TasteGraph graph = (TasteGraph)malloc(sizeof(struct _tasteGraph));
+    if(graph == NULL){
+        print_error(200, NULL, NULL);
+    }
+    graph->userCount = table->idCount;
+    graph->genreCount = table->genreNames->count;
+    graph->tagCount = table->genreNames->count + table->bandNames->count;
+    graph->userOffsets = (int*)calloc(graph->userCount + 1, sizeof(int));
+    graph->tagOffsets = (int*)calloc(graph->tagCount + 1, sizeof(int));
+    if(graph->userOffsets == NULL || graph->tagOffsets == NULL){
+        print_error(200, NULL, NULL);
+    }
+
+    // Primera pasada: contamos los gustos de cada usuario y los usuarios de cada gusto
+    for(int ID=0; ID<graph->userCount; ID++){
+        UserPosition user = table->usersByID[ID];
+        if(user == NULL){
+            continue;
+        }
+        for(int genre = next_bitmap_bit(user->genreSet, 0); genre >= 0; genre = next_bitmap_bit(user->genreSet, genre + 1)){
+            graph->userOffsets[ID + 1]++;
+            graph->tagOffsets[genre + 1]++;
+        }
+        for(int band = next_bitmap_bit(user->bandSet, 0); band >= 0; band = next_bitmap_bit(user->bandSet, band + 1)){
+            graph->userOffsets[ID + 1]++;
+            graph->tagOffsets[graph->genreCount + band + 1]++;
+        }
+    }
+    for(int i=0; i<graph->userCount; i++){
+        graph->userOffsets[i + 1] += graph->userOffsets[i];
+    }
+    for(int i=0; i<graph->tagCount; i++){
+        graph->tagOffsets[i + 1] += graph->tagOffsets[i];
+    }
+
+    // Segunda pasada: llenamos las listas (los usuarios de cada gusto quedan ordenados por ID)
+    int edges = graph->userOffsets[graph->userCount];
+    graph->userTags = (int*)malloc(sizeof(int) * (edges > 0 ? edges : 1));
+    graph->tagUsers = (int*)malloc(sizeof(int) * (edges > 0 ? edges : 1));
+    int* tagFill = (int*)malloc(sizeof(int) * (graph->tagCount > 0 ? graph->tagCount : 1));
+    if(graph->userTags == NULL || graph->tagUsers == NULL || tagFill == NULL){
+        print_error(200, NULL, NULL);
+    }
+    memcpy(tagFill, graph->tagOffsets, sizeof(int) * graph->tagCount);
+    for(int ID=0; ID<graph->userCount; ID++){
+        UserPosition user = table->usersByID[ID];
+        if(user == NULL){
+            continue;
+        }
+        int position = graph->userOffsets[ID];
+        for(int genre = next_bitmap_bit(user->genreSet, 0); genre >= 0; genre = next_bitmap_bit(user->genreSet, genre + 1)){
+            graph->userTags[position++] = genre;
+            graph->tagUsers[tagFill[genre]++] = ID;
+        }
+        for(int band = next_bitmap_bit(user->bandSet, 0); band >= 0; band = next_bitmap_bit(user->bandSet, band + 1)){
+            graph->userTags[position++] = graph->genreCount + band;
+            graph->tagUsers[tagFill[graph->genreCount + band]++] = ID;
+        }
+    }
+    free(tagFill);
+    return graph;
+}
+
+/**
+ * @brief Borra un grafo usuario-gusto
+ *
+ * @param graph Grafo a borrar
+*/
+void delete_tasteGraph(TasteGraph graph)
+{
+    if(graph == NULL){
+        return;
+    }
+    free(graph->userOffsets);
+    free(graph->userTags);
+    free(graph->tagOffsets);
+    free(graph->tagUsers);
+    free(graph);
+}
+
+/**
+ * @brief Obtiene el grafo usuario-gusto de la tabla, construyendolo si aun no existe
+ *
+ * @param table Tabla de usuarios
+ * @return Grafo usuario-gusto de la tabla
+*/
+TasteGraph get_tasteGraph(UserTable table)
+{
+    if(table->tasteGraph == NULL){
+        table->tasteGraph = build_tasteGraph(table);
+    }
+    return table->tasteGraph;
+}
+
+// Funciones de los recorridos aleatorios
+
+/**
+ * @brief Avanza un generador xorshift64*
+ *
+ * @param state Estado del generador (distinto de cero, propio de cada hilo)
+ * @return Siguiente numero pseudoaleatorio de 64 bits
+*/
+unsigned long long random_next(unsigned long long* state)
+{
+    unsigned long long x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * @brief Obtiene un entero pseudoaleatorio en [0, @p bound)
+ *
+ * @param state Estado del generador
+ * @param bound Cota superior (mayor a cero)
+ * @return Entero pseudoaleatorio
+*/
+int random_below(unsigned long long* state, int bound)
+{
+    return (int)(((random_next(state) >> 32) * (unsigned long long)bound) >> 32);
+}
+
+/**
+ * @brief Obtiene un real pseudoaleatorio en [0, 1)
+ *
+ * @param state Estado del generador
+ * @return Real pseudoaleatorio
+*/
+double random_unit(unsigned long long* state)
+{
+    return (random_next(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * @brief Indica si ya se alcanzo un momento limite
+ *
+ * @param deadline Momento limite (reloj CLOCK_MONOTONIC)
+ * @return TRUE si el momento ya paso, FALSE en caso contrario
+*/
+bool deadline_passed(const struct timespec* deadline)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec > deadline->tv_sec || (now.tv_sec == deadline->tv_sec && now.tv_nsec >= deadline->tv_nsec);
+}
+
+/**
+ * @brief Da un paso de un recorrido aleatorio desde un usuario
+ *
+ * Con probabilidad PPR_TASTE_PROB el paso va a un usuario que comparte una banda o genero con el actual
+ * (usuario -> gusto -> usuario), y si no a uno de sus amigos. Si el usuario no tiene una de las dos opciones
+ * se usa la otra.
+ *
+ * @param job Trabajo de recorridos
+ * @param current ID del usuario actual
+ * @param state Estado del generador aleatorio del hilo
+ * @return ID del siguiente usuario, -1 si el usuario actual no tiene amigos ni gustos
+*/
+int random_walk_step(WalkJob* job, int current, unsigned long long* state)
+{
+    int degree = friendGraph_degree(job->friends, current);
+    int tagCount = current < job->tastes->userCount ? job->tastes->userOffsets[current + 1] - job->tastes->userOffsets[current] : 0;
+
+    if(tagCount > 0 && (degree == 0 || random_unit(state) < PPR_TASTE_PROB)){
+        int tag = job->tastes->userTags[job->tastes->userOffsets[current] + random_below(state, tagCount)];
+        int users = job->tastes->tagOffsets[tag + 1] - job->tastes->tagOffsets[tag];
+        return job->tastes->tagUsers[job->tastes->tagOffsets[tag] + random_below(state, users)];
+    }
+    if(degree > 0){
+        return friendGraph_neighbors(job->friends, current)[random_below(state, degree)];
+    }
+    return -1;
+}
+
+/**
+ * @brief Tarea del pool de hilos: simula bloques de PPR_BATCH recorridos desde el usuario de origen
+ *
+ * Cada hilo cuenta las visitas en su propio arreglo. Si se alcanza el tiempo maximo, los bloques restantes
+ * se omiten.
+ *
+ * @param arg Puntero al WalkJob
+ * @param worker Indice del hilo
+ * @param first Primer bloque
+ * @param last Bloque siguiente al ultimo
+*/
+void random_walks_task(void* arg, int worker, int first, int last)
+{
+    WalkJob* job = (WalkJob*)arg;
+    unsigned int* visits = job->visits[worker];
+    unsigned long long* state = &job->rng[worker];
+
+    for(int batch = first; batch < last; batch++){
+        if(deadline_passed(&job->deadline)){
+            return;
+        }
+        for(int walk = 0; walk < PPR_BATCH; walk++){
+            int current = job->source;
+            for(int step = 0; step < PPR_MAX_STEPS; step++){
+                if(random_unit(state) < PPR_RESTART){
+                    break;
+                }
+                current = random_walk_step(job, current, state);
+                if(current < 0){
+                    break;
+                }
+                visits[current]++;
+            }
+        }
+        job->walks[worker] += PPR_BATCH;
+    }
+}
+
+/**
+ * @brief Recomienda amigos segun el PageRank personalizado de un usuario
+ *
+ * Se simulan recorridos aleatorios que vuelven al usuario con probabilidad PPR_RESTART en cada paso, por amistades
+ * y por bandas o generos en comun. La fraccion de visitas que recibe cada usuario estima su PageRank personalizado.
+ * Los recorridos se reparten entre los hilos del pool y se detienen al completar @p walks o al pasar @p timeLimitMs,
+ * contado desde la llamada (incluye construir el grafo de amistades y el grafo usuario-gusto si aun no existen).
+ *
+ * @param user Usuario al que se le recomienda
+ * @param table Tabla de usuarios
+ * @param pool Pool de hilos, NULL para simular en el hilo actual
+ * @param walks Cantidad de recorridos a simular (se redondea a bloques de PPR_BATCH)
+ * @param timeLimitMs Tiempo maximo en milisegundos
+ * @param k Cantidad de recomendaciones a entregar
+ * @return Lista con las @p k mejores recomendaciones, ordenada de mayor a menor fraccion de visitas
+*/
+UserLinkList compute_user_pagerank_recommendations(UserPosition user, UserTable table, ThreadPool pool, int walks, int timeLimitMs, int k)
+{
+    // El tiempo maximo cuenta desde aqui: incluye cargar el perfil y construir los grafos la primera vez
+    WalkJob job;
+    clock_gettime(CLOCK_MONOTONIC, &job.deadline);
+    job.deadline.tv_sec += timeLimitMs / 1000;
+    job.deadline.tv_nsec += (long)(timeLimitMs % 1000) * 1000000L;
+    if(job.deadline.tv_nsec >= 1000000000L){
+        job.deadline.tv_sec++;
+        job.deadline.tv_nsec -= 1000000000L;
+    }
+    complete_user_from_json(user);
+    job.friends = get_friendGraph(table);
+    job.tastes = get_tasteGraph(table);
+    job.source = user->ID;
+
+    int threads = pool ? pool->threadCount : 1;
+    int nodes = table->idCount;
+    job.visits = (unsigned int**)malloc(sizeof(unsigned int*) * threads);
+    job.rng = (unsigned long long*)malloc(sizeof(unsigned long long) * threads);
+    job.walks = (int*)calloc(threads, sizeof(int));
+    if(job.visits == NULL || job.rng == NULL || job.walks == NULL){
+        print_error(200, NULL, NULL);
+    }
+    for(int i=0; i<threads; i++){
+        job.visits[i] = (unsigned int*)calloc(nodes > 0 ? nodes : 1, sizeof(unsigned int));
+        if(job.visits[i] == NULL){
+            print_error(200, NULL, NULL);
+        }
+        job.rng[i] = PPR_SEED ^ ((unsigned long long)(i + 1) << 32) ^ (unsigned long long)user->ID;
+    }
+    int batches = (walks + PPR_BATCH - 1) / PPR_BATCH;
+    if(pool){
+        // Unos 16 bloques de trabajo por hilo: al pasar el tiempo maximo cada uno se descarta en una sola revision
+        int chunk = batches / (threads * 16);
+        run_threadPool(pool, random_walks_task, &job, batches, chunk > 0 ? chunk : 1);
+    }
+    else{
+        random_walks_task(&job, 0, 0, batches);
+    }
+
+    // Juntamos las visitas de todos los hilos en el arreglo del primero
+    for(int i=1; i<threads; i++){
+        for(int ID=0; ID<nodes; ID++){
+            job.visits[0][ID] += job.visits[i][ID];
+        }
+    }
+    unsigned long long totalVisits = 0;
+    for(int ID=0; ID<nodes; ID++){
+        totalVisits += job.visits[0][ID];
+    }
+    #ifdef DEBUG
+        int walksDone = 0;
+        for(int i=0; i<threads; i++){
+            walksDone += job.walks[i];
+        }
+        printf("PageRank personalizado de "ANSI_COLOR_CYAN"%s"ANSI_COLOR_RESET": %d recorridos, %llu visitas\n", user->username, walksDone, totalVisits);
+    #endif
+
+    // Candidatos: usuarios visitados que no son el propio usuario ni sus amigos
+    UserLinkList recommendations = create_empty_userLinkList(NULL);
+    UserLinkPosition last = recommendations;
+    for(int ID=0; ID<nodes; ID++){
+        UserPosition candidate = table->usersByID[ID];
+        if(job.visits[0][ID] == 0 || candidate == NULL || ID == user->ID || has_friendGraph_edge(job.friends, user->ID, ID)){
+            continue;
+        }
+        last = insert_userLinkList_node_completeInfo(last, candidate);
+        last->coefficient = (double)job.visits[0][ID] / totalVisits;
+    }
+    select_top_recommendations(recommendations, k);
+
+    for(int i=0; i<threads; i++){
+        free(job.visits[i]);
+    }
+    free(job.visits);
+    free(job.rng);
+    free(job.walks);
+    return recommendations;
+}
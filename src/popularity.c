@@ -0,0 +1,428 @@
+/**
+ * @file popularity.c
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Popularidad de los usuarios de la red (PageRank sobre el grafo de amistades)
+*/
+#include "popularity.h"
+
+// Funciones de calculo de popularidad
+
+/**
+ * @brief Crea una popularidad vacia
+ *
+ * @param count Cantidad de IDs a cubrir
+ * @return Puntero a la popularidad creada (con PageRank en cero)
+*/
+Popularity create_popularity(int count)
+{
+    Popularity popularity = (Popularity)malloc(sizeof(struct _popularity));
+    if(popularity == NULL){
+        print_error(200, NULL, NULL);
+    }
+    popularity->rank = (double*)calloc(count > 0 ? count : 1, sizeof(double));
+    if(popularity->rank == NULL){
+        print_error(200, NULL, NULL);
+    }
+    popularity->count = count;
+    popularity->iterations = 0;
+    popularity->computedAt = 0;
+    popularity->version = 0;
+    popularity->inLinks = NULL;
+    popularity->outdated = false;
+    popularity->modified = false;
+    return popularity;
+}
+
+/**
+ * @brief Borra una popularidad
+ *
+ * @param popularity Popularidad a borrar
+*/
+void delete_popularity(Popularity popularity)
+{
+    if(popularity == NULL){
+        return;
+    }
+    if(popularity->inLinks){
+        delete_friendGraph(popularity->inLinks);
+    }
+    free(popularity->rank);
+    free(popularity);
+}
+
+/**
+ * @brief Construye las listas de enlaces entrantes del grafo de amistades (el grafo transpuesto)
+ *
+ * Las listas de amigos de los archivos no siempre son simetricas, por lo que cada usuario debe recibir PageRank
+ * de quienes lo tienen como amigo y no de sus propios amigos. El grafo se guarda en la popularidad y las amistades
+ * nuevas se le agregan en su lugar (ver `refresh_popularity`).
+ *
+ * @param graph Grafo de amistades
+ * @param nodes Cantidad de IDs
+ * @return Grafo con la arista to -> from por cada arista from -> to de @p graph
+*/
+FriendGraph build_pagerank_inLinks(FriendGraph graph, int nodes)
+{
+    FriendGraph inLinks = create_friendGraph(nodes);
+    for(int ID=0; ID<nodes; ID++){
+        int degree = friendGraph_degree(graph, ID);
+        int* neighbors = friendGraph_neighbors(graph, ID);
+        for(int i=0; i<degree; i++){
+            add_friendGraph_edge(inLinks, neighbors[i], ID);
+        }
+    }
+    return inLinks;
+}
+
+/**
+ * @brief Tarea del pool de hilos: calcula el PageRank de un bloque de usuarios a partir de sus enlaces entrantes
+ *
+ * Cada usuario lee el aporte de quienes lo tienen como amigo (pull), asi ningun hilo escribe en la posicion de otro.
+ *
+ * @param arg Puntero al PageRankJob
+ * @param worker Indice del hilo
+ * @param first Primer ID del bloque
+ * @param last ID siguiente al ultimo del bloque
+*/
+void pagerank_iteration_task(void* arg, int worker, int first, int last)
+{
+    PageRankJob* job = (PageRankJob*)arg;
+    double delta = 0;
+    for(int ID = first; ID < last; ID++){
+        if(!job->active[ID]){
+            job->next[ID] = 0;
+            continue;
+        }
+        double sum = 0;
+        int degree = friendGraph_degree(job->inLinks, ID);
+        int* sources = friendGraph_neighbors(job->inLinks, ID);
+        for(int i=0; i<degree; i++){
+            sum += job->share[sources[i]];
+        }
+        job->next[ID] = job->base + PAGERANK_DAMPING * sum;
+        delta += fabs(job->next[ID] - job->rank[ID]);
+    }
+    job->delta[worker] += delta;
+}
+
+/**
+ * @brief Calcula el PageRank de los usuarios con el metodo de la potencia
+ *
+ * Los usuarios sin amigos reparten su PageRank entre todos. Cada iteracion se reparte entre los hilos del pool.
+ *
+ * @param table Tabla de usuarios
+ * @param pool Pool de hilos, NULL para calcular en el hilo actual
+ * @param inLinks Enlaces entrantes de cada usuario (ver `build_pagerank_inLinks`)
+ * @param rank Arreglo de table->idCount valores con la estimacion inicial, donde queda el resultado
+ * @param maxIterations Cantidad maxima de iteraciones
+ * @return Cantidad de iteraciones realizadas
+ * @note Partir del resultado de un calculo anterior (por ejemplo, antes de agregar una amistad) converge en pocas iteraciones
+*/
+int compute_pagerank(UserTable table, ThreadPool pool, FriendGraph inLinks, double* rank, int maxIterations)
+{
+    int nodes = table->idCount;
+    int threads = pool ? pool->threadCount : 1;
+    PageRankJob job;
+    job.graph = get_friendGraph(table);
+    job.inLinks = inLinks;
+    job.rank = rank;
+    job.share = (double*)malloc(sizeof(double) * (nodes > 0 ? nodes : 1));
+    job.next = (double*)malloc(sizeof(double) * (nodes > 0 ? nodes : 1));
+    job.active = (bool*)malloc(sizeof(bool) * (nodes > 0 ? nodes : 1));
+    job.delta = (double*)malloc(sizeof(double) * threads);
+    if(job.share == NULL || job.next == NULL || job.active == NULL || job.delta == NULL){
+        print_error(200, NULL, NULL);
+    }
+
+    // Normalizamos la estimacion inicial sobre los usuarios existentes
+    int activeCount = 0;
+    double total = 0;
+    for(int ID=0; ID<nodes; ID++){
+        job.active[ID] = table->usersByID[ID] != NULL;
+        if(job.active[ID]){
+            activeCount++;
+            total += rank[ID];
+        }
+    }
+    for(int ID=0; ID<nodes; ID++){
+        rank[ID] = !job.active[ID] ? 0 : (total > 0 ? rank[ID] / total : 1.0 / activeCount);
+    }
+
+    int iteration = 0;
+    while(activeCount > 0 && iteration < maxIterations){
+        double dangling = 0;
+        for(int ID=0; ID<nodes; ID++){
+            int degree = friendGraph_degree(job.graph, ID);
+            job.share[ID] = degree > 0 ? rank[ID] / degree : 0;
+            if(job.active[ID] && degree == 0){
+                dangling += rank[ID];
+            }
+        }
+        job.base = (1.0 - PAGERANK_DAMPING) / activeCount + PAGERANK_DAMPING * dangling / activeCount;
+        memset(job.delta, 0, sizeof(double) * threads);
+
+        if(pool){
+            run_threadPool(pool, pagerank_iteration_task, &job, nodes, 0);
+        }
+        else{
+            pagerank_iteration_task(&job, 0, 0, nodes);
+        }
+        memcpy(rank, job.next, sizeof(double) * nodes);
+        iteration++;
+
+        double delta = 0;
+        for(int i=0; i<threads; i++){
+            delta += job.delta[i];
+        }
+        if(delta < PAGERANK_TOLERANCE){
+            break;
+        }
+    }
+
+    free(job.share);
+    free(job.next);
+    free(job.active);
+    free(job.delta);
+    return iteration;
+}
+
+/**
+ * @brief Calcula la popularidad de todos los usuarios de la tabla
+ *
+ * @param table Tabla de usuarios
+ * @param pool Pool de hilos, NULL para calcular en el hilo actual
+ * @param previous Popularidad anterior desde la que se parte (NULL para partir de una distribucion uniforme)
+ * @return Popularidad calculada (nueva, @p previous no se modifica)
+*/
+Popularity compute_popularity(UserTable table, ThreadPool pool, Popularity previous)
+{
+    Popularity popularity = create_popularity(table->idCount);
+    for(int ID=0; ID<popularity->count; ID++){
+        popularity->rank[ID] = previous && ID < previous->count ? previous->rank[ID] : 1.0;
+    }
+    popularity->inLinks = build_pagerank_inLinks(get_friendGraph(table), table->idCount);
+    popularity->iterations = compute_pagerank(table, pool, popularity->inLinks, popularity->rank, previous ? PAGERANK_REFRESH_ITERATIONS : PAGERANK_MAX_ITERATIONS);
+    popularity->modified = true;
+    return popularity;
+}
+
+/**
+ * @brief Recalcula una popularidad desactualizada partiendo de su resultado anterior
+ *
+ * Usa los enlaces entrantes que ya tiene la popularidad, asi que no se recorre de nuevo el grafo de amistades
+ * (salvo la primera vez en una popularidad leida desde POPULARITY_PATH).
+ *
+ * @param popularity Popularidad a actualizar
+ * @param table Tabla de usuarios
+*/
+void update_popularity(Popularity popularity, UserTable table)
+{
+    if(!popularity->outdated && popularity->count >= table->idCount){
+        return;
+    }
+    if(popularity->count < table->idCount){
+        popularity->rank = (double*)realloc(popularity->rank, sizeof(double) * table->idCount);
+        if(popularity->rank == NULL){
+            print_error(200, NULL, NULL);
+        }
+        for(int ID=popularity->count; ID<table->idCount; ID++){
+            popularity->rank[ID] = 0;
+        }
+        popularity->count = table->idCount;
+    }
+    if(popularity->inLinks == NULL){
+        popularity->inLinks = build_pagerank_inLinks(get_friendGraph(table), table->idCount);
+    }
+    popularity->iterations = compute_pagerank(table, get_userTable_threadPool(table), popularity->inLinks, popularity->rank, PAGERANK_REFRESH_ITERATIONS);
+    popularity->outdated = false;
+    popularity->modified = true;
+}
+
+/**
+ * @brief Registra una amistad nueva en la popularidad de la tabla
+ *
+ * Solo se agregan los enlaces entrantes de la amistad y la popularidad se marca como desactualizada; el PageRank
+ * se recalcula al consultarla o guardarla, una sola vez para todas las amistades creadas mientras tanto.
+ *
+ * @param table Tabla de usuarios
+ * @param from ID del primer usuario
+ * @param to ID del segundo usuario
+*/
+void refresh_popularity(UserTable table, int from, int to)
+{
+    Popularity popularity = table->popularity;
+    if(popularity == NULL){
+        return;
+    }
+    if(popularity->inLinks){
+        add_friendGraph_edge(popularity->inLinks, to, from);
+        add_friendGraph_edge(popularity->inLinks, from, to);
+    }
+    popularity->outdated = true;
+    popularity->modified = true;
+}
+
+// Funciones de persistencia de la popularidad
+
+/**
+ * @brief Guarda la popularidad en POPULARITY_PATH
+ *
+ * El archivo tiene una linea de cabecera "<momento del calculo> <version de la red> <cantidad>" seguida de una
+ * linea "<PageRank> <usuario>" por cada usuario existente. La version es la que se compara con la de la tabla al
+ * leerla.
+ *
+ * @param popularity Popularidad a guardar
+ * @param table Tabla de usuarios
+ * @return TRUE si el archivo se escribio, FALSE en caso contrario
+*/
+bool save_popularity(Popularity popularity, UserTable table)
+{
+    update_popularity(popularity, table);
+    FILE* file = fopen(POPULARITY_PATH, "w");
+    if(file == NULL){
+        print_error(100, POPULARITY_PATH, NULL);
+        return false;
+    }
+    int count = 0;
+    for(int ID=0; ID<popularity->count; ID++){
+        if(table->usersByID[ID]){
+            count++;
+        }
+    }
+    popularity->computedAt = time(NULL);
+    popularity->version = table->version;
+    fprintf(file, "%ld %llx %d\n", (long)popularity->computedAt, (unsigned long long)popularity->version, count);
+    for(int ID=0; ID<popularity->count; ID++){
+        if(table->usersByID[ID]){
+            fprintf(file, "%.12f %s\n", popularity->rank[ID], table->usersByID[ID]->username);
+        }
+    }
+    fclose(file);
+    popularity->modified = false;
+    return true;
+}
+
+/**
+ * @brief Lee la popularidad guardada en POPULARITY_PATH
+ *
+ * Los usuarios que ya no existen se omiten y los que no aparecen quedan con PageRank cero.
+ *
+ * @param table Tabla de usuarios
+ * @return Popularidad leida, NULL si no hay archivo o no se pudo leer
+*/
+Popularity load_popularity(UserTable table)
+{
+    FILE* file = fopen(POPULARITY_PATH, "r");
+    if(file == NULL){
+        return NULL;
+    }
+    long computedAt;
+    unsigned long long version;
+    int count;
+    if(fscanf(file, "%ld %llx %d", &computedAt, &version, &count) != 3){
+        fclose(file);
+        return NULL;
+    }
+
+    Popularity popularity = create_popularity(table->idCount);
+    popularity->computedAt = (time_t)computedAt;
+    popularity->version = (uint64_t)version;
+    double rank;
+    char userName[200];
+    for(int i=0; i<count; i++){
+        if(fscanf(file, "%lf %199s", &rank, userName) != 2){
+            break;
+        }
+        UserPosition user = find_userTable_node(table, userName);
+        if(user && user->ID >= 0 && user->ID < popularity->count){
+            popularity->rank[user->ID] = rank;
+        }
+    }
+    fclose(file);
+    return popularity;
+}
+
+/**
+ * @brief Obtiene la popularidad de la tabla
+ *
+ * Se usa la guardada en POPULARITY_PATH y, si la version de la red cambio despues de calcularla, se actualiza
+ * partiendo de ella. Si no hay popularidad guardada se calcula completa.
+ *
+ * @param table Tabla de usuarios
+ * @return Popularidad de la tabla
+*/
+Popularity get_popularity(UserTable table)
+{
+    if(table->popularity != NULL){
+        update_popularity(table->popularity, table);
+        return table->popularity;
+    }
+    Popularity popularity = load_popularity(table);
+    bool stale = popularity == NULL || popularity->version != table->version || popularity->count < table->idCount;
+    if(stale){
+        table->popularity = compute_popularity(table, get_userTable_threadPool(table), popularity);
+        delete_popularity(popularity);
+    }
+    else{
+        table->popularity = popularity;
+    }
+    return table->popularity;
+}
+
+// Funciones de consulta de la popularidad
+
+/**
+ * @brief Obtiene los usuarios mas populares de la red
+ *
+ * @param user Usuario que consulta (se excluye del resultado), NULL para incluir a todos
+ * @param table Tabla de usuarios
+ * @param k Cantidad de usuarios a entregar
+ * @return Lista con los @p k usuarios de mayor PageRank, ordenada de mayor a menor (coeficiente = PageRank)
+*/
+UserLinkList get_popular_users(UserPosition user, UserTable table, int k)
+{
+    Popularity popularity = get_popularity(table);
+    ScoreHeap heap = create_scoreHeap(k);
+    for(int ID=0; ID<popularity->count; ID++){
+        UserPosition candidate = table->usersByID[ID];
+        if(candidate == NULL || candidate == user){
+            continue;
+        }
+        if(!is_full_scoreHeap(heap) || popularity->rank[ID] > scoreHeap_min(heap)){
+            push_scoreHeap(heap, popularity->rank[ID], candidate);
+        }
+    }
+
+    UserLinkList popular = create_empty_userLinkList(NULL);
+    UserLinkPosition last = popular;
+    int size = sort_scoreHeap(heap);
+    for(int i=0; i<size; i++){
+        UserPosition candidate = complete_user_from_json((UserPosition)heap->entries[i].data);
+        last = insert_userLinkList_node_completeInfo(last, candidate);
+        last->coefficient = heap->entries[i].score;
+    }
+    delete_scoreHeap(heap);
+    return popular;
+}
+
+/**
+ * @brief Imprime una tabla con los usuarios mas populares
+ *
+ * @param popular Lista de usuarios populares (ver `get_popular_users`)
+ * @param table Tabla de usuarios
+*/
+void print_popular_users(UserLinkList popular, UserTable table)
+{
+    FriendGraph graph = get_friendGraph(table);
+    int counter = 1;
+
+    printf("\t\t Usuarios mas populares de LoopWeb:\n");
+    printf("___________________________________________________________________________\n");
+    printf("| ID |        Nombre       |    Edad   |    Amigos   |      PageRank      |\n");
+    for(UserLinkPosition aux = popular->next; aux != NULL; aux = aux->next){
+        printf("| %-3d|        "ANSI_COLOR_CYAN"%-13s"ANSI_COLOR_RESET"|"ANSI_COLOR_MAGENTA"    %-7d"ANSI_COLOR_RESET"|     %-8d|      %-14.6f|\n", counter, aux->userName, aux->userNode->age, friendGraph_degree(graph, aux->userNode->ID), aux->coefficient);
+        counter++;
+    }
+    printf("___________________________________________________________________________\n");
+    printf("\n");
+}
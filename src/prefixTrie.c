@@ -0,0 +1,345 @@
+/**
+ * @file prefixTrie.c
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Trie de prefijos con los nombres mas usados en cada nodo, para autocompletar bandas y generos
+*/
+#include "prefixTrie.h"
+
+// Funciones del trie de prefijos
+
+/**
+ * @brief Crea un trie vacio
+ *
+ * @return Puntero al trie creado
+*/
+PrefixTrie create_prefixTrie()
+{
+    PrefixTrie trie = (PrefixTrie)malloc(sizeof(struct _prefixTrie));
+    if(trie == NULL){
+        print_error(200, NULL, NULL);
+    }
+    trie->root = (TrieNode*)calloc(1, sizeof(TrieNode));
+    if(trie->root == NULL){
+        print_error(200, NULL, NULL);
+    }
+    trie->count = 0;
+    return trie;
+}
+
+/**
+ * @brief Borra un trie y todos sus nodos
+ *
+ * @param trie Trie a borrar
+*/
+void delete_prefixTrie(PrefixTrie trie)
+{
+    if(trie == NULL){
+        return;
+    }
+    delete_trieNode(trie->root);
+    free(trie);
+}
+
+/**
+ * @brief Borra un nodo, sus hijos y sus hermanos siguientes
+ *
+ * @param node Nodo a borrar
+*/
+void delete_trieNode(TrieNode* node)
+{
+    while(node != NULL){
+        TrieNode* sibling = node->sibling;
+        delete_trieNode(node->child);
+        free(node->name);
+        free(node);
+        node = sibling;
+    }
+}
+
+/**
+ * @brief Busca el hijo de un nodo con un caracter
+ *
+ * @param node Nodo padre
+ * @param key Caracter buscado (en minusculas)
+ * @param create TRUE para crear el hijo si no existe
+ * @return Hijo encontrado o creado, NULL si no existe y @p create es FALSE
+*/
+TrieNode* find_trieNode_child(TrieNode* node, char key, bool create)
+{
+    TrieNode** link = &node->child;
+    while(*link != NULL && (*link)->key < key){
+        link = &(*link)->sibling;
+    }
+    if(*link != NULL && (*link)->key == key){
+        return *link;
+    }
+    if(!create){
+        return NULL;
+    }
+    TrieNode* child = (TrieNode*)calloc(1, sizeof(TrieNode));
+    if(child == NULL){
+        print_error(200, NULL, NULL);
+    }
+    child->key = key;
+    child->sibling = *link;
+    *link = child;
+    return child;
+}
+
+/**
+ * @brief Recorre el trie siguiendo un nombre sin distinguir mayusculas
+ *
+ * @param trie Trie a recorrer
+ * @param name Nombre a seguir
+ * @param create TRUE para crear los nodos que falten
+ * @param path Arreglo de strlen(name) + 1 elementos donde se guardan los nodos recorridos, desde la raiz
+ * @return Cantidad de nodos recorridos (strlen(name) + 1 si se llego al final del nombre)
+*/
+int walk_prefixTrie(PrefixTrie trie, const char* name, bool create, TrieNode** path)
+{
+    TrieNode* node = trie->root;
+    int length = 0;
+    path[length++] = node;
+    for(int i=0; name[i] != '\0'; i++){
+        node = find_trieNode_child(node, (char)tolower((unsigned char)name[i]), create);
+        if(node == NULL){
+            break;
+        }
+        path[length++] = node;
+    }
+    return length;
+}
+
+/**
+ * @brief Recalcula los nombres de mayor peso de un nodo a partir de su propio nombre y los de sus hijos
+ *
+ * @param node Nodo a recalcular
+*/
+void refresh_trieNode_top(TrieNode* node)
+{
+    node->topCount = 0;
+    TrieNode* candidate = node->terminal ? node : NULL;
+    TrieNode* child = node->child;
+    int next = 0;
+    while(candidate != NULL || child != NULL){
+        if(candidate != NULL){
+            // Insercion ordenada en un arreglo de a lo mas TRIE_COMPLETIONS elementos
+            int position = node->topCount;
+            while(position > 0 && trieNode_ranks_before(candidate, node->top[position - 1])){
+                position--;
+            }
+            if(position < TRIE_COMPLETIONS){
+                int last = node->topCount < TRIE_COMPLETIONS ? node->topCount : TRIE_COMPLETIONS - 1;
+                memmove(&node->top[position + 1], &node->top[position], sizeof(TrieNode*) * (last - position));
+                node->top[position] = candidate;
+                if(node->topCount < TRIE_COMPLETIONS){
+                    node->topCount++;
+                }
+            }
+        }
+        // Siguiente candidato: los mejores de cada hijo, en orden
+        candidate = NULL;
+        while(child != NULL && next >= child->topCount){
+            child = child->sibling;
+            next = 0;
+        }
+        if(child != NULL){
+            candidate = child->top[next++];
+        }
+    }
+}
+
+/**
+ * @brief Recalcula los nodos de un camino desde la hoja hasta la raiz
+ *
+ * @param path Nodos del camino, desde la raiz
+ * @param length Cantidad de nodos del camino
+*/
+void refresh_prefixTrie_path(TrieNode** path, int length)
+{
+    for(int i=length - 1; i>=0; i--){
+        refresh_trieNode_top(path[i]);
+    }
+}
+
+/**
+ * @brief Agrega un nombre al trie, o cambia su peso si ya estaba
+ *
+ * @param trie Trie de nombres
+ * @param name Nombre a agregar (el trie guarda su propia copia)
+ * @param weight Peso del nombre
+ * @note Dos nombres que solo difieren en mayusculas comparten nodo, se conserva el primero
+*/
+void insert_prefixTrie_name(PrefixTrie trie, const char* name, int weight)
+{
+    TrieNode** path = (TrieNode**)malloc(sizeof(TrieNode*) * (strlen(name) + 1));
+    if(path == NULL){
+        print_error(200, NULL, NULL);
+    }
+    int length = walk_prefixTrie(trie, name, true, path);
+    TrieNode* node = path[length - 1];
+    if(!node->terminal){
+        node->name = (char*)malloc(strlen(name) + 1);
+        if(node->name == NULL){
+            print_error(200, NULL, NULL);
+        }
+        strcpy(node->name, name);
+        node->terminal = true;
+        trie->count++;
+    }
+    node->weight = weight;
+    refresh_prefixTrie_path(path, length);
+    free(path);
+}
+
+/**
+ * @brief Suma un valor al peso de un nombre del trie
+ *
+ * @param trie Trie de nombres
+ * @param name Nombre a modificar (si no esta en el trie no se hace nada)
+ * @param delta Valor a sumar
+*/
+void add_prefixTrie_weight(PrefixTrie trie, const char* name, int delta)
+{
+    TrieNode** path = (TrieNode**)malloc(sizeof(TrieNode*) * (strlen(name) + 1));
+    if(path == NULL){
+        print_error(200, NULL, NULL);
+    }
+    int length = walk_prefixTrie(trie, name, false, path);
+    if(length == (int)strlen(name) + 1 && path[length - 1]->terminal){
+        path[length - 1]->weight += delta;
+        refresh_prefixTrie_path(path, length);
+    }
+    free(path);
+}
+
+/**
+ * @brief Quita un nombre del trie
+ *
+ * @param trie Trie de nombres
+ * @param name Nombre a quitar
+ * @note Los nodos del camino se conservan, solo dejan de tener nombres
+*/
+void remove_prefixTrie_name(PrefixTrie trie, const char* name)
+{
+    TrieNode** path = (TrieNode**)malloc(sizeof(TrieNode*) * (strlen(name) + 1));
+    if(path == NULL){
+        print_error(200, NULL, NULL);
+    }
+    int length = walk_prefixTrie(trie, name, false, path);
+    if(length == (int)strlen(name) + 1 && path[length - 1]->terminal){
+        TrieNode* node = path[length - 1];
+        free(node->name);
+        node->name = NULL;
+        node->terminal = false;
+        node->weight = 0;
+        trie->count--;
+        refresh_prefixTrie_path(path, length);
+    }
+    free(path);
+}
+
+/**
+ * @brief Obtiene los nombres de mayor peso que comienzan con un prefijo, sin distinguir mayusculas
+ *
+ * @param trie Trie de nombres
+ * @param prefix Prefijo buscado
+ * @param names Arreglo de TRIE_COMPLETIONS elementos donde se guardan los nombres (pertenecen al trie)
+ * @param weights Arreglo de TRIE_COMPLETIONS elementos donde se guardan los pesos (puede ser NULL)
+ * @return Cantidad de nombres, ordenados de mayor a menor peso
+ * @note Costo O(largo del prefijo), independiente de la cantidad de nombres
+*/
+int complete_prefixTrie(PrefixTrie trie, const char* prefix, const char** names, int* weights)
+{
+    TrieNode* node = trie->root;
+    for(int i=0; prefix[i] != '\0' && node != NULL; i++){
+        node = find_trieNode_child(node, (char)tolower((unsigned char)prefix[i]), false);
+    }
+    if(node == NULL){
+        return 0;
+    }
+    for(int i=0; i<node->topCount; i++){
+        names[i] = node->top[i]->name;
+        if(weights){
+            weights[i] = node->top[i]->weight;
+        }
+    }
+    return node->topCount;
+}
+
+// Funciones de interaccion con el usuario
+
+/**
+ * @brief Muestra los nombres que completan o se parecen a uno que no se encontro y permite elegir uno
+ *
+ * Primero se muestran los nombres mas usados que comienzan con @p name y luego los parecidos segun sus trigramas
+ * que no aparecieron antes.
+ *
+ * @param trie Trie de nombres
+ * @param trigrams Indice de trigramas de los mismos nombres
+ * @param name Nombre que no se encontro
+ * @return Nombre elegido (pertenece al trie o al indice), NULL si no hay sugerencias o no se eligio ninguna
+*/
+const char* ask_name_suggestion(PrefixTrie trie, TrigramIndex trigrams, const char* name)
+{
+    const char* names[TRIE_COMPLETIONS + TRIGRAM_SUGGESTIONS];
+    int weights[TRIE_COMPLETIONS];
+    int completions = complete_prefixTrie(trie, name, names, weights);
+
+    int IDs[TRIGRAM_SUGGESTIONS];
+    double scores[TRIGRAM_SUGGESTIONS];
+    int similar = search_trigramIndex(trigrams, name, TRIGRAM_SUGGESTIONS, IDs, scores);
+    int count = completions;
+    for(int i=0; i<similar; i++){
+        const char* candidate = get_trigramIndex_name(trigrams, IDs[i]);
+        bool repeated = false;
+        for(int j=0; j<completions; j++){
+            repeated = repeated || strcmp(names[j], candidate) == 0;
+        }
+        if(!repeated){
+            scores[count - completions] = scores[i];
+            names[count++] = candidate;
+        }
+    }
+    if(count == 0){
+        return NULL;
+    }
+
+    printf("Quiso decir:\n");
+    for(int i=0; i<count; i++){
+        printf("%3d. "ANSI_COLOR_CYAN"%-20s"ANSI_COLOR_RESET, i + 1, names[i]);
+        if(i < completions){
+            printf(" (%d publicaciones)\n", weights[i]);
+        }
+        else{
+            printf(" (%.0f%% similar)\n", 100*scores[i - completions]);
+        }
+    }
+    int option;
+    printf("Ingrese el numero de la sugerencia (0: ninguna): ");
+    if(scanf("%d", &option) != 1){
+        print_error(103, NULL, NULL);
+        return NULL;
+    }
+    if(option < 1 || option > count){
+        return NULL;
+    }
+    return names[option - 1];
+}
+
+// Funciones auxiliares
+
+/**
+ * @brief Indica si un nombre va antes que otro en las sugerencias: mayor peso primero y, a igual peso, orden alfabetico
+ *
+ * @param a Nodo terminal del primer nombre
+ * @param b Nodo terminal del segundo nombre
+ * @return TRUE si @p a va antes que @p b
+*/
+bool trieNode_ranks_before(TrieNode* a, TrieNode* b)
+{
+    if(a->weight != b->weight){
+        return a->weight > b->weight;
+    }
+    return strcmp(a->name, b->name) < 0;
+}
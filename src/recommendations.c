@@ -0,0 +1,408 @@
+/**
+ * @file recommendations.c
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Calculo de recomendaciones de amistad, en linea o precalculadas para toda la red
+*/
+#include "recommendations.h"
+
+// Funciones de calculo de recomendaciones
+
+/**
+ * @brief Obtiene los pesos por defecto del coeficiente de recomendacion
+ *
+ * @return Pesos RECS_*_WEIGHT y RECS_AGE_DECAY
+*/
+RecommendationWeights default_recommendation_weights()
+{
+    RecommendationWeights weights;
+    weights.age = RECS_AGE_WEIGHT;
+    weights.ageDecay = RECS_AGE_DECAY;
+    weights.genres = RECS_GENRES_WEIGHT;
+    weights.bands = RECS_BANDS_WEIGHT;
+    weights.mutual = RECS_MUTUAL_WEIGHT;
+    weights.adamicAdar = RECS_ADAMIC_ADAR_WEIGHT;
+    weights.resourceAllocation = RECS_RESOURCE_WEIGHT;
+    return weights;
+}
+
+/**
+ * @brief Lleva una medida no negativa y sin cota al rango [0, 1)
+ *
+ * @param value Medida a acotar
+ * @return value / (1 + value)
+*/
+double saturate_signal(double value)
+{
+    return value / (1.0 + value);
+}
+
+/**
+ * @brief Calcula el coeficiente de recomendacion entre un usuario y un candidato
+ *
+ * Con los pesos por defecto se calcula como sigue:
+ *  - Un 15% del valor dado por la diferencia de edades
+ *  - Un 30% del valor dado por el indice de Jaccard entre los generos de ambos usuarios
+ *  - Un 30% del valor dado por el indice de Jaccard entre las bandas de ambos usuarios
+ *  - Un 10% por los amigos en comun, un 10% por el indice de Adamic-Adar y un 5% por el de asignacion de recursos,
+ *    cada uno acotado con `saturate_signal`
+ * Esto da un maximo del indice de 1.0
+ *
+ * @param user Usuario al que se le recomienda
+ * @param candidate Usuario recomendado
+ * @param graph Grafo de amistades
+ * @param weights Pesos de cada componente
+ * @return Coeficiente de la recomendacion
+ * @warning Ambos usuarios deben tener sus conjuntos de gustos construidos (ver `prepare_recommendation_candidates`),
+ * asi la funcion solo lee memoria y puede llamarse desde varios hilos a la vez
+*/
+double recommendation_coefficient(UserPosition user, UserPosition candidate, FriendGraph graph, RecommendationWeights weights)
+{
+    GraphSignals signals = friendGraph_signals(graph, user->ID, candidate->ID);
+    double coefficient = 0;
+    coefficient += weights.age * exp(-weights.ageDecay * abs(user->age - candidate->age)); // Coeficiente de edad (Lo tomamos como una variable aleatoria de tipo exponencial)
+    coefficient += weights.genres * jacardIndex_bitmap(user->genreSet, candidate->genreSet);
+    coefficient += weights.bands * jacardIndex_bitmap(user->bandSet, candidate->bandSet);
+    coefficient += weights.mutual * saturate_signal(signals.mutualFriends);
+    coefficient += weights.adamicAdar * saturate_signal(signals.adamicAdar);
+    coefficient += weights.resourceAllocation * saturate_signal(signals.resourceAllocation);
+    return coefficient;
+}
+
+/**
+ * @brief Carga todo lo necesario para puntuar a los candidatos de un usuario
+ *
+ * Completa los enlaces, lee los perfiles desde sus archivos y construye los conjuntos de gustos. Todo esto modifica
+ * estructuras compartidas, por lo que se hace en un solo hilo antes de puntuar.
+ *
+ * @param user Usuario al que se le recomienda
+ * @param candidates Lista de candidatos
+ * @param table Tabla de usuarios
+ * @return Cantidad de candidatos
+*/
+int prepare_recommendation_candidates(UserPosition user, UserLinkList candidates, UserTable table)
+{
+    int count = 0;
+    complete_user_tasteSets(user, table);
+    for(UserLinkPosition aux = candidates->next; aux != NULL; aux = aux->next){
+        if(aux->userNode == NULL){
+            complete_userLinkList_node(aux, table);
+        }
+        if(aux->userNode){
+            complete_user_tasteSets(aux->userNode, table);
+        }
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Tarea del pool de hilos: puntua un bloque de candidatos
+ *
+ * Los coeficientes se calculan en el scratch del hilo y se copian al arreglo compartido al final del bloque, para
+ * que los hilos no escriban en las mismas lineas de cache mientras calculan.
+ *
+ * @param arg Puntero al ScoreJob
+ * @param worker Indice del hilo
+ * @param first Primer candidato del bloque
+ * @param last Candidato siguiente al ultimo del bloque
+*/
+void score_recommendations_task(void* arg, int worker, int first, int last)
+{
+    ScoreJob* job = (ScoreJob*)arg;
+    double* local = (double*)get_threadPool_scratch(job->pool, worker, sizeof(double) * (last - first));
+    for(int i=first; i<last; i++){
+        local[i - first] = job->candidates[i] ? recommendation_coefficient(job->user, job->candidates[i], job->graph, job->weights) : 0;
+    }
+    memcpy(&job->coefficients[first], local, sizeof(double) * (last - first));
+}
+
+/**
+ * @brief Calcula el coeficiente de cada candidato y lo guarda en su campo coefficient
+ *
+ * Con al menos RECS_PARALLEL_MIN candidatos el calculo se reparte entre los hilos de @p pool.
+ *
+ * @param user Usuario al que se le recomienda
+ * @param candidates Lista de candidatos
+ * @param weights Pesos del coeficiente
+ * @param table Tabla de usuarios
+ * @param pool Pool de hilos, NULL para puntuar en el hilo actual (por ejemplo, desde una tarea de otro pool)
+*/
+void score_recommendations(UserPosition user, UserLinkList candidates, RecommendationWeights weights, UserTable table, ThreadPool pool)
+{
+    int count = prepare_recommendation_candidates(user, candidates, table);
+    FriendGraph graph = get_friendGraph(table);
+    if(pool == NULL || pool->threadCount < 2 || count < RECS_PARALLEL_MIN){
+        for(UserLinkPosition aux = candidates->next; aux != NULL; aux = aux->next){
+            aux->coefficient = aux->userNode ? recommendation_coefficient(user, aux->userNode, graph, weights) : 0;
+        }
+        return;
+    }
+
+    ScoreJob job;
+    job.user = user;
+    job.graph = graph;
+    job.weights = weights;
+    job.pool = pool;
+    job.candidates = (UserPosition*)malloc(sizeof(UserPosition) * count);
+    job.coefficients = (double*)malloc(sizeof(double) * count);
+    if(job.candidates == NULL || job.coefficients == NULL){
+        print_error(200, NULL, NULL);
+    }
+    int i = 0;
+    for(UserLinkPosition aux = candidates->next; aux != NULL; aux = aux->next){
+        job.candidates[i++] = aux->userNode;
+    }
+
+    run_threadPool(pool, score_recommendations_task, &job, count, 0);
+
+    // Devolvemos los coeficientes a la lista
+    i = 0;
+    for(UserLinkPosition aux = candidates->next; aux != NULL; aux = aux->next){
+        aux->coefficient = job.coefficients[i++];
+    }
+    free(job.candidates);
+    free(job.coefficients);
+}
+
+/**
+ * @brief Deja en una lista de candidatos puntuados solo los @p k de mayor coeficiente, ordenados de mayor a menor
+ *
+ * Los nodos se pasan por un heap acotado de @p k elementos y los que quedan fuera se liberan al momento,
+ * por lo que el costo es O(n log k) en vez de ordenar toda la lista.
+ *
+ * @param candidates Lista de candidatos con su coeficiente calculado
+ * @param k Cantidad de candidatos a conservar
+*/
+void select_top_recommendations(UserLinkList candidates, int k)
+{
+    ScoreHeap heap = create_scoreHeap(k);
+    UserLinkPosition aux = candidates->next;
+    candidates->next = NULL;
+    while(aux != NULL){
+        UserLinkPosition node = aux;
+        aux = aux->next;
+        node->next = NULL;
+
+        // Si el heap esta lleno, el nodo con menor coeficiente sale del heap para siempre
+        UserLinkPosition discarded = node;
+        if(!is_full_scoreHeap(heap) || node->coefficient > scoreHeap_min(heap)){
+            discarded = is_full_scoreHeap(heap) ? (UserLinkPosition)heap->entries[0].data : NULL;
+            push_scoreHeap(heap, node->coefficient, node);
+        }
+        if(discarded != NULL){
+            free(discarded->userName);
+            free(discarded);
+        }
+    }
+
+    // Volvemos a enlazar los nodos conservados, de mayor a menor coeficiente
+    int size = sort_scoreHeap(heap);
+    UserLinkPosition last = candidates;
+    for(int i=0; i<size; i++){
+        last->next = (UserLinkPosition)heap->entries[i].data;
+        last = last->next;
+    }
+    delete_scoreHeap(heap);
+}
+
+/**
+ * @brief Busca y puntua las recomendaciones de amistad de un usuario
+ *
+ * @param user Usuario al que se le recomienda
+ * @param table Tabla de usuarios
+ * @param pool Pool de hilos para puntuar en paralelo, NULL para hacerlo en el hilo actual
+ * @param k Cantidad de recomendaciones a entregar
+ * @return Lista con las @p k mejores recomendaciones, ordenada de mayor a menor coeficiente
+*/
+UserLinkList compute_user_recommendations(UserPosition user, UserTable table, ThreadPool pool, int k)
+{
+    complete_user_from_json(user);
+    UserLinkList possibleFriends = find_possible_friends(user, table, FRIENDS_SEARCH_DEPTH);
+    score_recommendations(user, possibleFriends, default_recommendation_weights(), table, pool);
+    select_top_recommendations(possibleFriends, k);
+    return possibleFriends;
+}
+
+// Funciones de recomendaciones precalculadas
+
+/**
+ * @brief Deja listas las estructuras compartidas para que las recomendaciones se calculen en paralelo
+ *
+ * El precalculo recorre a todos los usuarios, asi que cada uno se completa desde su perfil aqui y no desde un hilo:
+ * completar un perfil descarta sus conjuntos de gustos, que otro hilo podria estar leyendo como candidato. Luego se
+ * construyen el grafo de amistades y el indice de gustos, y calcular recomendaciones solo lee la tabla de usuarios.
+ *
+ * @param table Tabla de usuarios
+*/
+void prepare_recommendations(UserTable table)
+{
+    for(int ID=0; ID<table->idCount; ID++){
+        if(table->usersByID[ID]){
+            complete_user_tasteSets(complete_user_from_json(table->usersByID[ID]), table);
+        }
+    }
+    get_friendGraph(table);
+    get_tasteIndex(table);
+}
+
+/**
+ * @brief Tarea del pool de hilos: calcula y guarda las recomendaciones de un bloque de usuarios
+ *
+ * @param arg Puntero al RecsJob
+ * @param worker Indice del hilo
+ * @param first Primer ID del bloque
+ * @param last ID siguiente al ultimo del bloque
+*/
+void precompute_recommendations_task(void* arg, int worker, int first, int last)
+{
+    RecsJob* job = (RecsJob*)arg;
+    for(int ID = first; ID < last; ID++){
+        UserPosition user = job->table->usersByID[ID];
+        if(user == NULL){
+            continue;
+        }
+        // Cada hilo ya es parte del pool, los candidatos se puntuan en el mismo hilo
+        UserLinkList recommendations = compute_user_recommendations(user, job->table, NULL, job->k);
+        if(save_user_recommendations(user, recommendations, job->k, job->computedAt, job->table->version)){
+            job->written[worker]++;
+        }
+        delete_userLinkList(recommendations);
+    }
+}
+
+/**
+ * @brief Precalcula las recomendaciones de todos los usuarios de la red y las guarda en RECS_PATH
+ *
+ * @param table Tabla de usuarios (se usa su pool de hilos)
+ * @param k Cantidad de recomendaciones a guardar por usuario
+ * @return Cantidad de usuarios cuyas recomendaciones se guardaron
+*/
+int precompute_recommendations(UserTable table, int k)
+{
+    mkdir(RECS_PATH, 0755);
+    prepare_recommendations(table);
+
+    ThreadPool pool = get_userTable_threadPool(table);
+    RecsJob job;
+    job.table = table;
+    job.k = k;
+    job.computedAt = time(NULL);
+    job.written = (int*)calloc(pool->threadCount, sizeof(int));
+    if(job.written == NULL){
+        print_error(200, NULL, NULL);
+    }
+
+    // Bloques pequeños: el costo por usuario varia mucho segun su cantidad de candidatos
+    run_threadPool(pool, precompute_recommendations_task, &job, table->idCount, 8);
+
+    int written = 0;
+    for(int i=0; i<pool->threadCount; i++){
+        written += job.written[i];
+    }
+    free(job.written);
+    return written;
+}
+
+/**
+ * @brief Guarda las primeras @p k recomendaciones de un usuario en su archivo de recomendaciones
+ *
+ * El archivo tiene una linea de cabecera "<momento del calculo> <version de la red> <cantidad>" seguida de una linea
+ * "<coeficiente> <usuario>" por recomendacion.
+ *
+ * @param user Usuario dueño de las recomendaciones
+ * @param recommendations Lista de recomendaciones ordenada
+ * @param k Cantidad maxima de recomendaciones a guardar
+ * @param computedAt Momento en que se calcularon las recomendaciones
+ * @param version Version de la red con que se calcularon (ver `user_version_hash`)
+ * @return TRUE si el archivo se escribio, FALSE en caso contrario
+*/
+bool save_user_recommendations(UserPosition user, UserLinkList recommendations, int k, time_t computedAt, uint64_t version)
+{
+    char filePath[200];
+    snprintf(filePath, 200, RECS_PATH"%s.recs", user->username);
+    FILE* file = fopen(filePath, "w");
+    if(file == NULL){
+        print_error(100, filePath, NULL);
+        return false;
+    }
+
+    int count = 0;
+    for(UserLinkPosition aux = recommendations->next; aux != NULL && count < k; aux = aux->next){
+        count++;
+    }
+    fprintf(file, "%ld %llx %d\n", (long)computedAt, (unsigned long long)version, count);
+    UserLinkPosition aux = recommendations->next;
+    for(int i=0; i<count; i++){
+        fprintf(file, "%.6f %s\n", aux->coefficient, aux->userName);
+        aux = aux->next;
+    }
+    fclose(file);
+    return true;
+}
+
+/**
+ * @brief Indica si una recomendacion precalculada ya no es valida
+ *
+ * Se compara la version de la red y no la fecha de users.json, que se reescribe aunque la red no cambie.
+ *
+ * @param computedAt Momento en que se calculo la recomendacion
+ * @param version Version de la red con que se calculo
+ * @param table Tabla de usuarios
+ * @return TRUE si supera RECS_MAX_AGE o si la red cambio (usuarios o amistades) despues de calcularla
+*/
+bool is_stale_recommendation(time_t computedAt, uint64_t version, UserTable table)
+{
+    if(time(NULL) - computedAt > RECS_MAX_AGE){
+        return true;
+    }
+    return version != table->version;
+}
+
+/**
+ * @brief Lee las recomendaciones precalculadas de un usuario
+ *
+ * Solo se leen @p k lineas y se cargan los perfiles de esos usuarios, por lo que el costo es O(k).
+ * Se omiten los usuarios que ya no existen o que se hicieron amigos en esta sesion.
+ *
+ * @param user Usuario dueño de las recomendaciones
+ * @param table Tabla de usuarios
+ * @param k Cantidad maxima de recomendaciones a leer
+ * @return Lista de recomendaciones ordenada, NULL si no hay recomendaciones precalculadas vigentes
+*/
+UserLinkList load_user_recommendations(UserPosition user, UserTable table, int k)
+{
+    char filePath[200];
+    snprintf(filePath, 200, RECS_PATH"%s.recs", user->username);
+    FILE* file = fopen(filePath, "r");
+    if(file == NULL){
+        return NULL;
+    }
+
+    long computedAt;
+    unsigned long long version;
+    int count;
+    if(fscanf(file, "%ld %llx %d", &computedAt, &version, &count) != 3 || is_stale_recommendation((time_t)computedAt, (uint64_t)version, table)){
+        fclose(file);
+        return NULL;
+    }
+
+    complete_user_from_json(user);
+    UserLinkList recommendations = create_empty_userLinkList(NULL);
+    UserLinkPosition last = recommendations;
+    double coefficient;
+    char userName[200];
+    for(int i=0; i<count && i<k; i++){
+        if(fscanf(file, "%lf %199s", &coefficient, userName) != 2){
+            break;
+        }
+        UserPosition candidate = find_userTable_node(table, userName);
+        if(candidate == NULL || candidate == user || find_userLinkList_node(user->friends, userName)){
+            continue;
+        }
+        complete_user_from_json(candidate);
+        last = insert_userLinkList_node_completeInfo(last, candidate);
+        last->coefficient = coefficient;
+    }
+    fclose(file);
+    return recommendations;
+}
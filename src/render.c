@@ -0,0 +1,223 @@
+/**
+ * @file render.c
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Armado de pantallas en un buffer reutilizable que se escribe con una sola llamada a write
+*/
+#include "render.h"
+
+// Funciones del buffer de pantalla
+
+/**
+ * @brief Crea un buffer de pantalla vacio
+ *
+ * @param fd Descriptor donde se escribira la pantalla (normalmente STDOUT_FILENO), o -1 para un buffer que solo se
+ * arma en memoria y lo escribe quien lo usa
+ * @return Puntero al buffer creado
+*/
+RenderBuffer create_renderBuffer(int fd)
+{
+    RenderBuffer buffer = (RenderBuffer)malloc(sizeof(struct _renderBuffer));
+    if(buffer == NULL){
+        print_error(200, NULL, NULL);
+    }
+    buffer->data = (char*)malloc(RENDER_BUFFER_SIZE);
+    if(buffer->data == NULL){
+        print_error(200, NULL, NULL);
+    }
+    buffer->size = 0;
+    buffer->capacity = RENDER_BUFFER_SIZE;
+    buffer->fd = fd;
+    return buffer;
+}
+
+/**
+ * @brief Escribe lo que quede pendiente en un buffer y lo borra
+ *
+ * @param buffer Buffer a borrar
+*/
+void delete_renderBuffer(RenderBuffer buffer)
+{
+    if(buffer == NULL){
+        return;
+    }
+    flush_renderBuffer(buffer);
+    free(buffer->data);
+    free(buffer);
+}
+
+/**
+ * @brief Reserva espacio al final del buffer
+ *
+ * Si el buffer ya supera RENDER_FLUSH_LIMIT se escribe antes de crecer, asi una pantalla muy larga usa memoria
+ * acotada y se escribe en pocos bloques grandes.
+ *
+ * @param buffer Buffer de pantalla
+ * @param length Cantidad de bytes a reservar
+ * @return Puntero al espacio reservado (aun no se cuenta como usado)
+*/
+char* reserve_renderBuffer(RenderBuffer buffer, size_t length)
+{
+    if(buffer->size + length <= buffer->capacity){
+        return &buffer->data[buffer->size];
+    }
+    if(buffer->fd >= 0 && buffer->size >= RENDER_FLUSH_LIMIT){
+        flush_renderBuffer(buffer);
+        if(length <= buffer->capacity){
+            return buffer->data;
+        }
+    }
+    size_t capacity = buffer->capacity;
+    while(buffer->size + length > capacity){
+        capacity *= 2;
+    }
+    char* data = (char*)realloc(buffer->data, capacity);
+    if(data == NULL){
+        print_error(200, NULL, NULL);
+    }
+    buffer->data = data;
+    buffer->capacity = capacity;
+    return &buffer->data[buffer->size];
+}
+
+/**
+ * @brief Escribe el contenido del buffer en su descriptor y lo deja vacio
+ *
+ * Antes se vacia stdout para que lo impreso con printf no quede despues de la pantalla. Un buffer sin descriptor
+ * (fd -1) no se escribe.
+ *
+ * @param buffer Buffer de pantalla
+*/
+void flush_renderBuffer(RenderBuffer buffer)
+{
+    if(buffer->size == 0 || buffer->fd < 0){
+        return;
+    }
+    fflush(stdout);
+    size_t written = 0;
+    while(written < buffer->size){
+        ssize_t result = write(buffer->fd, &buffer->data[written], buffer->size - written);
+        if(result < 0){
+            if(errno == EINTR){
+                continue;
+            }
+            print_error(104, NULL, NULL);
+            break;
+        }
+        written += (size_t)result;
+    }
+    buffer->size = 0;
+}
+
+// Funciones de escritura en el buffer
+
+/**
+ * @brief Agrega bytes al buffer
+ *
+ * @param buffer Buffer de pantalla
+ * @param bytes Bytes a agregar
+ * @param length Cantidad de bytes
+*/
+void render_bytes(RenderBuffer buffer, const char* bytes, size_t length)
+{
+    memcpy(reserve_renderBuffer(buffer, length), bytes, length);
+    buffer->size += length;
+}
+
+/**
+ * @brief Agrega un string al buffer (sin su '\0')
+ *
+ * @param buffer Buffer de pantalla
+ * @param string String a agregar
+*/
+void render_string(RenderBuffer buffer, const char* string)
+{
+    render_bytes(buffer, string, strlen(string));
+}
+
+/**
+ * @brief Agrega texto con formato de printf al buffer
+ *
+ * @param buffer Buffer de pantalla
+ * @param format Formato, igual que en printf
+*/
+void render_format(RenderBuffer buffer, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    size_t available = buffer->capacity - buffer->size;
+    int length = vsnprintf(&buffer->data[buffer->size], available, format, args);
+    va_end(args);
+    if(length < 0){
+        return;
+    }
+    if((size_t)length >= available){ // No cabia, se reserva el espacio exacto y se vuelve a escribir
+        char* out = reserve_renderBuffer(buffer, length + 1);
+        va_start(args, format);
+        vsnprintf(out, length + 1, format, args);
+        va_end(args);
+    }
+    buffer->size += length;
+}
+
+/**
+ * @brief Agrega una fecha al buffer en formato YYYY-MM-DD HH:MM:SS ZONA
+ *
+ * La fecha de una publicacion se obtiene de su ID con `comment_ID_to_time`.
+ *
+ * @param buffer Buffer de pantalla
+ * @param time Tiempo a agregar
+*/
+void render_date(RenderBuffer buffer, time_t time)
+{
+    struct tm local;
+    if(localtime_r(&time, &local) == NULL){
+        print_error(102, NULL, NULL);
+        return;
+    }
+    size_t length = strftime(reserve_renderBuffer(buffer, RENDER_DATE_LENGTH), RENDER_DATE_LENGTH, "%Y-%m-%d %H:%M:%S %Z", &local);
+    if(length == 0){
+        print_error(102, NULL, NULL);
+        return;
+    }
+    buffer->size += length;
+}
+
+/**
+ * @brief Agrega un texto de LoopWeb al buffer, resaltando los segmentos que comienzan con '@' y con '#'
+ *
+ * Se recorre el texto original una sola vez, copiando cada tramo completo: los tramos sin etiquetas tal cual, y cada
+ * etiqueta (hasta el siguiente espacio, '@', '#' o salto de linea) entre su color y ANSI_COLOR_RESET. Como en la
+ * version anterior de `print_loopweb`, las palabras quedan separadas por un solo espacio.
+ *
+ * @param buffer Buffer de pantalla
+ * @param text Texto a agregar
+*/
+void render_loopweb(RenderBuffer buffer, const char* text)
+{
+    bool pendingSpace = false, started = false;
+    while(*text){
+        if(*text == ' '){
+            pendingSpace = started;
+            text++;
+            continue;
+        }
+        if(pendingSpace){
+            render_bytes(buffer, " ", 1);
+            pendingSpace = false;
+        }
+        started = true;
+
+        if(*text == '@' || *text == '#'){
+            size_t length = 1 + strcspn(text + 1, " @#\n");
+            render_string(buffer, *text == '@' ? ANSI_COLOR_GREEN : ANSI_COLOR_RED);
+            render_bytes(buffer, text, length);
+            render_string(buffer, ANSI_COLOR_RESET);
+            text += length;
+        }
+        else{
+            size_t length = strcspn(text, " @#");
+            render_bytes(buffer, text, length);
+            text += length;
+        }
+    }
+}
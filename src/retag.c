@@ -0,0 +1,214 @@
+/**
+ * @file retag.c
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Reconstruccion en paralelo de las publicaciones de cada banda y genero a partir del texto de las publicaciones
+*/
+#include "retag.h"
+
+// Funciones de re-etiquetado
+
+/**
+ * @brief Reconstruye las listas de publicaciones de todas las bandas y generos a partir de las etiquetas de los textos
+ *
+ * Las publicaciones se leen de a una desde sus archivos y se etiquetan con `complete_comment_tags`, repartidas en
+ * bloques entre los hilos de @p pool. Cada hilo guarda los enlaces que encuentra en su propio arreglo, sin tocar las
+ * tablas, y al terminar los arreglos se juntan en orden cronologico. Solo se enlazan las bandas y generos que ya
+ * estan en la red. Finalmente se reemplazan los archivos de ambas tablas.
+ *
+ * @param commentsFile Archivo con los IDs de todas las publicaciones
+ * @param bands Tabla de bandas
+ * @param genres Tabla de generos
+ * @param pool Pool de hilos, NULL para leer las publicaciones en el hilo actual
+ * @return Resumen del re-etiquetado
+*/
+RetagStats retag_comments(const char* commentsFile, BandTable bands, GenreTable genres, ThreadPool pool)
+{
+    RetagStats stats;
+    memset(&stats, 0, sizeof(RetagStats));
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    // Solo se usan los IDs, los textos se leen y liberan dentro de cada hilo
+    CommentTable comments = get_comments_from_file(commentsFile, NULL);
+    stats.comments = comments->recentCount;
+    stats.threads = pool ? pool->threadCount : 1;
+
+    RetagJob job;
+    job.IDs = comments->recentIDs;
+    job.bands = bands;
+    job.genres = genres;
+    job.postings = (RetagPostings*)calloc(stats.threads, sizeof(RetagPostings));
+    if(job.postings == NULL){
+        print_error(200, NULL, NULL);
+    }
+    if(stats.comments > 0){
+        if(pool){
+            run_threadPool(pool, retag_comments_task, &job, stats.comments, RETAG_CHUNK);
+        }
+        else{
+            retag_comments_task(&job, 0, 0, stats.comments);
+        }
+    }
+
+    merge_retagPostings(&job, stats.threads, &stats);
+    for(int i=0; i<stats.threads; i++){
+        free(job.postings[i].entries);
+    }
+    free(job.postings);
+    delete_commentTable(comments);
+
+    // Los pesos de las sugerencias cambiaron, se reconstruyen al necesitarse
+    delete_prefixTrie(bands->completions);
+    bands->completions = NULL;
+    delete_prefixTrie(genres->completions);
+    genres->completions = NULL;
+
+    bool bandsSaved = save_bandTable(bands);
+    bool genresSaved = save_genresTable(genres);
+    bands->modified = !bandsSaved;
+    genres->modified = !genresSaved;
+    stats.saved = bandsSaved && genresSaved;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    stats.seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    return stats;
+}
+
+/**
+ * @brief Lee y etiqueta un bloque de publicaciones, guardando los enlaces en los arreglos del hilo
+ *
+ * @param arg Puntero al RetagJob
+ * @param worker Indice del hilo
+ * @param first Primera publicacion del bloque (en orden cronologico)
+ * @param last Publicacion siguiente a la ultima del bloque
+*/
+void retag_comments_task(void* arg, int worker, int first, int last)
+{
+    RetagJob* job = (RetagJob*)arg;
+    RetagPostings* postings = &job->postings[worker];
+    for(int i=first; i<last; i++){
+        CommentPosition comment = create_new_comment(job->IDs[i], "NULL", "NULL");
+        complete_comment_from_json(comment); // Lee el texto y llama a complete_comment_tags
+        if(!comment->complete){
+            delete_commentNode(comment);
+            continue;
+        }
+        postings->read++;
+
+        for(BandLinkPosition aux = comment->bands->next; aux != NULL; aux = aux->next){
+            BandPosition band = find_bandTable_band(aux->band, job->bands);
+            if(band == NULL){
+                postings->unknown++;
+                continue;
+            }
+            postings->bandLinks += insert_retagPostings_entry(postings, i, &band->comments);
+        }
+        for(GenreLinkPosition aux = comment->genres->next; aux != NULL; aux = aux->next){
+            GenrePosition genre = find_genresTable_genre(aux->genre, job->genres);
+            if(genre == NULL){
+                postings->unknown++;
+                continue;
+            }
+            postings->genreLinks += insert_retagPostings_entry(postings, i, &genre->comments);
+        }
+        delete_commentNode(comment);
+    }
+}
+
+/**
+ * @brief Agrega un enlace al arreglo de un hilo, si la publicacion no estaba ya enlazada a la misma lista
+ *
+ * @param postings Enlaces del hilo
+ * @param position Posicion de la publicacion en el orden cronologico
+ * @param list Lista de publicaciones de la banda o genero
+ * @return TRUE si se agrego el enlace
+ * @note Los enlaces de una publicacion quedan al final del arreglo, por lo que solo se revisan esos
+*/
+bool insert_retagPostings_entry(RetagPostings* postings, int position, CommentLinkList* list)
+{
+    for(int i=postings->count - 1; i>=0 && postings->entries[i].position == position; i--){
+        if(postings->entries[i].list == list){
+            return false;
+        }
+    }
+    if(postings->count == postings->capacity){
+        int capacity = postings->capacity ? 2*postings->capacity : 64;
+        RetagPosting* entries = (RetagPosting*)realloc(postings->entries, sizeof(RetagPosting) * capacity);
+        if(entries == NULL){
+            print_error(200, NULL, NULL);
+        }
+        postings->entries = entries;
+        postings->capacity = capacity;
+    }
+    postings->entries[postings->count].position = position;
+    postings->entries[postings->count].list = list;
+    postings->count++;
+    return true;
+}
+
+/**
+ * @brief Vacia las listas de publicaciones de las tablas y las llena con los enlaces de todos los hilos
+ *
+ * Los enlaces se ordenan por publicacion y se insertan al inicio de cada lista, por lo que las listas quedan de mas
+ * reciente a mas antigua, igual que al publicar.
+ *
+ * @param job Trabajo terminado
+ * @param threads Cantidad de hilos del trabajo
+ * @param stats Resumen donde se cuentan los enlaces
+*/
+void merge_retagPostings(RetagJob* job, int threads, RetagStats* stats)
+{
+    int total = 0;
+    for(int i=0; i<threads; i++){
+        total += job->postings[i].count;
+        stats->read += job->postings[i].read;
+        stats->unknown += job->postings[i].unknown;
+        stats->bandLinks += job->postings[i].bandLinks;
+        stats->genreLinks += job->postings[i].genreLinks;
+    }
+    RetagPosting* entries = (RetagPosting*)malloc(sizeof(RetagPosting) * (total > 0 ? total : 1));
+    if(entries == NULL){
+        print_error(200, NULL, NULL);
+    }
+    int count = 0;
+    for(int i=0; i<threads; i++){
+        if(job->postings[i].count > 0){
+            memcpy(&entries[count], job->postings[i].entries, sizeof(RetagPosting) * job->postings[i].count);
+            count += job->postings[i].count;
+        }
+    }
+    qsort(entries, count, sizeof(RetagPosting), compare_retagPostings);
+
+    for(int i=0; i<BANDS_TABLE_SIZE; i++){
+        for(BandPosition band = job->bands->buckets[i]->next; band != NULL; band = band->next){
+            band->comments = create_empty_commentLinkList(band->comments);
+        }
+    }
+    for(int i=0; i<GENRE_TABLE_SIZE; i++){
+        for(GenrePosition genre = job->genres->buckets[i]->next; genre != NULL; genre = genre->next){
+            genre->comments = create_empty_commentLinkList(genre->comments);
+        }
+    }
+
+    // Los campos comments se leen recien ahora, despues de recrear las listas
+    for(int i=0; i<count; i++){
+        insert_commentLinkList_node_basicInfo(*entries[i].list, job->IDs[entries[i].position]);
+    }
+    free(entries);
+}
+
+// Funciones auxiliares
+
+/**
+ * @brief Compara dos enlaces pendientes por la posicion de su publicacion (para qsort)
+ *
+ * @param a Primer enlace
+ * @param b Segundo enlace
+ * @return Negativo, cero o positivo si @p a va antes, junto o despues de @p b
+*/
+int compare_retagPostings(const void* a, const void* b)
+{
+    int positionA = ((const RetagPosting*)a)->position;
+    int positionB = ((const RetagPosting*)b)->position;
+    return (positionA > positionB) - (positionA < positionB);
+}
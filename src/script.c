@@ -0,0 +1,492 @@
+/**
+ * @file script.c
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Modo de comandos sin interaccion: ejecuta un archivo (o la entrada estandar) con una accion por linea
+ *
+ * Cada linea tiene la forma "<verbo> <argumentos>":
+ *  - post <usuario> <texto>: publica un comentario
+ *  - befriend <usuario> <usuario>: crea una amistad
+ *  - feed <usuario> [n]: muestra las n publicaciones mas recientes del feed
+ *  - recs <usuario> [k]: muestra k recomendaciones de amistad
+ *  - profile <usuario>: muestra el perfil
+ *  - save: guarda todo lo modificado hasta el momento
+ * Las lineas vacias y las que comienzan con '#' se ignoran. Cada comando responde con una linea "ok ..." (seguida
+ * de sus resultados) o "err <linea> <mensaje>".
+ *
+ * Una misma sesion se puede usar desde varios hilos (ver server.c): cada comando toma los candados de lectores y
+ * escritores de las cuatro tablas, siempre en el orden usuarios, bandas, generos, comentarios. feed, recs y profile
+ * solo leen, asi que se ejecutan en paralelo; post, befriend y save esperan a tener las tablas que cambian solo
+ * para ellos.
+*/
+#include "script.h"
+
+// Funciones de la sesion
+
+/**
+ * @brief Carga todas las tablas de LoopWeb para una sesion de comandos
+ *
+ * @return Sesion creada
+*/
+ScriptSession create_scriptSession()
+{
+    ScriptSession session = (ScriptSession)malloc(sizeof(struct _scriptSession));
+    if(session == NULL){
+        print_error(200, NULL, NULL);
+    }
+    session->users = get_users_from_file(USERS_PATH"users.json", NULL);
+    session->bands = get_bands_from_file(BANDS_FILE, NULL);
+    session->genres = get_genres_from_file(GENRES_FILE, NULL);
+    session->comments = get_comments_from_file(COMMENTS_PATH"comments.json", NULL);
+    session->pending = create_empty_commentLinkList(NULL);
+    session->commands = 0;
+    session->failures = 0;
+    return session;
+}
+
+/**
+ * @brief Guarda todo lo que se modifico en una sesion: publicaciones nuevas, perfiles y tablas
+ *
+ * Toma las cuatro tablas como escritor mientras guarda.
+ *
+ * @param session Sesion de comandos
+*/
+void save_scriptSession(ScriptSession session)
+{
+    lock_scriptSession(session, SCRIPT_LOCK_ALL);
+    for(CommentLinkPosition aux = session->pending->next; aux != NULL; aux = aux->next){
+        save_commentNode(aux->commentNode);
+    }
+    session->pending = create_empty_commentLinkList(session->pending);
+    save_modified_users(session->users);
+
+    if(session->bands->modified && save_bandTable(session->bands))
+        session->bands->modified = false;
+    if(session->genres->modified && save_genresTable(session->genres))
+        session->genres->modified = false;
+    if(session->comments->modified){
+        save_commentTable(session->comments);
+        session->comments->modified = false;
+    }
+    if(session->users->modified){
+        save_userTable(session->users);
+        session->users->modified = false;
+    }
+    if(session->users->popularity && session->users->popularity->modified)
+        save_popularity(session->users->popularity, session->users);
+    unlock_scriptSession(session);
+}
+
+/**
+ * @brief Toma los candados de las cuatro tablas de una sesion, en orden fijo para que dos comandos no se bloqueen
+ * mutuamente
+ *
+ * @param session Sesion de comandos
+ * @param writes Tablas que se toman como escritor (SCRIPT_LOCK_*); el resto se toma como lector
+*/
+void lock_scriptSession(ScriptSession session, int writes)
+{
+    lock_table(&session->users->lock, writes & SCRIPT_LOCK_USERS);
+    lock_table(&session->bands->lock, writes & SCRIPT_LOCK_BANDS);
+    lock_table(&session->genres->lock, writes & SCRIPT_LOCK_GENRES);
+    lock_table(&session->comments->lock, writes & SCRIPT_LOCK_COMMENTS);
+}
+
+/**
+ * @brief Suelta los candados de las cuatro tablas de una sesion
+ *
+ * @param session Sesion de comandos
+*/
+void unlock_scriptSession(ScriptSession session)
+{
+    pthread_rwlock_unlock(&session->comments->lock);
+    pthread_rwlock_unlock(&session->genres->lock);
+    pthread_rwlock_unlock(&session->bands->lock);
+    pthread_rwlock_unlock(&session->users->lock);
+}
+
+/**
+ * @brief Guarda lo pendiente de una sesion y borra sus tablas
+ *
+ * @param session Sesion a borrar
+*/
+void delete_scriptSession(ScriptSession session)
+{
+    if(session == NULL){
+        return;
+    }
+    save_scriptSession(session);
+    delete_commentLinkList(session->pending);
+    delete_bandTable(session->bands);
+    delete_genresTable(session->genres);
+    delete_commentTable(session->comments);
+    delete_userTable(session->users);
+    free(session);
+}
+
+// Funciones de ejecucion de comandos
+
+/**
+ * @brief Ejecuta todas las lineas de un archivo de comandos
+ *
+ * @param session Sesion de comandos
+ * @param input Archivo de comandos (puede ser stdin)
+ * @param out Buffer donde se escriben las respuestas
+ * @return Cantidad de comandos ejecutados
+*/
+int run_script(ScriptSession session, FILE* input, RenderBuffer out)
+{
+    char line[SCRIPT_LINE_LENGTH + 2];
+    int lineNumber = 0, executed = 0;
+    while(fgets(line, sizeof(line), input) != NULL){
+        lineNumber++;
+        size_t length = strlen(line);
+        if(length > 0 && line[length - 1] != '\n' && !feof(input)){ // La linea no cabe, se descarta el resto
+            int c;
+            while((c = fgetc(input)) != '\n' && c != EOF);
+            script_error(lineNumber, "linea demasiado larga", NULL, out);
+            session->failures++;
+            continue;
+        }
+        if(execute_script_command(session, line, lineNumber, out)){
+            executed++;
+        }
+    }
+    return executed;
+}
+
+/**
+ * @brief Ejecuta una linea de comandos
+ *
+ * @param session Sesion de comandos
+ * @param line Linea a ejecutar (se modifica al separar sus palabras)
+ * @param lineNumber Numero de la linea, para los mensajes de error
+ * @param out Buffer donde se escribe la respuesta
+ * @return TRUE si la linea tenia un comando (correcto o no), FALSE si estaba vacia o era un comentario
+*/
+bool execute_script_command(ScriptSession session, char* line, int lineNumber, RenderBuffer out)
+{
+    line[strcspn(line, "\r\n")] = '\0';
+    char* cursor = line;
+    char* verb = next_script_word(&cursor);
+    if(verb == NULL || verb[0] == '#'){
+        return false;
+    }
+
+    bool ok;
+    if(strcmp(verb, "post") == 0){
+        lock_scriptSession(session, SCRIPT_LOCK_ALL);
+        ok = script_post(session, cursor, lineNumber, out);
+        unlock_scriptSession(session);
+    }
+    else if(strcmp(verb, "befriend") == 0){
+        lock_scriptSession(session, SCRIPT_LOCK_USERS);
+        ok = script_befriend(session, cursor, lineNumber, out);
+        unlock_scriptSession(session);
+    }
+    else if(strcmp(verb, "feed") == 0){
+        lock_scriptSession(session, 0);
+        ok = script_feed(session, cursor, lineNumber, out);
+        unlock_scriptSession(session);
+    }
+    else if(strcmp(verb, "recs") == 0){
+        lock_scriptSession(session, 0);
+        ok = script_recs(session, cursor, lineNumber, out);
+        unlock_scriptSession(session);
+    }
+    else if(strcmp(verb, "profile") == 0){
+        lock_scriptSession(session, 0);
+        ok = script_profile(session, cursor, lineNumber, out);
+        unlock_scriptSession(session);
+    }
+    else if(strcmp(verb, "save") == 0){
+        save_scriptSession(session);
+        render_string(out, "ok save\n");
+        ok = true;
+    }
+    else{
+        ok = script_error(lineNumber, "comando desconocido", verb, out);
+    }
+
+    __atomic_fetch_add(&session->commands, 1, __ATOMIC_RELAXED);
+    if(!ok){
+        __atomic_fetch_add(&session->failures, 1, __ATOMIC_RELAXED);
+    }
+    return true;
+}
+
+/**
+ * @brief Comando "post <usuario> <texto>": publica un comentario
+ *
+ * @param session Sesion de comandos
+ * @param arguments Argumentos del comando
+ * @param lineNumber Numero de la linea
+ * @param out Buffer de respuestas
+ * @return TRUE si se publico
+*/
+bool script_post(ScriptSession session, char* arguments, int lineNumber, RenderBuffer out)
+{
+    char* username = next_script_word(&arguments);
+    while(*arguments == ' ' || *arguments == '\t'){
+        arguments++;
+    }
+    if(username == NULL || *arguments == '\0'){
+        return script_error(lineNumber, "uso: post <usuario> <texto>", NULL, out);
+    }
+    if(strlen(arguments) > MAX_COMMENT_LENGTH){
+        return script_error(lineNumber, "texto demasiado largo", NULL, out);
+    }
+    if(strpbrk(arguments, "\"\\") != NULL){ // Los archivos JSON se escriben sin escapar
+        return script_error(lineNumber, "el texto no puede tener comillas ni '\\'", NULL, out);
+    }
+    UserPosition author = find_script_user(session, username, lineNumber, out);
+    if(author == NULL){
+        return false;
+    }
+
+    CommentPosition comment = post_comment(author, arguments, session->bands, session->genres, session->comments, false);
+    insert_commentLinkList_node_completeInfo(session->pending, comment);
+    render_format(out, "ok post %ld\n", (long)comment->ID);
+    return true;
+}
+
+/**
+ * @brief Comando "befriend <usuario> <usuario>": crea una amistad
+ *
+ * @param session Sesion de comandos
+ * @param arguments Argumentos del comando
+ * @param lineNumber Numero de la linea
+ * @param out Buffer de respuestas
+ * @return TRUE si se creo la amistad
+*/
+bool script_befriend(ScriptSession session, char* arguments, int lineNumber, RenderBuffer out)
+{
+    char* first = next_script_word(&arguments);
+    char* second = next_script_word(&arguments);
+    if(first == NULL || second == NULL){
+        return script_error(lineNumber, "uso: befriend <usuario> <usuario>", NULL, out);
+    }
+    UserPosition user = find_script_user(session, first, lineNumber, out);
+    UserPosition other = user ? find_script_user(session, second, lineNumber, out) : NULL;
+    if(other == NULL){
+        return false;
+    }
+    if(!make_friendship(user, other, session->users, false)){
+        return script_error(lineNumber, "ya son amigos o es el mismo usuario", NULL, out);
+    }
+    render_format(out, "ok befriend %s %s\n", user->username, other->username);
+    return true;
+}
+
+/**
+ * @brief Comando "feed <usuario> [n]": muestra las n publicaciones mas recientes del feed de un usuario
+ *
+ * Responde "ok feed <usuario> <cantidad>" seguido de una linea "<ID> <autor> <texto>" por publicacion.
+ *
+ * @param session Sesion de comandos
+ * @param arguments Argumentos del comando
+ * @param lineNumber Numero de la linea
+ * @param out Buffer de respuestas
+ * @return TRUE si el comando era valido
+*/
+bool script_feed(ScriptSession session, char* arguments, int lineNumber, RenderBuffer out)
+{
+    char* username = next_script_word(&arguments);
+    int n = read_script_count(next_script_word(&arguments), SCRIPT_FEED_SIZE);
+    if(username == NULL || n < 0){
+        return script_error(lineNumber, "uso: feed <usuario> [n]", NULL, out);
+    }
+    UserPosition user = find_script_user(session, username, lineNumber, out);
+    if(user == NULL){
+        return false;
+    }
+
+    CommentLinkList feed = get_user_feed(user, session->bands, session->genres, session->comments);
+    sort_commentLinkList_byID(&feed->next);
+    int count = 0;
+    for(CommentLinkPosition aux = feed->next; aux != NULL && count < n; aux = aux->next){
+        count++;
+    }
+    render_format(out, "ok feed %s %d\n", user->username, count);
+    CommentLinkPosition aux = feed->next;
+    for(int i=0; i<count; i++, aux = aux->next){
+        complete_commentLinkList_node(aux, session->comments);
+        complete_comment_from_json(aux->commentNode);
+        render_format(out, "%ld %s %s\n", (long)aux->commentNode->ID, aux->commentNode->user->userName, aux->commentNode->text);
+    }
+    delete_commentLinkList(feed);
+    return true;
+}
+
+/**
+ * @brief Comando "recs <usuario> [k]": muestra las recomendaciones de amistad de un usuario
+ *
+ * Usa las recomendaciones precalculadas si siguen vigentes, igual que el modo usuario. Responde
+ * "ok recs <usuario> <cantidad>" seguido de una linea "<usuario> <coeficiente>" por recomendacion.
+ *
+ * Se llama con las tablas tomadas como lector. Calcularlas construye indices perezosos de la tabla de usuarios y
+ * usa su pool de hilos, asi que en ese caso se cambia a escritor de la tabla de usuarios.
+ *
+ * @param session Sesion de comandos
+ * @param arguments Argumentos del comando
+ * @param lineNumber Numero de la linea
+ * @param out Buffer de respuestas
+ * @return TRUE si el comando era valido
+*/
+bool script_recs(ScriptSession session, char* arguments, int lineNumber, RenderBuffer out)
+{
+    char* username = next_script_word(&arguments);
+    int k = read_script_count(next_script_word(&arguments), RECOMMENDATIONS_SIZE);
+    if(username == NULL || k <= 0){
+        return script_error(lineNumber, "uso: recs <usuario> [k]", NULL, out);
+    }
+    UserPosition user = find_script_user(session, username, lineNumber, out);
+    if(user == NULL){
+        return false;
+    }
+
+    user = complete_user_from_json(user);
+    UserLinkList recommendations = k <= RECOMMENDATIONS_SIZE ? load_user_recommendations(user, session->users, k) : NULL;
+    if(recommendations == NULL){
+        unlock_scriptSession(session); // Los usuarios no se borran en una sesion, user sigue siendo valido
+        lock_scriptSession(session, SCRIPT_LOCK_USERS);
+        recommendations = compute_user_recommendations(user, session->users, get_userTable_threadPool(session->users), k);
+    }
+    int count = 0;
+    for(UserLinkPosition aux = recommendations->next; aux != NULL; aux = aux->next){
+        count++;
+    }
+    render_format(out, "ok recs %s %d\n", user->username, count);
+    for(UserLinkPosition aux = recommendations->next; aux != NULL; aux = aux->next){
+        render_format(out, "%s %.6f\n", aux->userName, aux->coefficient);
+    }
+    delete_userLinkList(recommendations);
+    return true;
+}
+
+/**
+ * @brief Comando "profile <usuario>": muestra el perfil de un usuario
+ *
+ * Responde "ok profile <usuario> <edad> <nacionalidad> <amigos> <publicaciones>" seguido de una linea con la
+ * descripcion.
+ *
+ * @param session Sesion de comandos
+ * @param arguments Argumentos del comando
+ * @param lineNumber Numero de la linea
+ * @param out Buffer de respuestas
+ * @return TRUE si el comando era valido
+*/
+bool script_profile(ScriptSession session, char* arguments, int lineNumber, RenderBuffer out)
+{
+    char* username = next_script_word(&arguments);
+    if(username == NULL){
+        return script_error(lineNumber, "uso: profile <usuario>", NULL, out);
+    }
+    UserPosition user = find_script_user(session, username, lineNumber, out);
+    if(user == NULL){
+        return false;
+    }
+
+    user = complete_user_from_json(user);
+    int friends = 0, comments = 0;
+    for(UserLinkPosition aux = user->friends->next; aux != NULL; aux = aux->next){
+        friends++;
+    }
+    for(CommentLinkPosition aux = user->comments->next; aux != NULL; aux = aux->next){
+        comments++;
+    }
+    render_format(out, "ok profile %s %d %s %d %d\n%s\n", user->username, user->age, user->nationality, friends, comments, user->description);
+    return true;
+}
+
+// Funciones auxiliares
+
+/**
+ * @brief Separa la siguiente palabra de una linea
+ *
+ * @param cursor Posicion actual en la linea, avanza hasta despues de la palabra
+ * @return Palabra encontrada (terminada en '\0' dentro de la linea), NULL si no quedan palabras
+*/
+char* next_script_word(char** cursor)
+{
+    char* word = *cursor + strspn(*cursor, " \t");
+    if(*word == '\0'){
+        *cursor = word;
+        return NULL;
+    }
+    char* end = word + strcspn(word, " \t");
+    *cursor = end;
+    if(*end != '\0'){
+        *end = '\0';
+        *cursor = end + 1;
+    }
+    return word;
+}
+
+/**
+ * @brief Lee un argumento numerico opcional
+ *
+ * @param word Palabra a leer (NULL si se omitio)
+ * @param defaultValue Valor si se omitio
+ * @return Valor leido, @p defaultValue si se omitio o -1 si no es un numero
+*/
+int read_script_count(char* word, int defaultValue)
+{
+    if(word == NULL){
+        return defaultValue;
+    }
+    char* end;
+    long value = strtol(word, &end, 10);
+    if(*end != '\0' || value < 0 || value > 1000000){
+        return -1;
+    }
+    return (int)value;
+}
+
+/**
+ * @brief Busca un usuario de un comando, escribiendo el error si no existe
+ *
+ * @param session Sesion de comandos
+ * @param username Nombre buscado
+ * @param lineNumber Numero de la linea
+ * @param out Buffer de respuestas
+ * @return Usuario encontrado, NULL si no existe
+*/
+UserPosition find_script_user(ScriptSession session, const char* username, int lineNumber, RenderBuffer out)
+{
+    UserPosition user = find_userTable_node(session->users, username);
+    if(user == NULL){
+        script_error(lineNumber, "usuario no encontrado:", username, out);
+    }
+    return user;
+}
+
+/**
+ * @brief Escribe la respuesta de un comando que fallo
+ *
+ * @param lineNumber Numero de la linea
+ * @param message Mensaje de error
+ * @param target Dato que acompaña al mensaje (puede ser NULL)
+ * @param out Buffer de respuestas
+ * @return FALSE, para retornarlo directamente
+*/
+bool script_error(int lineNumber, const char* message, const char* target, RenderBuffer out)
+{
+    render_format(out, "err %d %s%s%s\n", lineNumber, message, target ? " " : "", target ? target : "");
+    return false;
+}
+
+/**
+ * @brief Toma el candado de una tabla
+ *
+ * @param lock Candado de la tabla
+ * @param write TRUE para tomarlo como escritor, FALSE como lector
+*/
+void lock_table(pthread_rwlock_t* lock, bool write)
+{
+    if(write){
+        pthread_rwlock_wrlock(lock);
+    }
+    else{
+        pthread_rwlock_rdlock(lock);
+    }
+}
@@ -0,0 +1,1052 @@
+/**
+ * @file server.c
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Servidor residente de LoopWeb sobre un socket de dominio Unix, su cliente y un generador de carga
+ *
+ * El servidor carga las tablas una sola vez y atiende los mismos comandos del modo script (profile, feed, recs,
+ * post, befriend y save), una linea por solicitud. Cada respuesta se envia como "<largo>\n" seguido de <largo>
+ * bytes, asi el cliente sabe donde termina sin importar el contenido. Las tablas se guardan cada
+ * SERVER_SAVE_INTERVAL segundos y al recibir SIGINT o SIGTERM.
+*/
+#include "server.h"
+
+volatile sig_atomic_t serverStop = 0; /**< Se activa con SIGINT o SIGTERM para que el servidor termine */
+
+/** Nombre de cada tipo de solicitud, en el orden de los histogramas de latencia */
+const char* serverVerbs[SERVER_VERB_COUNT] = {"post", "befriend", "feed", "recs", "profile", "save", "otros"};
+
+// Funciones del servidor
+
+/**
+ * @brief Abre el socket del servidor, carga las tablas de LoopWeb e inicia los trabajadores
+ *
+ * Si en la ruta queda el socket de un servidor que ya no existe, se reemplaza.
+ *
+ * @param path Ruta del socket
+ * @return Servidor creado, NULL si no se pudo abrir el socket
+*/
+Server create_server(const char* path)
+{
+    struct sockaddr_un address;
+    if(strlen(path) >= sizeof(address.sun_path)){
+        print_error(105, (char*)path, "La ruta es demasiado larga");
+        return NULL;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(listenFd < 0){
+        print_error(105, (char*)path, strerror(errno));
+        return NULL;
+    }
+    if(connect(listenFd, (struct sockaddr*)&address, sizeof(address)) == 0){
+        print_error(105, (char*)path, "Ya hay un servidor escuchando en esa ruta");
+        close(listenFd);
+        return NULL;
+    }
+    if(errno == ECONNREFUSED){ // Socket de un servidor que termino sin borrarlo
+        unlink(path);
+    }
+    close(listenFd);
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(listenFd < 0 || bind(listenFd, (struct sockaddr*)&address, sizeof(address)) < 0 || listen(listenFd, SERVER_BACKLOG) < 0 || !set_nonblocking(listenFd)){
+        print_error(105, (char*)path, strerror(errno));
+        if(listenFd >= 0){
+            close(listenFd);
+        }
+        return NULL;
+    }
+    int epollFd = epoll_create1(0);
+    int wakeFd = eventfd(0, EFD_NONBLOCK);
+    struct epoll_event listenEvent = {.events = EPOLLIN | EPOLLET, .data.ptr = NULL};
+    if(epollFd < 0 || wakeFd < 0 || epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &listenEvent) < 0){
+        print_error(105, (char*)path, strerror(errno));
+        close(listenFd);
+        unlink(path);
+        return NULL;
+    }
+
+    Server server = (Server)malloc(sizeof(struct _server));
+    if(server == NULL){
+        print_error(200, NULL, NULL);
+    }
+    server->listenFd = listenFd;
+    server->spareFd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+    server->epollFd = epollFd;
+    server->wakeFd = wakeFd;
+    server->path = strdup(path);
+    if(server->path == NULL){
+        print_error(200, NULL, NULL);
+    }
+    struct epoll_event wakeEvent = {.events = EPOLLIN | EPOLLET, .data.ptr = server};
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &wakeEvent);
+
+    server->session = create_scriptSession();
+    pthread_mutex_init(&server->queueLock, NULL);
+    pthread_cond_init(&server->queueReady, NULL);
+    server->queue = NULL;
+    server->lastQueued = NULL;
+    server->done = NULL;
+    server->shutdown = false;
+    server->clients = NULL;
+    server->clientCount = 0;
+    memset(server->latency, 0, sizeof(server->latency));
+    server->lastSave = time(NULL);
+    server->requests = 0;
+
+    // Los trabajadores no reciben SIGINT ni SIGTERM, asi la señal siempre interrumpe a epoll_wait
+    sigset_t signals, previous;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, &previous);
+    server->workerCount = online_cores();
+    server->workers = (pthread_t*)malloc(server->workerCount * sizeof(pthread_t));
+    if(server->workers == NULL){
+        print_error(200, NULL, NULL);
+    }
+    for(int i=0; i<server->workerCount; i++){
+        if(pthread_create(&server->workers[i], NULL, server_worker, server) != 0){
+            print_error(204, NULL, NULL);
+        }
+    }
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+    return server;
+}
+
+/**
+ * @brief Detiene los trabajadores, cierra el socket del servidor, guarda las tablas y las borra
+ *
+ * Los clientes que sigan conectados se cierran sin enviarles lo pendiente.
+ *
+ * @param server Servidor a borrar
+*/
+void delete_server(Server server)
+{
+    if(server == NULL){
+        return;
+    }
+    stop_server_workers(server);
+    finish_server_requests(server);
+
+    while(server->clients != NULL){
+        close_server_client(server, server->clients);
+    }
+
+    close(server->listenFd);
+    if(server->spareFd >= 0){
+        close(server->spareFd);
+    }
+    close(server->epollFd);
+    close(server->wakeFd);
+    unlink(server->path);
+    delete_scriptSession(server->session);
+    pthread_mutex_destroy(&server->queueLock);
+    pthread_cond_destroy(&server->queueReady);
+    free(server->workers);
+    free(server->path);
+    free(server);
+}
+
+/**
+ * @brief Atiende clientes hasta recibir SIGINT o SIGTERM
+ *
+ * Todos los sockets se registran en modo edge-triggered: cada aviso de epoll se atiende leyendo (o escribiendo)
+ * hasta que el socket responde EAGAIN.
+ *
+ * @param server Servidor
+*/
+void run_server(Server server)
+{
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = stop_server;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    struct epoll_event events[SERVER_EVENTS];
+    while(!serverStop){
+        int timeout = (int)(server->lastSave + SERVER_SAVE_INTERVAL - time(NULL));
+        int ready = epoll_wait(server->epollFd, events, SERVER_EVENTS, timeout > 0 ? timeout * 1000 : 0);
+        if(ready < 0 && errno != EINTR){
+            print_error(105, server->path, strerror(errno));
+            break;
+        }
+
+        bool wake = false;
+        for(int i=0; i<ready; i++){
+            if(events[i].data.ptr == NULL){
+                accept_server_clients(server);
+                continue;
+            }
+            if(events[i].data.ptr == (void*)server){
+                wake = true;
+                continue;
+            }
+            ServerClient* client = events[i].data.ptr;
+            bool open = !(events[i].events & EPOLLERR);
+            if(open && (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP))){
+                open = read_server_client(server, client);
+            }
+            if(open){
+                open = write_server_client(client);
+            }
+            if(!open || is_server_client_done(client)){
+                close_server_client(server, client);
+            }
+        }
+        // Las respuestas se recogen al final: pueden cerrar clientes que aun tenian eventos en esta vuelta
+        if(wake){
+            uint64_t count;
+            while(read(server->wakeFd, &count, sizeof(count)) > 0);
+            finish_server_requests(server);
+        }
+
+        if(time(NULL) - server->lastSave >= SERVER_SAVE_INTERVAL){
+            queue_server_save(server);
+            server->lastSave = time(NULL);
+        }
+    }
+}
+
+/**
+ * @brief Acepta todas las conexiones en espera
+ *
+ * El socket de escucha es edge-triggered, asi que se acepta hasta recibir EAGAIN: si se dejaran conexiones en
+ * espera, epoll no volveria a avisar hasta que llegara otra.
+ *
+ * @param server Servidor
+*/
+void accept_server_clients(Server server)
+{
+    while(true){
+        int fd = accept(server->listenFd, NULL, NULL);
+        if(fd < 0){
+            if(errno == EINTR || errno == ECONNABORTED){
+                continue;
+            }
+            if((errno == EMFILE || errno == ENFILE) && server->spareFd >= 0 && reject_server_client(server)){
+                continue;
+            }
+            return; // EAGAIN: no quedan conexiones en espera
+        }
+        if(!set_nonblocking(fd)){
+            close(fd);
+            continue;
+        }
+        ServerClient* client = (ServerClient*)malloc(sizeof(ServerClient));
+        if(client == NULL){
+            print_error(200, NULL, NULL);
+        }
+        client->fd = fd;
+        client->inputSize = 0;
+        client->output = create_renderBuffer(-1);
+        client->sent = 0;
+        client->requests = 0;
+        client->pending = NULL;
+        client->lastPending = NULL;
+        client->pendingCount = 0;
+        client->throttled = false;
+        client->busy = false;
+        client->closing = false;
+
+        struct epoll_event event = {.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET, .data.ptr = client};
+        if(epoll_ctl(server->epollFd, EPOLL_CTL_ADD, fd, &event) < 0){
+            close(fd);
+            delete_serverClient(client);
+            continue;
+        }
+        client->prev = NULL;
+        client->next = server->clients;
+        if(server->clients != NULL){
+            server->clients->prev = client;
+        }
+        server->clients = client;
+        server->clientCount++;
+    }
+}
+
+/**
+ * @brief Rechaza la siguiente conexion en espera cuando no quedan descriptores para aceptarla
+ *
+ * Se libera el descriptor de reserva, se acepta y cierra la conexion, y se vuelve a reservar el descriptor.
+ * accept informa EMFILE aunque no haya conexiones en espera, por eso se indica si se rechazo alguna.
+ *
+ * @param server Servidor
+ * @return TRUE si se rechazo una conexion, FALSE si no quedaban conexiones en espera
+*/
+bool reject_server_client(Server server)
+{
+    close(server->spareFd);
+    int fd = accept(server->listenFd, NULL, NULL);
+    if(fd >= 0){
+        print_error(105, server->path, "No quedan descriptores, se rechaza una conexion");
+        close(fd);
+    }
+    server->spareFd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+    return fd >= 0;
+}
+
+/**
+ * @brief Cierra la conexion de un cliente
+ *
+ * Si el cliente tiene una solicitud en un trabajador, se borra cuando esta termine (ver `finish_server_requests`).
+ *
+ * @param server Servidor
+ * @param client Cliente a cerrar
+*/
+void close_server_client(Server server, ServerClient* client)
+{
+    if(client->fd >= 0){
+        epoll_ctl(server->epollFd, EPOLL_CTL_DEL, client->fd, NULL);
+        close(client->fd);
+        client->fd = -1;
+        if(client->prev != NULL){
+            client->prev->next = client->next;
+        }
+        else{
+            server->clients = client->next;
+        }
+        if(client->next != NULL){
+            client->next->prev = client->prev;
+        }
+        server->clientCount--;
+    }
+    if(!client->busy){
+        delete_serverClient(client);
+    }
+}
+
+/**
+ * @brief Borra un cliente y sus solicitudes pendientes
+ *
+ * @param client Cliente a borrar
+*/
+void delete_serverClient(ServerClient* client)
+{
+    while(client->pending != NULL){
+        ServerRequest* next = client->pending->next;
+        delete_serverRequest(client->pending);
+        client->pending = next;
+    }
+    delete_renderBuffer(client->output);
+    free(client);
+}
+
+// Funciones de atencion de clientes
+
+/**
+ * @brief Lee todo lo que haya enviado un cliente y encola cada linea completa como una solicitud
+ *
+ * Se deja de leer al juntar SERVER_MAX_PENDING solicitudes pendientes; el resto queda en el socket hasta que
+ * termine una de ellas (ver `finish_server_requests`).
+ *
+ * @param server Servidor
+ * @param client Cliente
+ * @return FALSE si la conexion fallo y debe cerrarse
+*/
+bool read_server_client(Server server, ServerClient* client)
+{
+    while(true){
+        parse_server_client_input(client);
+        if(client->closing || client->pendingCount >= SERVER_MAX_PENDING){
+            break;
+        }
+        ssize_t length = read(client->fd, &client->input[client->inputSize], SERVER_INPUT_SIZE - client->inputSize);
+        if(length < 0){
+            if(errno == EINTR){
+                continue;
+            }
+            if(errno != EAGAIN && errno != EWOULDBLOCK){
+                return false;
+            }
+            break;
+        }
+        if(length == 0){ // El cliente no enviara mas solicitudes
+            client->closing = true;
+            continue; // Aun pueden quedar lineas completas en input
+        }
+        client->inputSize += (size_t)length;
+    }
+    client->throttled = client->pendingCount >= SERVER_MAX_PENDING;
+    dispatch_server_request(server, client);
+    return true;
+}
+
+/**
+ * @brief Encola las lineas completas recibidas de un cliente, hasta tener SERVER_MAX_PENDING pendientes
+ *
+ * @param client Cliente
+*/
+void parse_server_client_input(ServerClient* client)
+{
+    size_t start = 0;
+    char* newline;
+    while(client->pendingCount < SERVER_MAX_PENDING && (newline = memchr(&client->input[start], '\n', client->inputSize - start)) != NULL){
+        queue_server_request(client, &client->input[start], (size_t)(newline - &client->input[start]));
+        start = (size_t)(newline - client->input) + 1;
+    }
+    memmove(client->input, &client->input[start], client->inputSize - start);
+    client->inputSize -= start;
+
+    if(client->inputSize == SERVER_INPUT_SIZE && client->pendingCount < SERVER_MAX_PENDING){ // Linea que no cabe: se responde el error y se cierra
+        queue_server_request(client, NULL, 0);
+        client->inputSize = 0;
+        client->closing = true;
+    }
+}
+
+/**
+ * @brief Agrega una solicitud a las pendientes de un cliente
+ *
+ * @param client Cliente
+ * @param line Linea de la solicitud (sin terminar en '\0'), NULL si no cabia
+ * @param length Largo de la linea
+*/
+void queue_server_request(ServerClient* client, const char* line, size_t length)
+{
+    ServerRequest* request = (ServerRequest*)malloc(sizeof(ServerRequest));
+    if(request == NULL){
+        print_error(200, NULL, NULL);
+    }
+    request->client = client;
+    request->line = NULL;
+    if(line != NULL){
+        request->line = (char*)malloc(length + 1);
+        if(request->line == NULL){
+            print_error(200, NULL, NULL);
+        }
+        memcpy(request->line, line, length);
+        request->line[length] = '\0';
+    }
+    request->number = ++client->requests;
+    request->verb = server_request_verb(request->line);
+    clock_gettime(CLOCK_MONOTONIC, &request->received);
+    request->response = NULL;
+    request->next = NULL;
+
+    if(client->lastPending == NULL){
+        client->pending = request;
+    }
+    else{
+        client->lastPending->next = request;
+    }
+    client->lastPending = request;
+    client->pendingCount++;
+}
+
+/**
+ * @brief Pasa la siguiente solicitud de un cliente a los trabajadores, si no tiene otra en curso
+ *
+ * @param server Servidor
+ * @param client Cliente
+*/
+void dispatch_server_request(Server server, ServerClient* client)
+{
+    if(client->busy || client->pending == NULL){
+        return;
+    }
+    ServerRequest* request = client->pending;
+    client->pending = request->next;
+    if(client->pending == NULL){
+        client->lastPending = NULL;
+    }
+    client->pendingCount--;
+    request->next = NULL;
+    client->busy = true;
+    enqueue_server_request(server, request);
+}
+
+/**
+ * @brief Encola el guardado periodico de las tablas para que lo haga un trabajador
+ *
+ * Guardar toma las cuatro tablas como escritor y escribe en disco: en el hilo de sockets detendria la atencion de
+ * todos los clientes mientras tanto.
+ *
+ * @param server Servidor
+*/
+void queue_server_save(Server server)
+{
+    ServerRequest* request = (ServerRequest*)malloc(sizeof(ServerRequest));
+    if(request == NULL){
+        print_error(200, NULL, NULL);
+    }
+    memset(request, 0, sizeof(ServerRequest));
+    enqueue_server_request(server, request);
+}
+
+/**
+ * @brief Agrega una solicitud al final de la cola de los trabajadores y despierta a uno
+ *
+ * @param server Servidor
+ * @param request Solicitud a encolar
+*/
+void enqueue_server_request(Server server, ServerRequest* request)
+{
+    pthread_mutex_lock(&server->queueLock);
+    if(server->lastQueued == NULL){
+        server->queue = request;
+    }
+    else{
+        server->lastQueued->next = request;
+    }
+    server->lastQueued = request;
+    pthread_cond_signal(&server->queueReady);
+    pthread_mutex_unlock(&server->queueLock);
+}
+
+/**
+ * @brief Recoge las solicitudes que terminaron los trabajadores y deja sus respuestas en la salida de cada cliente
+ *
+ * @param server Servidor
+*/
+void finish_server_requests(Server server)
+{
+    pthread_mutex_lock(&server->queueLock);
+    ServerRequest* request = server->done;
+    server->done = NULL;
+    pthread_mutex_unlock(&server->queueLock);
+
+    while(request != NULL){
+        ServerRequest* next = request->next;
+        ServerClient* client = request->client;
+        client->busy = false;
+        record_latency(&server->latency[request->verb], elapsed_micros(&request->received));
+        server->requests++;
+
+        if(client->fd < 0){ // El cliente se cerro mientras su solicitud estaba en un trabajador
+            delete_serverRequest(request);
+            delete_serverClient(client);
+            request = next;
+            continue;
+        }
+        render_format(client->output, "%zu\n", request->response->size);
+        render_bytes(client->output, request->response->data, request->response->size);
+        delete_serverRequest(request);
+
+        dispatch_server_request(server, client);
+        bool open = !client->throttled || read_server_client(server, client);
+        if(!open || !write_server_client(client) || is_server_client_done(client)){
+            close_server_client(server, client);
+        }
+        request = next;
+    }
+}
+
+/**
+ * @brief Envia todo lo que el socket del cliente acepte sin bloquear
+ *
+ * @param client Cliente
+ * @return FALSE si la conexion fallo
+*/
+bool write_server_client(ServerClient* client)
+{
+    RenderBuffer output = client->output;
+    while(client->sent < output->size){
+        ssize_t length = send(client->fd, &output->data[client->sent], output->size - client->sent, MSG_NOSIGNAL);
+        if(length < 0){
+            if(errno == EINTR){
+                continue;
+            }
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        client->sent += (size_t)length;
+    }
+    output->size = 0;
+    client->sent = 0;
+    return true;
+}
+
+/**
+ * @brief Indica si un cliente ya no enviara solicitudes y todas sus respuestas fueron enviadas
+ *
+ * @param client Cliente
+ * @return TRUE si la conexion se puede cerrar
+*/
+bool is_server_client_done(ServerClient* client)
+{
+    return client->closing && !client->busy && client->pending == NULL && client->output->size == 0;
+}
+
+/**
+ * @brief Borra una solicitud
+ *
+ * @param request Solicitud a borrar
+*/
+void delete_serverRequest(ServerRequest* request)
+{
+    if(request->response != NULL){
+        delete_renderBuffer(request->response);
+    }
+    free(request->line);
+    free(request);
+}
+
+// Funciones de los trabajadores
+
+/**
+ * @brief Hilo trabajador: ejecuta las solicitudes de la cola hasta que el servidor se detenga
+ *
+ * Varios trabajadores pueden calcular feeds y recomendaciones a la vez: cada comando toma los candados de lectores
+ * y escritores de las tablas que usa (ver script.c).
+ *
+ * @param arg Servidor
+ * @return NULL
+*/
+void* server_worker(void* arg)
+{
+    Server server = (Server)arg;
+    pthread_mutex_lock(&server->queueLock);
+    while(true){
+        while(!server->shutdown && server->queue == NULL){
+            pthread_cond_wait(&server->queueReady, &server->queueLock);
+        }
+        ServerRequest* request = server->queue;
+        if(request == NULL){ // shutdown y no quedan solicitudes
+            break;
+        }
+        server->queue = request->next;
+        if(server->queue == NULL){
+            server->lastQueued = NULL;
+        }
+        pthread_mutex_unlock(&server->queueLock);
+
+        if(request->client == NULL){ // Guardado periodico: no tiene respuesta
+            save_scriptSession(server->session);
+            delete_serverRequest(request);
+            pthread_mutex_lock(&server->queueLock);
+            continue;
+        }
+        request->response = create_renderBuffer(-1);
+        if(request->line != NULL){
+            execute_script_command(server->session, request->line, request->number, request->response);
+        }
+        else{
+            script_error(request->number, "linea demasiado larga", NULL, request->response);
+        }
+
+        pthread_mutex_lock(&server->queueLock);
+        request->next = server->done;
+        server->done = request;
+        uint64_t one = 1;
+        if(write(server->wakeFd, &one, sizeof(one)) < 0){
+            print_error(104, NULL, NULL);
+        }
+    }
+    pthread_mutex_unlock(&server->queueLock);
+    return NULL;
+}
+
+/**
+ * @brief Pide a los trabajadores que terminen (luego de vaciar la cola) y los espera
+ *
+ * @param server Servidor
+*/
+void stop_server_workers(Server server)
+{
+    pthread_mutex_lock(&server->queueLock);
+    server->shutdown = true;
+    pthread_cond_broadcast(&server->queueReady);
+    pthread_mutex_unlock(&server->queueLock);
+    for(int i=0; i<server->workerCount; i++){
+        pthread_join(server->workers[i], NULL);
+    }
+}
+
+// Funciones de latencia
+
+/**
+ * @brief Agrega una latencia a un histograma
+ *
+ * @param histogram Histograma
+ * @param micros Latencia en microsegundos
+*/
+void record_latency(LatencyHistogram* histogram, double micros)
+{
+    unsigned long long value = micros < 1 ? 1 : (unsigned long long)micros;
+    int bucket = 63 - __builtin_clzll(value);
+    if(bucket >= SERVER_HISTOGRAM_BUCKETS){
+        bucket = SERVER_HISTOGRAM_BUCKETS - 1;
+    }
+    histogram->counts[bucket]++;
+    histogram->total++;
+    histogram->sum += micros;
+    if(micros > histogram->max){
+        histogram->max = micros;
+    }
+}
+
+/**
+ * @brief Suma un histograma a otro
+ *
+ * @param into Histograma donde se suma
+ * @param from Histograma a sumar
+*/
+void merge_latency(LatencyHistogram* into, const LatencyHistogram* from)
+{
+    for(int i=0; i<SERVER_HISTOGRAM_BUCKETS; i++){
+        into->counts[i] += from->counts[i];
+    }
+    into->total += from->total;
+    into->sum += from->sum;
+    if(from->max > into->max){
+        into->max = from->max;
+    }
+}
+
+/**
+ * @brief Calcula una cota superior del percentil p de un histograma
+ *
+ * @param histogram Histograma
+ * @param p Percentil entre 0 y 1
+ * @return Limite superior del rango que contiene al percentil (microsegundos), sin pasar de la latencia maxima
+*/
+double latency_percentile(const LatencyHistogram* histogram, double p)
+{
+    long target = (long)(p * histogram->total + 0.5);
+    if(target < 1){
+        target = 1;
+    }
+    long accumulated = 0;
+    for(int i=0; i<SERVER_HISTOGRAM_BUCKETS; i++){
+        accumulated += histogram->counts[i];
+        if(accumulated >= target){
+            double limit = (double)(1ULL << (i + 1));
+            return limit < histogram->max ? limit : histogram->max;
+        }
+    }
+    return histogram->max;
+}
+
+/**
+ * @brief Imprime un resumen de un histograma de latencia
+ *
+ * @param name Nombre del histograma
+ * @param histogram Histograma
+*/
+void print_latency(const char* name, const LatencyHistogram* histogram)
+{
+    if(histogram->total == 0){
+        return;
+    }
+    printf("\t"ANSI_COLOR_CYAN"%-9s"ANSI_COLOR_RESET" %8ld  promedio %9.1f us  p50 %9.0f us  p90 %9.0f us  p99 %9.0f us  max %9.0f us\n",
+           name, histogram->total, histogram->sum / histogram->total, latency_percentile(histogram, 0.5),
+           latency_percentile(histogram, 0.9), latency_percentile(histogram, 0.99), histogram->max);
+}
+
+// Funciones del cliente
+
+/**
+ * @brief Envia al servidor cada linea de un archivo y escribe sus respuestas en la salida estandar
+ *
+ * @param path Ruta del socket del servidor
+ * @param input Archivo con las solicitudes (normalmente stdin)
+ * @return Cantidad de respuestas recibidas, -1 si no se pudo conectar
+*/
+int run_client(const char* path, FILE* input)
+{
+    int fd = connect_to_server(path);
+    if(fd < 0){
+        return -1;
+    }
+    FILE* responses = fdopen(fd, "r");
+    if(responses == NULL){
+        print_error(106, (char*)path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    char* line = NULL;
+    size_t lineCapacity = 0;
+    char* payload = NULL;
+    size_t payloadCapacity = 0, size;
+    int answered = 0;
+    ssize_t length;
+    while((length = getline(&line, &lineCapacity, input)) > 0){
+        if(!write_all(fd, line, (size_t)length) || (line[length - 1] != '\n' && !write_all(fd, "\n", 1))){
+            print_error(106, (char*)path, strerror(errno));
+            break;
+        }
+        if(read_response(responses, &payload, &payloadCapacity, &size) == NULL){
+            print_error(106, (char*)path, "El servidor cerro la conexion");
+            break;
+        }
+        fwrite(payload, 1, size, stdout);
+        answered++;
+    }
+
+    free(line);
+    free(payload);
+    fclose(responses);
+    return answered;
+}
+
+/**
+ * @brief Generador de carga: reparte las lineas de un archivo entre varias conexiones simultaneas y mide la
+ * latencia de cada respuesta
+ *
+ * @param path Ruta del socket del servidor
+ * @param input Archivo con las solicitudes
+ * @param connections Cantidad de conexiones
+ * @return Cantidad de solicitudes enviadas, -1 si alguna conexion fallo
+*/
+int run_load(const char* path, FILE* input, int connections)
+{
+    char** lines = NULL;
+    int count = 0, capacity = 0;
+    char* line = NULL;
+    size_t lineCapacity = 0;
+    ssize_t length;
+    while((length = getline(&line, &lineCapacity, input)) > 0){
+        if(line[length - 1] == '\n'){
+            line[--length] = '\0';
+        }
+        if(length == 0 || line[0] == '#'){
+            continue;
+        }
+        if(count == capacity){
+            capacity = capacity ? capacity * 2 : 256;
+            lines = (char**)realloc(lines, capacity * sizeof(char*));
+            if(lines == NULL){
+                print_error(200, NULL, NULL);
+            }
+        }
+        lines[count] = (char*)malloc(length + 2);
+        if(lines[count] == NULL){
+            print_error(200, NULL, NULL);
+        }
+        memcpy(lines[count], line, length);
+        lines[count][length] = '\n';
+        lines[count][length + 1] = '\0';
+        count++;
+    }
+    free(line);
+    if(connections > count){
+        connections = count > 0 ? count : 1;
+    }
+
+    LoadWorker* workers = (LoadWorker*)calloc(connections, sizeof(LoadWorker));
+    pthread_t* threads = (pthread_t*)malloc(connections * sizeof(pthread_t));
+    if(workers == NULL || threads == NULL){
+        print_error(200, NULL, NULL);
+    }
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(int i=0; i<connections; i++){
+        workers[i].path = path;
+        workers[i].lines = lines;
+        workers[i].count = count;
+        workers[i].first = i;
+        workers[i].step = connections;
+        if(pthread_create(&threads[i], NULL, load_worker, &workers[i]) != 0){
+            print_error(204, NULL, NULL);
+        }
+    }
+    LatencyHistogram total;
+    memset(&total, 0, sizeof(total));
+    int failed = 0;
+    bool ok = true;
+    for(int i=0; i<connections; i++){
+        pthread_join(threads[i], NULL);
+        merge_latency(&total, &workers[i].latency);
+        failed += workers[i].failed;
+        ok = ok && workers[i].ok;
+    }
+    double seconds = elapsed_micros(&start) / 1e6;
+
+    printf("%ld solicitudes en %.3f s (%.0f solicitudes/s) con %d conexiones, %d errores\n", total.total, seconds, seconds > 0 ? total.total / seconds : 0, connections, failed);
+    print_latency("total", &total);
+
+    for(int i=0; i<count; i++){
+        free(lines[i]);
+    }
+    free(lines);
+    free(workers);
+    free(threads);
+    return ok ? count : -1;
+}
+
+/**
+ * @brief Hilo del generador de carga: una conexion que envia sus solicitudes de a una y espera cada respuesta
+ *
+ * @param arg Trabajo de la conexion (LoadWorker)
+ * @return NULL
+*/
+void* load_worker(void* arg)
+{
+    LoadWorker* worker = (LoadWorker*)arg;
+    int fd = connect_to_server(worker->path);
+    if(fd < 0){
+        return NULL;
+    }
+    FILE* responses = fdopen(fd, "r");
+    if(responses == NULL){
+        close(fd);
+        return NULL;
+    }
+
+    char* payload = NULL;
+    size_t capacity = 0, size;
+    worker->ok = true;
+    for(int i = worker->first; i < worker->count; i += worker->step){
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        if(!write_all(fd, worker->lines[i], strlen(worker->lines[i])) || read_response(responses, &payload, &capacity, &size) == NULL){
+            worker->ok = false;
+            break;
+        }
+        record_latency(&worker->latency, elapsed_micros(&start));
+        if(size >= 3 && strncmp(payload, "err", 3) == 0){
+            worker->failed++;
+        }
+    }
+    free(payload);
+    fclose(responses);
+    return NULL;
+}
+
+/**
+ * @brief Se conecta al socket de un servidor
+ *
+ * @param path Ruta del socket
+ * @return Socket conectado, -1 si no se pudo conectar
+*/
+int connect_to_server(const char* path)
+{
+    struct sockaddr_un address;
+    if(strlen(path) >= sizeof(address.sun_path)){
+        print_error(106, (char*)path, "La ruta es demasiado larga");
+        return -1;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(fd < 0 || connect(fd, (struct sockaddr*)&address, sizeof(address)) < 0){
+        print_error(106, (char*)path, strerror(errno));
+        if(fd >= 0){
+            close(fd);
+        }
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief Envia todos los bytes por un socket bloqueante
+ *
+ * @param fd Socket
+ * @param data Bytes a enviar
+ * @param length Cantidad de bytes
+ * @return TRUE si se enviaron todos
+*/
+bool write_all(int fd, const char* data, size_t length)
+{
+    while(length > 0){
+        ssize_t sent = send(fd, data, length, MSG_NOSIGNAL);
+        if(sent < 0){
+            if(errno == EINTR){
+                continue;
+            }
+            return false;
+        }
+        data += sent;
+        length -= (size_t)sent;
+    }
+    return true;
+}
+
+/**
+ * @brief Lee una respuesta del servidor ("<largo>\n" seguido de <largo> bytes)
+ *
+ * @param responses Conexion con el servidor
+ * @param payload Buffer donde se deja la respuesta (crece si es necesario)
+ * @param capacity Capacidad del buffer
+ * @param size Largo de la respuesta leida
+ * @return Respuesta leida (*payload), NULL si la conexion se cerro antes de completarla
+*/
+char* read_response(FILE* responses, char** payload, size_t* capacity, size_t* size)
+{
+    char header[32];
+    if(fgets(header, sizeof(header), responses) == NULL){
+        return NULL;
+    }
+    *size = strtoul(header, NULL, 10);
+    if(*size + 1 > *capacity){
+        *capacity = *size + 1;
+        *payload = (char*)realloc(*payload, *capacity);
+        if(*payload == NULL){
+            print_error(200, NULL, NULL);
+        }
+    }
+    if(fread(*payload, 1, *size, responses) != *size){
+        return NULL;
+    }
+    (*payload)[*size] = '\0';
+    return *payload;
+}
+
+// Funciones auxiliares
+
+/**
+ * @brief Manejador de SIGINT y SIGTERM: pide al servidor que guarde y termine
+ *
+ * @param signum Señal recibida
+*/
+void stop_server(int signum)
+{
+    (void)signum;
+    serverStop = 1;
+}
+
+/**
+ * @brief Deja un descriptor en modo no bloqueante
+ *
+ * @param fd Descriptor
+ * @return TRUE si se pudo cambiar el modo
+*/
+bool set_nonblocking(int fd)
+{
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+/**
+ * @brief Identifica el tipo de una solicitud por su primera palabra
+ *
+ * @param line Linea de la solicitud (puede ser NULL)
+ * @return Indice del tipo en serverVerbs (SERVER_VERB_COUNT - 1 si no es uno conocido)
+*/
+int server_request_verb(const char* line)
+{
+    if(line == NULL){
+        return SERVER_VERB_COUNT - 1;
+    }
+    line += strspn(line, " \t");
+    size_t length = strcspn(line, " \t\r");
+    for(int i=0; i<SERVER_VERB_COUNT - 1; i++){
+        if(strlen(serverVerbs[i]) == length && strncmp(line, serverVerbs[i], length) == 0){
+            return i;
+        }
+    }
+    return SERVER_VERB_COUNT - 1;
+}
+
+/**
+ * @brief Calcula el tiempo transcurrido desde un instante
+ *
+ * @param start Instante inicial (CLOCK_MONOTONIC)
+ * @return Microsegundos transcurridos
+*/
+double elapsed_micros(const struct timespec* start)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1e6 + (now.tv_nsec - start->tv_nsec) / 1e3;
+}
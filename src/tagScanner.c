@@ -0,0 +1,147 @@
+/**
+ * @file tagScanner.c
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Busqueda de etiquetas ('#genero' y '@banda') en el texto de los comentarios, de a bloques de bytes con SSE2
+*/
+#include "tagScanner.h"
+
+// Funciones de busqueda de etiquetas
+
+/**
+ * @brief Recorre un texto y entrega cada etiqueta encontrada, sin copiarla
+ *
+ * Una etiqueta es un '#' o '@' seguido de una o mas letras ASCII, digitos o '_'. Despues de una etiqueta la busqueda
+ * sigue en el primer caracter que no forma parte de ella, asi "#rock#pop" entrega "rock" y "pop".
+ *
+ * @param text Texto a recorrer
+ * @param handler Funcion que recibe cada etiqueta, en el orden en que aparecen
+ * @param arg Argumento que se entrega a @p handler
+ * @return Cantidad de etiquetas encontradas
+*/
+int scan_tags(const char* text, TagHandler handler, void* arg)
+{
+    size_t length = strlen(text);
+    size_t position = find_tag_mark(text, 0, length);
+    int count = 0;
+    while(position < length){
+        char mark = text[position];
+        size_t end = find_tag_end(text, position + 1, length);
+        if(end > position + 1){
+            handler(mark, &text[position + 1], end - position - 1, arg);
+            count++;
+        }
+        position = find_tag_mark(text, end, length);
+    }
+    return count;
+}
+
+/**
+ * @brief Busca el siguiente '#' o '@' de un texto
+ *
+ * Con SSE2 se compara un bloque de TAG_SCANNER_BLOCK bytes contra ambos caracteres a la vez y la mascara resultante
+ * indica la posicion del primero. Los bytes que no completan un bloque se revisan con `find_tag_mark_scalar`, que
+ * tambien se usa completa si SSE2 no esta disponible.
+ *
+ * @param text Texto a recorrer
+ * @param position Posicion desde la que se busca
+ * @param length Largo del texto (no se lee mas alla)
+ * @return Posicion del caracter encontrado, @p length si no hay mas
+*/
+size_t find_tag_mark(const char* text, size_t position, size_t length)
+{
+#ifdef __SSE2__
+    const __m128i hash = _mm_set1_epi8('#');
+    const __m128i at = _mm_set1_epi8('@');
+    while(position + TAG_SCANNER_BLOCK <= length){
+        __m128i block = _mm_loadu_si128((const __m128i*)&text[position]);
+        __m128i marks = _mm_or_si128(_mm_cmpeq_epi8(block, hash), _mm_cmpeq_epi8(block, at));
+        int mask = _mm_movemask_epi8(marks); // Un bit por cada byte que inicia una etiqueta
+        if(mask){
+            return position + __builtin_ctz(mask);
+        }
+        position += TAG_SCANNER_BLOCK;
+    }
+#endif
+    return find_tag_mark_scalar(text, position, length);
+}
+
+/**
+ * @brief Busca el siguiente '#' o '@' de un texto, de a un byte
+ *
+ * @param text Texto a recorrer
+ * @param position Posicion desde la que se busca
+ * @param length Largo del texto
+ * @return Posicion del caracter encontrado, @p length si no hay mas
+*/
+size_t find_tag_mark_scalar(const char* text, size_t position, size_t length)
+{
+    while(position < length && text[position] != '#' && text[position] != '@'){
+        position++;
+    }
+    return position;
+}
+
+/**
+ * @brief Busca el fin de una etiqueta: el primer caracter que no es letra ASCII, digito ni '_'
+ *
+ * Con SSE2 se clasifica un bloque de TAG_SCANNER_BLOCK bytes con comparaciones de rango (las letras se pasan a
+ * minusculas con un OR de 0x20 antes de comparar) y la mascara de los bytes que no son de etiqueta indica el fin.
+ * Las comparaciones son con signo, por lo que los bytes mayores a 127 quedan fuera de todos los rangos, igual que
+ * en `is_tag_char`.
+ *
+ * @param text Texto a recorrer
+ * @param position Primera posicion de la etiqueta
+ * @param length Largo del texto
+ * @return Posicion siguiente al ultimo caracter de la etiqueta
+*/
+size_t find_tag_end(const char* text, size_t position, size_t length)
+{
+#ifdef __SSE2__
+    const __m128i beforeDigits = _mm_set1_epi8('0' - 1), afterDigits = _mm_set1_epi8('9' + 1);
+    const __m128i beforeLetters = _mm_set1_epi8('a' - 1), afterLetters = _mm_set1_epi8('z' + 1);
+    const __m128i lowerCase = _mm_set1_epi8(0x20), underscore = _mm_set1_epi8('_');
+    while(position + TAG_SCANNER_BLOCK <= length){
+        __m128i block = _mm_loadu_si128((const __m128i*)&text[position]);
+        __m128i digits = _mm_and_si128(_mm_cmpgt_epi8(block, beforeDigits), _mm_cmplt_epi8(block, afterDigits));
+        __m128i lower = _mm_or_si128(block, lowerCase);
+        __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(lower, beforeLetters), _mm_cmplt_epi8(lower, afterLetters));
+        __m128i tagChars = _mm_or_si128(_mm_or_si128(digits, letters), _mm_cmpeq_epi8(block, underscore));
+        int mask = ~_mm_movemask_epi8(tagChars) & 0xFFFF; // Un bit por cada byte que no es de etiqueta
+        if(mask){
+            return position + __builtin_ctz(mask);
+        }
+        position += TAG_SCANNER_BLOCK;
+    }
+#endif
+    return find_tag_end_scalar(text, position, length);
+}
+
+/**
+ * @brief Busca el fin de una etiqueta, de a un byte
+ *
+ * @param text Texto a recorrer
+ * @param position Primera posicion de la etiqueta
+ * @param length Largo del texto
+ * @return Posicion siguiente al ultimo caracter de la etiqueta
+*/
+size_t find_tag_end_scalar(const char* text, size_t position, size_t length)
+{
+    while(position < length && is_tag_char((unsigned char)text[position])){
+        position++;
+    }
+    return position;
+}
+
+// Funciones auxiliares
+
+/**
+ * @brief Indica si un caracter puede formar parte de una etiqueta
+ *
+ * @param c Caracter a revisar
+ * @return TRUE si es una letra ASCII, un digito o '_'
+ * @note No depende del locale, a diferencia de isalnum
+*/
+bool is_tag_char(unsigned char c)
+{
+    return (c >= '0' && c <= '9') || ((c | 0x20) >= 'a' && (c | 0x20) <= 'z') || c == '_';
+}
@@ -0,0 +1,521 @@
+/**
+ * @file textIndex.c
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Indice invertido de palabras para buscar publicaciones por su texto
+*/
+#include "textIndex.h"
+
+// Funciones del indice de texto
+
+/**
+ * @brief Crea un indice de texto vacio
+ *
+ * @param capacity Cantidad de entradas del diccionario (se redondea a una potencia de 2)
+ * @return Puntero al indice creado
+*/
+TextIndex create_textIndex(int capacity)
+{
+    TextIndex index = (TextIndex)malloc(sizeof(struct _textIndex));
+    if(index == NULL){
+        print_error(200, NULL, NULL);
+    }
+    index->capacity = TEXT_INDEX_INITIAL_TERMS;
+    while(index->capacity < capacity){
+        index->capacity *= 2;
+    }
+    index->terms = (TextTerm*)calloc(index->capacity, sizeof(TextTerm));
+    if(index->terms == NULL){
+        print_error(200, NULL, NULL);
+    }
+    index->termCount = 0;
+    index->commentCount = 0;
+    index->postingSize = 0;
+    return index;
+}
+
+/**
+ * @brief Borra un indice de texto
+ *
+ * @param index Indice a borrar
+*/
+void delete_textIndex(TextIndex index)
+{
+    if(index == NULL){
+        return;
+    }
+    for(int i=0; i<index->capacity; i++){
+        free(index->terms[i].word);
+        free(index->terms[i].postings);
+    }
+    free(index->terms);
+    free(index);
+}
+
+/**
+ * @brief Busca una palabra en el diccionario
+ *
+ * @param index Indice de texto
+ * @param word Palabra en minusculas
+ * @return Entrada de la palabra, NULL si ningun comentario la contiene
+*/
+TextTerm* find_textIndex_term(TextIndex index, const char* word)
+{
+    unsigned int mask = index->capacity - 1;
+    for(unsigned int i = jenkins_hash((char*)word) & mask; index->terms[i].word != NULL; i = (i + 1) & mask){
+        if(strcmp(index->terms[i].word, word) == 0){
+            return &index->terms[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Busca una palabra en el diccionario, agregandola si no esta
+ *
+ * @param index Indice de texto
+ * @param word Palabra en minusculas
+ * @return Entrada de la palabra
+*/
+TextTerm* insert_textIndex_term(TextIndex index, const char* word)
+{
+    if(4 * (index->termCount + 1) > 3 * index->capacity){
+        grow_textIndex(index);
+    }
+    unsigned int mask = index->capacity - 1;
+    unsigned int i = jenkins_hash((char*)word) & mask;
+    for(; index->terms[i].word != NULL; i = (i + 1) & mask){
+        if(strcmp(index->terms[i].word, word) == 0){
+            return &index->terms[i];
+        }
+    }
+    index->terms[i].word = (char*)malloc(strlen(word) + 1);
+    if(index->terms[i].word == NULL){
+        print_error(200, NULL, NULL);
+    }
+    strcpy(index->terms[i].word, word);
+    index->termCount++;
+    return &index->terms[i];
+}
+
+/**
+ * @brief Duplica el diccionario de un indice de texto, reubicando sus palabras
+ *
+ * @param index Indice de texto
+*/
+void grow_textIndex(TextIndex index)
+{
+    int oldCapacity = index->capacity;
+    TextTerm* oldTerms = index->terms;
+    index->capacity *= 2;
+    index->terms = (TextTerm*)calloc(index->capacity, sizeof(TextTerm));
+    if(index->terms == NULL){
+        print_error(200, NULL, NULL);
+    }
+    unsigned int mask = index->capacity - 1;
+    for(int j=0; j<oldCapacity; j++){
+        if(oldTerms[j].word == NULL){
+            continue;
+        }
+        unsigned int i = jenkins_hash(oldTerms[j].word) & mask;
+        while(index->terms[i].word != NULL){
+            i = (i + 1) & mask;
+        }
+        index->terms[i] = oldTerms[j];
+    }
+    free(oldTerms);
+}
+
+/**
+ * @brief Agrega un comentario a la lista de apariciones de una palabra
+ *
+ * @param index Indice de texto
+ * @param term Entrada de la palabra
+ * @param ID ID del comentario
+ * @note Un ID mayor que todos los anteriores (el caso de una publicacion nueva) se agrega al final en O(1); uno
+ * menor obliga a decodificar y volver a codificar la lista
+*/
+void insert_textTerm_ID(TextIndex index, TextTerm* term, time_t ID)
+{
+    if(term->count > 0 && ID <= term->lastID){
+        if(ID == term->lastID){ // La palabra se repite en el mismo comentario
+            return;
+        }
+        time_t* IDs = (time_t*)malloc(sizeof(time_t) * (term->count + 1));
+        if(IDs == NULL){
+            print_error(200, NULL, NULL);
+        }
+        int count = decode_textTerm_postings(term, IDs);
+        int position = count;
+        while(position > 0 && IDs[position - 1] > ID){
+            position--;
+        }
+        if(position == 0 || IDs[position - 1] != ID){
+            memmove(&IDs[position + 1], &IDs[position], sizeof(time_t) * (count - position));
+            IDs[position] = ID;
+            encode_textTerm_postings(index, term, IDs, count + 1);
+        }
+        free(IDs);
+        return;
+    }
+
+    if(term->size + TEXT_VARINT_MAX_BYTES > term->capacity){
+        int newCapacity = term->capacity > 0 ? 2*term->capacity : 16;
+        unsigned char* newPostings = (unsigned char*)realloc(term->postings, newCapacity);
+        if(newPostings == NULL){
+            print_error(200, NULL, NULL);
+        }
+        term->postings = newPostings;
+        term->capacity = newCapacity;
+    }
+    int bytes = encode_varint(term->postings + term->size, (uint64_t)(ID - (term->count > 0 ? term->lastID : 0)));
+    term->size += bytes;
+    index->postingSize += bytes;
+    term->lastID = ID;
+    term->count++;
+}
+
+/**
+ * @brief Decodifica la lista de apariciones de una palabra
+ *
+ * @param term Entrada de la palabra
+ * @param IDs Arreglo de al menos term->count elementos donde se guardan los IDs, de menor a mayor
+ * @return Cantidad de IDs decodificados
+*/
+int decode_textTerm_postings(TextTerm* term, time_t* IDs)
+{
+    const unsigned char* in = term->postings;
+    time_t ID = 0;
+    for(int i=0; i<term->count; i++){
+        ID += (time_t)decode_varint(&in);
+        IDs[i] = ID;
+    }
+    return term->count;
+}
+
+/**
+ * @brief Reemplaza la lista de apariciones de una palabra por una lista de IDs
+ *
+ * @param index Indice de texto
+ * @param term Entrada de la palabra
+ * @param IDs IDs de los comentarios, de menor a mayor y sin repetir
+ * @param count Cantidad de IDs
+*/
+void encode_textTerm_postings(TextIndex index, TextTerm* term, const time_t* IDs, int count)
+{
+    int capacity = count * TEXT_VARINT_MAX_BYTES;
+    if(capacity > term->capacity){
+        unsigned char* newPostings = (unsigned char*)realloc(term->postings, capacity);
+        if(newPostings == NULL){
+            print_error(200, NULL, NULL);
+        }
+        term->postings = newPostings;
+        term->capacity = capacity;
+    }
+    index->postingSize -= term->size;
+    term->size = 0;
+    for(int i=0; i<count; i++){
+        term->size += encode_varint(term->postings + term->size, (uint64_t)(IDs[i] - (i > 0 ? IDs[i-1] : 0)));
+    }
+    index->postingSize += term->size;
+    term->count = count;
+    term->lastID = count > 0 ? IDs[count - 1] : 0;
+}
+
+/**
+ * @brief Agrega las palabras del texto de un comentario al indice
+ *
+ * @param index Indice de texto
+ * @param comment Comentario con su texto ya leido
+*/
+void insert_textIndex_comment(TextIndex index, CommentPosition comment)
+{
+    char token[TEXT_TOKEN_LENGTH];
+    const char* cursor = comment->text;
+    while(next_text_token(&cursor, token)){
+        insert_textTerm_ID(index, insert_textIndex_term(index, token), comment->ID);
+    }
+    index->commentCount++;
+}
+
+/**
+ * @brief Construye el indice de texto con todos los comentarios de una tabla
+ *
+ * @param commentTable Tabla de comentarios
+ * @return Indice construido
+ * @note Lee el texto de cada comentario que aun no se habia leido. Los comentarios se recorren en orden cronologico,
+ * por lo que cada ID se agrega al final de sus listas
+*/
+TextIndex build_textIndex(CommentTable commentTable)
+{
+    TextIndex index = create_textIndex(2 * commentTable->commentCount);
+    for(int i=0; i<commentTable->recentCount; i++){
+        CommentPosition comment = find_commentTable_comment(commentTable->recentIDs[i], commentTable);
+        if(comment == NULL){
+            continue;
+        }
+        complete_comment_from_json(comment);
+        insert_textIndex_comment(index, comment);
+    }
+    #ifdef DEBUG
+        printf("Indice de texto: %d comentarios, %d palabras, %zu bytes de apariciones\n", index->commentCount, index->termCount, index->postingSize);
+    #endif
+    return index;
+}
+
+/**
+ * @brief Obtiene el indice de texto de una tabla de comentarios, construyendolo si aun no existe
+ *
+ * @param commentTable Tabla de comentarios
+ * @return Indice de texto de la tabla
+*/
+TextIndex get_textIndex(CommentTable commentTable)
+{
+    if(commentTable->textIndex == NULL){
+        commentTable->textIndex = build_textIndex(commentTable);
+    }
+    return commentTable->textIndex;
+}
+
+/**
+ * @brief Busca los comentarios que contienen las palabras de una consulta
+ *
+ * @param index Indice de texto
+ * @param commentTable Tabla de comentarios (para descartar comentarios borrados)
+ * @param query Palabras a buscar
+ * @param matchAll TRUE para exigir todas las palabras (AND), FALSE para aceptar cualquiera (OR)
+ * @param k Cantidad maxima de resultados
+ * @param total Donde se guarda la cantidad total de coincidencias (puede ser NULL)
+ * @return Lista de enlaces a los @p k comentarios coincidentes mas recientes, del mas nuevo al mas antiguo
+*/
+CommentLinkList search_textIndex(TextIndex index, CommentTable commentTable, const char* query, bool matchAll, int k, int* total)
+{
+    CommentLinkList results = create_empty_commentLinkList(NULL);
+    if(total){
+        *total = 0;
+    }
+
+    // Buscamos cada palabra distinta de la consulta
+    TextTerm* terms[TEXT_MAX_QUERY_TERMS];
+    int termCount = 0, sum = 0;
+    char token[TEXT_TOKEN_LENGTH];
+    const char* cursor = query;
+    while(termCount < TEXT_MAX_QUERY_TERMS && next_text_token(&cursor, token)){
+        TextTerm* term = find_textIndex_term(index, token);
+        if(term == NULL){
+            if(matchAll){ // Ningun comentario contiene todas las palabras
+                return results;
+            }
+            continue;
+        }
+        bool repeated = false;
+        for(int i=0; i<termCount; i++){
+            repeated = repeated || terms[i] == term;
+        }
+        if(!repeated){
+            terms[termCount++] = term;
+            sum += term->count;
+        }
+    }
+    if(termCount == 0){
+        return results;
+    }
+
+    time_t* matches = (time_t*)malloc(sizeof(time_t) * sum);
+    time_t* buffer = (time_t*)malloc(sizeof(time_t) * sum);
+    if(matches == NULL || buffer == NULL){
+        print_error(200, NULL, NULL);
+    }
+    int count = 0;
+    if(matchAll){
+        // Intersectamos empezando por la lista mas corta, el resultado nunca crece
+        int shortest = 0;
+        for(int i=1; i<termCount; i++){
+            if(terms[i]->count < terms[shortest]->count){
+                shortest = i;
+            }
+        }
+        count = decode_textTerm_postings(terms[shortest], matches);
+        for(int i=0; i<termCount && count > 0; i++){
+            if(i == shortest){
+                continue;
+            }
+            int other = decode_textTerm_postings(terms[i], buffer);
+            int a = 0, b = 0, kept = 0;
+            while(a < count && b < other){
+                if(matches[a] < buffer[b]) a++;
+                else if(matches[a] > buffer[b]) b++;
+                else{
+                    matches[kept++] = matches[a];
+                    a++;
+                    b++;
+                }
+            }
+            count = kept;
+        }
+    }
+    else{
+        // Unimos todas las listas y quitamos los repetidos
+        for(int i=0; i<termCount; i++){
+            count += decode_textTerm_postings(terms[i], matches + count);
+        }
+        qsort(matches, count, sizeof(time_t), compare_textIDs);
+        int kept = 0;
+        for(int i=0; i<count; i++){
+            if(kept == 0 || matches[kept - 1] != matches[i]){
+                matches[kept++] = matches[i];
+            }
+        }
+        count = kept;
+    }
+
+    // Los IDs son instantes de publicacion: recorremos desde el final para ordenar por recencia
+    CommentLinkPosition last = results;
+    int shown = 0;
+    for(int i=count - 1; i>=0; i--){
+        if(find_commentTable_comment(matches[i], commentTable) == NULL){ // Comentario borrado
+            continue;
+        }
+        if(total){
+            (*total)++;
+        }
+        if(shown < k){
+            last = insert_commentLinkList_node_basicInfo(last, matches[i]);
+            shown++;
+        }
+    }
+    free(matches);
+    free(buffer);
+    return results;
+}
+
+// Funciones de interaccion con el usuario
+
+/**
+ * @brief Pide una consulta y muestra las publicaciones mas recientes que la cumplen
+ *
+ * @param commentTable Tabla de comentarios
+*/
+void search_comments(CommentTable commentTable)
+{
+    char query[MAX_COMMENT_LENGTH + 1];
+    int option;
+
+    // Limpiamos el buffer de entrada
+    while (getchar() != '\n');
+    printf("Ingrese las palabras a buscar: ");
+    if(fgets(query, sizeof(query), stdin) == NULL){
+        print_error(102, NULL, NULL);
+        return;
+    }
+    printf("Buscar publicaciones con (0: todas las palabras, 1: alguna de las palabras): ");
+    if(scanf("%d", &option) != 1){
+        print_error(103, NULL, NULL);
+        return;
+    }
+
+    int total;
+    CommentLinkList results = search_textIndex(get_textIndex(commentTable), commentTable, query, option == 0, TEXT_SEARCH_RESULTS, &total);
+    RenderBuffer screen = create_renderBuffer(STDOUT_FILENO);
+    render_format(screen, CLEAR_SCREEN"Publicaciones encontradas: "ANSI_COLOR_MAGENTA"%d"ANSI_COLOR_RESET, total);
+    if(total > TEXT_SEARCH_RESULTS){
+        render_format(screen, " (se muestran las %d mas recientes)", TEXT_SEARCH_RESULTS);
+    }
+    render_string(screen, "\n\n");
+    for(CommentLinkPosition aux = results->next; aux != NULL; aux = aux->next){
+        complete_commentLinkList_node(aux, commentTable);
+        complete_comment_from_json(aux->commentNode);
+        render_commentNode(screen, aux->commentNode);
+    }
+    delete_renderBuffer(screen);
+    delete_commentLinkList(results);
+}
+
+// Funciones auxiliares
+
+/**
+ * @brief Obtiene la siguiente palabra de un texto
+ *
+ * Recorre el texto igual que complete_comment_tags: una palabra es una secuencia de letras, digitos, '_' o bytes
+ * no ASCII (para no cortar palabras con tildes), por lo que la puntuacion y las marcas '@' y '#' la separan y las
+ * etiquetas se indexan como palabras. La palabra se pasa a minusculas con to_low_case.
+ *
+ * @param cursor Posicion actual en el texto, avanza hasta despues de la palabra
+ * @param token Arreglo de TEXT_TOKEN_LENGTH caracteres donde se guarda la palabra
+ * @return Largo de la palabra, 0 si no quedan palabras
+*/
+int next_text_token(const char** cursor, char* token)
+{
+    const unsigned char* ptr = (const unsigned char*)*cursor;
+    while(*ptr){
+        // Saltamos hasta el inicio de la siguiente palabra
+        while(*ptr && !(isalnum(*ptr) || *ptr == '_' || *ptr >= 0x80)){
+            ptr++;
+        }
+        int length = 0;
+        while(*ptr && (isalnum(*ptr) || *ptr == '_' || *ptr >= 0x80)){
+            if(length < TEXT_TOKEN_LENGTH - 1){
+                token[length++] = *ptr;
+            }
+            ptr++;
+        }
+        token[length] = '\0';
+        if(length >= TEXT_MIN_TOKEN_LENGTH){
+            to_low_case(token);
+            *cursor = (const char*)ptr;
+            return length;
+        }
+    }
+    *cursor = (const char*)ptr;
+    return 0;
+}
+
+/**
+ * @brief Codifica un entero en bytes de 7 bits, con el bit mas alto indicando que sigue otro byte
+ *
+ * @param out Arreglo con espacio para TEXT_VARINT_MAX_BYTES bytes
+ * @param value Valor a codificar
+ * @return Cantidad de bytes escritos
+*/
+int encode_varint(unsigned char* out, uint64_t value)
+{
+    int bytes = 0;
+    while(value >= 0x80){
+        out[bytes++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    out[bytes++] = (unsigned char)value;
+    return bytes;
+}
+
+/**
+ * @brief Decodifica un entero escrito por encode_varint
+ *
+ * @param in Posicion del primer byte, avanza hasta despues del entero
+ * @return Valor decodificado
+*/
+uint64_t decode_varint(const unsigned char** in)
+{
+    uint64_t value = 0;
+    int shift = 0;
+    const unsigned char* ptr = *in;
+    while(*ptr & 0x80){
+        value |= (uint64_t)(*ptr++ & 0x7F) << shift;
+        shift += 7;
+    }
+    value |= (uint64_t)(*ptr++) << shift;
+    *in = ptr;
+    return value;
+}
+
+/**
+ * @brief Funcion de comparacion de IDs de comentarios para qsort
+ *
+ * @param a Puntero al primer ID
+ * @param b Puntero al segundo ID
+ * @return Negativo, cero o positivo segun el orden de los IDs
+*/
+int compare_textIDs(const void* a, const void* b)
+{
+    time_t x = *(const time_t*)a, y = *(const time_t*)b;
+    return (x > y) - (x < y);
+}
@@ -0,0 +1,188 @@
+/**
+ * @file threadpool.c
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Pool de hilos reutilizable para repartir ciclos entre todos los nucleos
+*/
+#include "threadpool.h"
+
+/**
+ * @brief Obtiene la cantidad de nucleos disponibles
+ *
+ * @return Cantidad de nucleos en linea (al menos 1)
+*/
+int online_cores()
+{
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return cores > 0 ? (int)cores : 1;
+}
+
+/**
+ * @brief Crea un pool de hilos
+ *
+ * @param threads Cantidad de hilos (0 o menos para usar un hilo por nucleo)
+ * @return Puntero al pool creado
+*/
+ThreadPool create_threadPool(int threads)
+{
+    if(threads <= 0){
+        threads = online_cores();
+    }
+    ThreadPool pool = (ThreadPool)malloc(sizeof(struct _threadPool));
+    if(pool == NULL){
+        print_error(200, NULL, NULL);
+    }
+    pool->threadCount = threads;
+    pool->threads = (pthread_t*)malloc(sizeof(pthread_t) * threads);
+    pool->workers = (ThreadPoolWorker*)malloc(sizeof(ThreadPoolWorker) * threads);
+    pool->scratch = (void**)calloc(threads, sizeof(void*));
+    pool->scratchSize = (size_t*)calloc(threads, sizeof(size_t));
+    if(pool->threads == NULL || pool->workers == NULL || pool->scratch == NULL || pool->scratchSize == NULL){
+        print_error(200, NULL, NULL);
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    pool->task = NULL;
+    pool->arg = NULL;
+    pool->count = 0;
+    pool->chunk = 1;
+    pool->next = 0;
+    pool->active = 0;
+    pool->generation = 0;
+    pool->shutdown = false;
+
+    for(int i=0; i<threads; i++){
+        pool->workers[i].pool = pool;
+        pool->workers[i].index = i;
+        if(pthread_create(&pool->threads[i], NULL, threadPool_worker, &pool->workers[i]) != 0){
+            print_error(204, NULL, NULL);
+        }
+    }
+    return pool;
+}
+
+/**
+ * @brief Termina los hilos de un pool y libera su memoria
+ *
+ * @param pool Pool a borrar
+*/
+void delete_threadPool(ThreadPool pool)
+{
+    if(pool == NULL){
+        return;
+    }
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = true;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+    for(int i=0; i<pool->threadCount; i++){
+        pthread_join(pool->threads[i], NULL);
+        free(pool->scratch[i]);
+    }
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->start);
+    pthread_cond_destroy(&pool->done);
+    free(pool->threads);
+    free(pool->workers);
+    free(pool->scratch);
+    free(pool->scratchSize);
+    free(pool);
+}
+
+/**
+ * @brief Funcion de cada hilo del pool: espera trabajos y procesa bloques de indices hasta agotarlos
+ *
+ * @param arg Puntero al ThreadPoolWorker del hilo
+ * @return NULL
+*/
+void* threadPool_worker(void* arg)
+{
+    ThreadPoolWorker* worker = (ThreadPoolWorker*)arg;
+    ThreadPool pool = worker->pool;
+    unsigned int seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    while(true){
+        while(!pool->shutdown && pool->generation == seen){
+            pthread_cond_wait(&pool->start, &pool->lock);
+        }
+        if(pool->shutdown){
+            break;
+        }
+        seen = pool->generation;
+
+        // Tomamos bloques hasta que no queden indices
+        while(pool->next < pool->count){
+            int first = pool->next;
+            int last = first + pool->chunk < pool->count ? first + pool->chunk : pool->count;
+            pool->next = last;
+            pthread_mutex_unlock(&pool->lock);
+            pool->task(pool->arg, worker->index, first, last);
+            pthread_mutex_lock(&pool->lock);
+        }
+
+        pool->active--;
+        if(pool->active == 0){
+            pthread_cond_signal(&pool->done);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/**
+ * @brief Ejecuta @p task sobre el rango [0, @p count) repartido entre los hilos del pool
+ *
+ * La funcion retorna cuando todos los indices fueron procesados. @p task recibe el indice del hilo que la
+ * ejecuta (para usar su scratch) y un rango [first, last) de indices.
+ *
+ * @param pool Pool de hilos
+ * @param task Funcion a ejecutar sobre cada bloque
+ * @param arg Argumento que recibe @p task
+ * @param count Cantidad de indices
+ * @param chunk Cantidad de indices por bloque (0 o menos para repartir en partes iguales)
+ * @warning No debe llamarse desde una tarea del mismo pool
+*/
+void run_threadPool(ThreadPool pool, ThreadTask task, void* arg, int count, int chunk)
+{
+    if(count <= 0){
+        return;
+    }
+    if(chunk <= 0){
+        chunk = (count + pool->threadCount - 1) / pool->threadCount;
+    }
+    pthread_mutex_lock(&pool->lock);
+    pool->task = task;
+    pool->arg = arg;
+    pool->count = count;
+    pool->chunk = chunk;
+    pool->next = 0;
+    pool->active = pool->threadCount;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    while(pool->active > 0){
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * @brief Obtiene el buffer de trabajo de un hilo, agrandandolo si es necesario
+ *
+ * @param pool Pool de hilos
+ * @param worker Indice del hilo (el que recibe la tarea)
+ * @param size Tamaño minimo (en bytes) del buffer
+ * @return Puntero al buffer del hilo, valido hasta la siguiente llamada con un tamaño mayor
+*/
+void* get_threadPool_scratch(ThreadPool pool, int worker, size_t size)
+{
+    if(pool->scratchSize[worker] < size){
+        void* newScratch = realloc(pool->scratch[worker], size);
+        if(newScratch == NULL){
+            print_error(200, NULL, NULL);
+        }
+        pool->scratch[worker] = newScratch;
+        pool->scratchSize[worker] = size;
+    }
+    return pool->scratch[worker];
+}
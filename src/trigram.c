@@ -0,0 +1,337 @@
+/**
+ * @file trigram.c
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Indice invertido de trigramas para sugerir nombres parecidos a uno mal escrito
+*/
+#include "trigram.h"
+
+// Funciones del indice de trigramas
+
+/**
+ * @brief Crea un indice de trigramas vacio
+ *
+ * @param capacity Cantidad de IDs a reservar inicialmente
+ * @return Puntero al indice creado
+*/
+TrigramIndex create_trigramIndex(int capacity)
+{
+    TrigramIndex index = (TrigramIndex)calloc(1, sizeof(struct _trigramIndex));
+    if(index == NULL){
+        print_error(200, NULL, NULL);
+    }
+    ensure_trigramIndex_capacity(index, (capacity > 0 ? capacity : 64) - 1);
+    return index;
+}
+
+/**
+ * @brief Borra un indice de trigramas y sus copias de los nombres
+ *
+ * @param index Indice a borrar
+*/
+void delete_trigramIndex(TrigramIndex index)
+{
+    if(index == NULL){
+        return;
+    }
+    for(int i=0; i<TRIGRAM_SLOTS; i++){
+        free(index->slots[i].IDs);
+    }
+    for(int ID=0; ID<index->count; ID++){
+        free(index->names[ID]);
+    }
+    free(index->names);
+    free(index->trigramCounts);
+    free(index->hits);
+    free(index->marks);
+    free(index->touched);
+    free(index);
+}
+
+/**
+ * @brief Asegura que los arreglos por ID del indice tengan espacio para @p ID
+ *
+ * @param index Indice de trigramas
+ * @param ID Mayor ID que se necesita guardar
+*/
+void ensure_trigramIndex_capacity(TrigramIndex index, int ID)
+{
+    if(ID < index->capacity){
+        return;
+    }
+    int newCapacity = index->capacity > 0 ? index->capacity : 64;
+    while(newCapacity <= ID){
+        newCapacity *= 2;
+    }
+    char** newNames = (char**)realloc(index->names, sizeof(char*) * newCapacity);
+    int* newCounts = (int*)realloc(index->trigramCounts, sizeof(int) * newCapacity);
+    int* newHits = (int*)realloc(index->hits, sizeof(int) * newCapacity);
+    unsigned int* newMarks = (unsigned int*)realloc(index->marks, sizeof(unsigned int) * newCapacity);
+    int* newTouched = (int*)realloc(index->touched, sizeof(int) * newCapacity);
+    if(!newNames || !newCounts || !newHits || !newMarks || !newTouched){
+        print_error(200, NULL, NULL);
+    }
+    for(int i=index->capacity; i<newCapacity; i++){
+        newNames[i] = NULL;
+        newCounts[i] = 0;
+        newMarks[i] = 0;
+    }
+    index->names = newNames;
+    index->trigramCounts = newCounts;
+    index->hits = newHits;
+    index->marks = newMarks;
+    index->touched = newTouched;
+    index->capacity = newCapacity;
+}
+
+/**
+ * @brief Obtiene los hashes de los trigramas distintos de un nombre
+ *
+ * @param name Nombre a descomponer (se pasa a minusculas y se rellena con dos espacios al inicio y uno al final)
+ * @param trigrams Arreglo donde se guardan los hashes, con espacio para TRIGRAM_MAX_LENGTH + 1 elementos
+ * @return Cantidad de trigramas distintos
+*/
+int extract_trigrams(const char* name, unsigned int* trigrams)
+{
+    unsigned char padded[TRIGRAM_MAX_LENGTH + 3];
+    int length = 0;
+    padded[length++] = ' ';
+    padded[length++] = ' ';
+    for(int i=0; name[i] != '\0' && i < TRIGRAM_MAX_LENGTH; i++){
+        padded[length++] = (unsigned char)tolower((unsigned char)name[i]);
+    }
+    padded[length++] = ' ';
+
+    int count = 0;
+    for(int i=0; i + 2 < length; i++){
+        trigrams[count++] = hash_trigram(padded[i], padded[i+1], padded[i+2]);
+    }
+
+    // Quitamos los repetidos para que la similitud se calcule sobre conjuntos
+    qsort(trigrams, count, sizeof(unsigned int), compare_trigrams);
+    int distinct = 0;
+    for(int i=0; i<count; i++){
+        if(distinct == 0 || trigrams[distinct - 1] != trigrams[i]){
+            trigrams[distinct++] = trigrams[i];
+        }
+    }
+    return distinct;
+}
+
+/**
+ * @brief Agrega un nombre al indice
+ *
+ * @param index Indice de trigramas
+ * @param ID ID del nombre (un ID que ya tiene nombre se ignora)
+ * @param name Nombre a agregar (el indice guarda su propia copia)
+*/
+void insert_trigramIndex_name(TrigramIndex index, int ID, const char* name)
+{
+    ensure_trigramIndex_capacity(index, ID);
+    if(index->names[ID] != NULL){
+        return;
+    }
+    index->names[ID] = (char*)malloc(strlen(name) + 1);
+    if(index->names[ID] == NULL){
+        print_error(200, NULL, NULL);
+    }
+    strcpy(index->names[ID], name);
+    if(ID >= index->count){
+        index->count = ID + 1;
+    }
+
+    unsigned int trigrams[TRIGRAM_MAX_LENGTH + 1];
+    int count = extract_trigrams(name, trigrams);
+    index->trigramCounts[ID] = count;
+    for(int i=0; i<count; i++){
+        TrigramPostings* postings = &index->slots[trigrams[i]];
+        if(postings->count == postings->capacity){
+            int newCapacity = postings->capacity > 0 ? 2*postings->capacity : 4;
+            int* newIDs = (int*)realloc(postings->IDs, sizeof(int) * newCapacity);
+            if(newIDs == NULL){
+                print_error(200, NULL, NULL);
+            }
+            postings->IDs = newIDs;
+            postings->capacity = newCapacity;
+        }
+        postings->IDs[postings->count++] = ID;
+    }
+}
+
+/**
+ * @brief Quita un nombre del indice
+ *
+ * @param index Indice de trigramas
+ * @param ID ID del nombre a quitar
+ * @note Sus apariciones quedan en las listas y las consultas las ignoran, por lo que el ID no se debe reutilizar
+*/
+void remove_trigramIndex_name(TrigramIndex index, int ID)
+{
+    if(ID < 0 || ID >= index->count){
+        return;
+    }
+    free(index->names[ID]);
+    index->names[ID] = NULL;
+    index->trigramCounts[ID] = 0;
+}
+
+/**
+ * @brief Busca el ID de un nombre exacto en el indice
+ *
+ * @param index Indice de trigramas
+ * @param name Nombre a buscar
+ * @return ID del nombre, -1 si no esta
+ * @note Solo recorre la lista del primer trigrama del nombre
+*/
+int find_trigramIndex_name(TrigramIndex index, const char* name)
+{
+    unsigned char first = (unsigned char)tolower((unsigned char)name[0]);
+    TrigramPostings* postings = &index->slots[hash_trigram(' ', ' ', first)];
+    for(int i=0; i<postings->count; i++){
+        int ID = postings->IDs[i];
+        if(index->names[ID] && strcmp(index->names[ID], name) == 0){
+            return ID;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Obtiene el nombre de un ID del indice
+ *
+ * @param index Indice de trigramas
+ * @param ID ID del nombre
+ * @return Nombre guardado, NULL si el ID no tiene nombre
+*/
+const char* get_trigramIndex_name(TrigramIndex index, int ID)
+{
+    if(ID < 0 || ID >= index->count){
+        return NULL;
+    }
+    return index->names[ID];
+}
+
+/**
+ * @brief Busca los nombres mas parecidos a @p query
+ *
+ * @param index Indice de trigramas
+ * @param query Nombre buscado, posiblemente mal escrito
+ * @param k Cantidad maxima de resultados
+ * @param IDs Arreglo de al menos @p k elementos donde se guardan los IDs encontrados
+ * @param scores Arreglo de al menos @p k elementos donde se guarda la similitud de cada uno (puede ser NULL)
+ * @return Cantidad de resultados, ordenados de mayor a menor similitud
+ * @note Solo se devuelven nombres con similitud de al menos TRIGRAM_MIN_SIMILARITY. Usa memoria del indice, por lo
+ * que no se pueden hacer dos consultas a la vez sobre el mismo indice
+*/
+int search_trigramIndex(TrigramIndex index, const char* query, int k, int* IDs, double* scores)
+{
+    if(k <= 0 || query[0] == '\0'){
+        return 0;
+    }
+    unsigned int trigrams[TRIGRAM_MAX_LENGTH + 1];
+    int queryCount = extract_trigrams(query, trigrams);
+
+    // Contamos cuantos trigramas comparte cada nombre con la consulta
+    if(++index->generation == 0){
+        memset(index->marks, 0, sizeof(unsigned int) * index->capacity);
+        index->generation = 1;
+    }
+    int touchedCount = 0;
+    for(int i=0; i<queryCount; i++){
+        TrigramPostings* postings = &index->slots[trigrams[i]];
+        for(int j=0; j<postings->count; j++){
+            int ID = postings->IDs[j];
+            if(index->marks[ID] != index->generation){
+                index->marks[ID] = index->generation;
+                index->hits[ID] = 0;
+                index->touched[touchedCount++] = ID;
+            }
+            index->hits[ID]++;
+        }
+    }
+
+    // Nos quedamos con los K nombres de mayor similitud de Jaccard
+    ScoreHeap heap = create_scoreHeap(k);
+    for(int i=0; i<touchedCount; i++){
+        int ID = index->touched[i];
+        if(index->names[ID] == NULL){
+            continue;
+        }
+        int shared = index->hits[ID];
+        double similarity = (double)shared / (queryCount + index->trigramCounts[ID] - shared);
+        if(similarity >= TRIGRAM_MIN_SIMILARITY){
+            push_scoreHeap(heap, similarity, (void*)(intptr_t)ID);
+        }
+    }
+    int count = sort_scoreHeap(heap);
+    for(int i=0; i<count; i++){
+        IDs[i] = (int)(intptr_t)heap->entries[i].data;
+        if(scores){
+            scores[i] = heap->entries[i].score;
+        }
+    }
+    delete_scoreHeap(heap);
+    return count;
+}
+
+// Funciones de interaccion con el usuario
+
+/**
+ * @brief Muestra los nombres parecidos a uno que no se encontro y permite elegir uno
+ *
+ * @param index Indice de trigramas
+ * @param name Nombre que no se encontro
+ * @return ID del nombre elegido, -1 si no hay sugerencias o no se eligio ninguna
+*/
+int ask_trigramIndex_suggestion(TrigramIndex index, const char* name)
+{
+    int IDs[TRIGRAM_SUGGESTIONS];
+    double scores[TRIGRAM_SUGGESTIONS];
+    int count = search_trigramIndex(index, name, TRIGRAM_SUGGESTIONS, IDs, scores);
+    if(count == 0){
+        return -1;
+    }
+
+    printf("Quiso decir:\n");
+    for(int i=0; i<count; i++){
+        printf("%3d. "ANSI_COLOR_CYAN"%-20s"ANSI_COLOR_RESET" (%.0f%% similar)\n", i + 1, index->names[IDs[i]], 100*scores[i]);
+    }
+    int option;
+    printf("Ingrese el numero de la sugerencia (0: ninguna): ");
+    if(scanf("%d", &option) != 1){
+        print_error(103, NULL, NULL);
+        return -1;
+    }
+    if(option < 1 || option > count){
+        return -1;
+    }
+    return IDs[option - 1];
+}
+
+// Funciones auxiliares
+
+/**
+ * @brief Calcula la lista de apariciones de un trigrama
+ *
+ * @param a Primer caracter
+ * @param b Segundo caracter
+ * @param c Tercer caracter
+ * @return Hash del trigrama entre 0 y TRIGRAM_SLOTS - 1
+*/
+unsigned int hash_trigram(unsigned char a, unsigned char b, unsigned char c)
+{
+    uint32_t key = ((uint32_t)a << 16) | ((uint32_t)b << 8) | c;
+    return (key * 2654435761u) >> (32 - TRIGRAM_SLOT_BITS);
+}
+
+/**
+ * @brief Funcion de comparacion de hashes de trigramas para qsort
+ *
+ * @param a Puntero al primer hash
+ * @param b Puntero al segundo hash
+ * @return Negativo, cero o positivo segun el orden de los hashes
+*/
+int compare_trigrams(const void* a, const void* b)
+{
+    unsigned int x = *(const unsigned int*)a, y = *(const unsigned int*)b;
+    return (x > y) - (x < y);
+}
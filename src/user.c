@@ -51,7 +51,7 @@ void save_userNode(PtrToUser user){
         print_error(202, NULL, NULL);
     }
 
-    char filename[strlen(user->username) + strlen(USERS_PATH) + 5];
+    char filename[strlen(user->username) + strlen(USERS_PATH) + 6]; // ".json" y '\0'
     sprintf(filename, USERS_PATH"%s.json", user->username);
 
     #ifdef DEBUG
@@ -141,6 +141,7 @@ void save_userNode(PtrToUser user){
     fprintf(file,"}\n");
 
     fclose(file);
+    user->modified = false;
 }
 
 /**
@@ -287,15 +288,9 @@ CommentLinkList get_user_feed(UserPosition user, BandTable bandTable, GenreTable
         auxGenre = auxGenre->next;
     }
 
-    if(feedComments->next == NULL){ // Si no hay comentarios el feed seran todos los comentarios del programa
-        for(int i=0; i<COMMENTS_TABLE_SIZE; i++){
-            CommentPosition aux = commentTable->buckets[i]->next;
-            while(aux != NULL){
-                printf("Procesando comentario %ld\n", aux->ID);
-                insert_commentLinkList_node_basicInfo(feedComments, aux->ID);
-                aux = aux->next;
-            }
-        }
+    if(feedComments->next == NULL){ // Si no hay comentarios el feed seran las publicaciones mas recientes de la red
+        delete_commentLinkList(feedComments);
+        feedComments = get_recent_comments(commentTable, RECENT_COMMENTS_PAGE);
     }
     return feedComments;
 }
@@ -316,19 +311,295 @@ void print_user_feed(UserPosition user, BandTable bandTable, GenreTable genreTab
     #ifdef DEBUG
         sleep(1);
     #endif
-    printf(CLEAR_SCREEN"Feed de publicaciones para "ANSI_COLOR_CYAN"%s"ANSI_COLOR_RESET":\n", user->username);
-    printf("\n");
+    // Toda la pantalla se arma en un buffer y se escribe de una vez
+    RenderBuffer screen = create_renderBuffer(STDOUT_FILENO);
+    render_format(screen, CLEAR_SCREEN"Feed de publicaciones para "ANSI_COLOR_CYAN"%s"ANSI_COLOR_RESET":\n\n", user->username);
 
     while (aux != NULL) {
         complete_commentLinkList_node(aux, commentTable);
         complete_comment_from_json(aux->commentNode);
-        print_commentNode(aux->commentNode);
+        render_commentNode(screen, aux->commentNode);
+        aux = aux->next;
+    }
+
+    delete_renderBuffer(screen);
+    delete_commentLinkList(feedComments);
+}
+
+/**
+ * @brief Calcula el factor de decaimiento temporal de una publicacion
+ *
+ * @param commentTime Momento en que se realizo la publicacion
+ * @param now Momento actual
+ * @return Factor entre 0 y 1, decreciente con la antiguedad de la publicacion
+*/
+double feed_time_decay(time_t commentTime, time_t now)
+{
+    double ageHours = difftime(now, commentTime) / 3600.0;
+    if(ageHours < 0){
+        ageHours = 0;
+    }
+    return 1.0 / pow(ageHours + 2.0, FEED_GRAVITY);
+}
+
+/**
+ * @brief Marca los comentarios de una lista de publicaciones (de una banda o genero) como candidatos del feed
+ *
+ * @param postings Lista de enlaces a comentarios de una banda o genero
+ * @param commentTable Tabla de comentarios
+ * @param generation Generacion del ranking actual
+ * @note Cada comentario acumula en rankMatches la cantidad de listas del usuario en que aparece
+*/
+void stamp_feed_candidates(CommentLinkList postings, CommentTable commentTable, unsigned int generation)
+{
+    CommentLinkPosition P = postings->next;
+    while(P != NULL){
+        if(complete_commentLinkList_node(P, commentTable)){
+            CommentPosition comment = P->commentNode;
+            if(comment->rankStamp != generation){
+                comment->rankStamp = generation;
+                comment->rankMatches = 0;
+            }
+            comment->rankMatches++;
+        }
+        P = P->next;
+    }
+}
+
+/**
+ * @brief Calcula el puntaje de una publicacion para un usuario y la ofrece al heap del feed
+ *
+ * El puntaje es (1 + coincidencias + amistad + afinidad) * decaimiento temporal. Si el heap ya esta lleno
+ * y ni el mejor caso posible supera al minimo del heap, la publicacion se descarta sin leerla de disco.
+ *
+ * @param heap Heap con las mejores publicaciones hasta el momento
+ * @param user Usuario dueño del feed
+ * @param comment Publicacion candidata
+ * @param matches Cantidad de bandas y generos del usuario presentes en la publicacion
+ * @param userTable Tabla de usuarios
+ * @param now Momento actual
+*/
+void offer_feed_candidate(ScoreHeap heap, UserPosition user, CommentPosition comment, int matches, UserTable userTable, time_t now)
+{
+    double decay = feed_time_decay(comment_ID_to_time(comment->ID), now);
+    double base = 1.0 + FEED_TAGS_WEIGHT * matches;
+
+    // Cota superior: el autor es amigo y tiene afinidad maxima
+    if(is_full_scoreHeap(heap) && (base + FEED_FRIEND_WEIGHT + FEED_AFFINITY_WEIGHT) * decay <= scoreHeap_min(heap)){
+        return;
+    }
+
+    complete_comment_from_json(comment);
+    double bonus = 0;
+    char* author = comment->user->userName;
+    if(author && strcmp(author, user->username) != 0){
+        if(find_userLinkList_node(user->friends, author)){
+            bonus += FEED_FRIEND_WEIGHT;
+        }
+        UserPosition authorNode = find_userTable_node(userTable, author);
+        if(authorNode){
+            complete_user_from_json(authorNode);
+            bonus += FEED_AFFINITY_WEIGHT * 0.5 * (genres_jacardIndex(user, authorNode, userTable) + bands_jacardIndex(user, authorNode, userTable));
+        }
+    }
+    push_scoreHeap(heap, (base + bonus) * decay, comment);
+}
+
+/**
+ * @brief Obtiene las @p k publicaciones mas relevantes para un usuario
+ *
+ * @param user Puntero al nodo de usuario
+ * @param userTable Tabla de usuarios
+ * @param bandTable Tabla de bandas
+ * @param genreTable Tabla de generos
+ * @param commentTable Tabla de comentarios
+ * @param k Cantidad de publicaciones a obtener
+ * @return Lista de comentarios ordenada de mayor a menor puntaje (el puntaje queda en coefficient)
+ * @note Solo se mantiene un heap de @p k candidatos, el costo es O(n log k) con memoria O(k)
+*/
+CommentLinkList get_user_ranked_feed(UserPosition user, UserTable userTable, BandTable bandTable, GenreTable genreTable, CommentTable commentTable, int k)
+{
+    complete_user_from_json(user);
+    CommentLinkList feedComments = create_empty_commentLinkList(NULL);
+    ScoreHeap heap = create_scoreHeap(k);
+    unsigned int generation = ++commentTable->rankGeneration;
+    time_t now = time(NULL);
+    bool anyCandidate = false;
+
+    // Primera pasada: contamos las coincidencias de cada comentario con las bandas y generos del usuario
+    BandLinkPosition auxBand = user->bands->next;
+    while(auxBand != NULL){
+        BandPosition bandNode = find_bandTable_band(auxBand->band, bandTable);
+        if(bandNode){
+            stamp_feed_candidates(bandNode->comments, commentTable, generation);
+        }
+        auxBand = auxBand->next;
+    }
+    GenreLinkPosition auxGenre = user->genres->next;
+    while(auxGenre != NULL){
+        GenrePosition genreNode = find_genresTable_genre(auxGenre->genre, genreTable);
+        if(genreNode){
+            stamp_feed_candidates(genreNode->comments, commentTable, generation);
+        }
+        auxGenre = auxGenre->next;
+    }
+
+    // Segunda pasada: puntuamos cada comentario marcado una sola vez (rankMatches en 0 indica que ya se puntuo)
+    auxBand = user->bands->next;
+    while(auxBand != NULL){
+        BandPosition bandNode = find_bandTable_band(auxBand->band, bandTable);
+        CommentLinkPosition auxComment = bandNode ? bandNode->comments->next : NULL;
+        while(auxComment != NULL){
+            CommentPosition comment = auxComment->commentNode;
+            if(comment && comment->rankStamp == generation && comment->rankMatches > 0){
+                offer_feed_candidate(heap, user, comment, comment->rankMatches, userTable, now);
+                comment->rankMatches = 0;
+                anyCandidate = true;
+            }
+            auxComment = auxComment->next;
+        }
+        auxBand = auxBand->next;
+    }
+    auxGenre = user->genres->next;
+    while(auxGenre != NULL){
+        GenrePosition genreNode = find_genresTable_genre(auxGenre->genre, genreTable);
+        CommentLinkPosition auxComment = genreNode ? genreNode->comments->next : NULL;
+        while(auxComment != NULL){
+            CommentPosition comment = auxComment->commentNode;
+            if(comment && comment->rankStamp == generation && comment->rankMatches > 0){
+                offer_feed_candidate(heap, user, comment, comment->rankMatches, userTable, now);
+                comment->rankMatches = 0;
+                anyCandidate = true;
+            }
+            auxComment = auxComment->next;
+        }
+        auxGenre = auxGenre->next;
+    }
+
+    if(!anyCandidate){ // Sin coincidencias se recorren las publicaciones de la red de mas reciente a mas antigua
+        for(int i = commentTable->recentCount - 1; i >= 0; i--){
+            // El decaimiento solo disminuye hacia atras, si ni el mejor caso entra al heap ninguna publicacion anterior lo hara
+            double bestCase = (1.0 + FEED_FRIEND_WEIGHT + FEED_AFFINITY_WEIGHT) * feed_time_decay(comment_ID_to_time(commentTable->recentIDs[i]), now);
+            if(is_full_scoreHeap(heap) && bestCase <= scoreHeap_min(heap)){
+                break;
+            }
+            CommentPosition comment = find_commentTable_comment(commentTable->recentIDs[i], commentTable);
+            if(comment){
+                offer_feed_candidate(heap, user, comment, 0, userTable, now);
+            }
+        }
+    }
+
+    // Pasamos el heap a la lista, de mayor a menor puntaje
+    int size = sort_scoreHeap(heap);
+    CommentLinkPosition last = feedComments;
+    for(int i=0; i<size; i++){
+        last = insert_commentLinkList_node_completeInfo(last, (CommentPosition)heap->entries[i].data);
+        last->coefficient = heap->entries[i].score;
+    }
+    delete_scoreHeap(heap);
+    return feedComments;
+}
+
+/**
+ * @brief Imprime las @p k publicaciones mas relevantes para un usuario
+ *
+ * @param user Puntero al nodo de usuario
+ * @param userTable Tabla de usuarios
+ * @param bandTable Tabla de bandas
+ * @param genreTable Tabla de generos
+ * @param commentTable Tabla de comentarios
+ * @param k Cantidad de publicaciones a imprimir
+*/
+void print_user_ranked_feed(UserPosition user, UserTable userTable, BandTable bandTable, GenreTable genreTable, CommentTable commentTable, int k)
+{
+    CommentLinkList feedComments = get_user_ranked_feed(user, userTable, bandTable, genreTable, commentTable, k);
+    CommentLinkPosition aux = feedComments->next;
+    RenderBuffer screen = create_renderBuffer(STDOUT_FILENO);
+    render_format(screen, CLEAR_SCREEN"Feed por relevancia para "ANSI_COLOR_CYAN"%s"ANSI_COLOR_RESET":\n\n", user->username);
+
+    while (aux != NULL) {
+        complete_comment_from_json(aux->commentNode);
+        render_format(screen, ANSI_COLOR_MAGENTA"[%.3e] "ANSI_COLOR_RESET, aux->coefficient);
+        render_commentNode(screen, aux->commentNode);
         aux = aux->next;
     }
 
+    delete_renderBuffer(screen);
     delete_commentLinkList(feedComments);
 }
 
+/**
+ * @brief Construye los conjuntos de gustos (generos y bandas como bitmaps de IDs internados) de un usuario
+ *
+ * @param user Usuario a completar, se carga desde su archivo si es necesario
+ * @param table Tabla de usuarios, dueña de los IDs internados
+ * @return Puntero al usuario
+ * @note Los conjuntos se construyen una sola vez y se descartan en `complete_userList_node` si los gustos cambian.
+ * Al reconstruirlos se actualiza la firma del usuario en el indice de gustos, si existe.
+*/
+UserPosition complete_user_tasteSets(UserPosition user, UserTable table)
+{
+    if(user->genreSet && user->bandSet){
+        return user;
+    }
+    complete_user_from_json(user);
+
+    if(user->genreSet == NULL){
+        user->genreSet = create_bitmap(table->genreNames->count);
+        GenreLinkPosition genre = user->genres ? user->genres->next : NULL;
+        while(genre != NULL){
+            set_bitmap_bit(user->genreSet, intern_string(table->genreNames, genre->genre));
+            genre = genre->next;
+        }
+    }
+    if(user->bandSet == NULL){
+        user->bandSet = create_bitmap(table->bandNames->count);
+        BandLinkPosition band = user->bands ? user->bands->next : NULL;
+        while(band != NULL){
+            set_bitmap_bit(user->bandSet, intern_string(table->bandNames, band->band));
+            band = band->next;
+        }
+    }
+    if(table->tasteIndex){
+        update_tasteIndex_user(table->tasteIndex, user, table);
+    }
+    // Los gustos del usuario cambiaron, el grafo usuario-gusto se reconstruye al necesitarse
+    delete_tasteGraph(table->tasteGraph);
+    table->tasteGraph = NULL;
+    return user;
+}
+
+/**
+ * @brief Calcula el indice de Jaccard entre los generos de dos usuarios
+ *
+ * @param user1 Primer usuario
+ * @param user2 Segundo usuario
+ * @param table Tabla de usuarios
+ * @return Indice de Jaccard entre los generos de ambos usuarios
+*/
+double genres_jacardIndex(UserPosition user1, UserPosition user2, UserTable table)
+{
+    complete_user_tasteSets(user1, table);
+    complete_user_tasteSets(user2, table);
+    return jacardIndex_bitmap(user1->genreSet, user2->genreSet);
+}
+
+/**
+ * @brief Calcula el indice de Jaccard entre las bandas de dos usuarios
+ *
+ * @param user1 Primer usuario
+ * @param user2 Segundo usuario
+ * @param table Tabla de usuarios
+ * @return Indice de Jaccard entre las bandas de ambos usuarios
+*/
+double bands_jacardIndex(UserPosition user1, UserPosition user2, UserTable table)
+{
+    complete_user_tasteSets(user1, table);
+    complete_user_tasteSets(user2, table);
+    return jacardIndex_bitmap(user1->bandSet, user2->bandSet);
+}
+
 // Funciones de la lista de usuarios
 /**
  * @brief Crea una lista vacia de usuarios
@@ -467,11 +738,16 @@ UserPosition create_new_user(const char *username, int age, const char *national
     }
     strcpy(newUser->description, description);
 
+    newUser->ID = -1;
     newUser->comments = comments;
     newUser->age = age;
     newUser->genres = genres;
     newUser->bands = bands;
     newUser->friends = friends;
+    newUser->genreSet = NULL;
+    newUser->bandSet = NULL;
+    newUser->modified = false;
+    newUser->hydrated = false;
     newUser->next = NULL;
     return newUser;
 }
@@ -493,8 +769,8 @@ UserPosition insert_UserList_node(UserPosition prevPosition, UserPosition newNod
  * @brief Completa un nodo de una lista de usuarios
  *
  * @param P Puntero al nodo a completar
- * @param age Edad del usuario
- * @param nationality Nacionalidad del usuario
+ * @param age Edad del usuario (se usa solo si el nodo aun no tiene edad)
+ * @param nationality Nacionalidad del usuario (se usa solo si el nodo aun no tiene nacionalidad)
  * @param genres Gustos musicales del usuario
  * @return Puntero al nodo completado
 */
@@ -502,10 +778,14 @@ UserPosition complete_userList_node(UserPosition P, int age, const char *nationa
     if(P == NULL){
         print_error(202, NULL, NULL);
     }
-    P->age = age;
-
-    P->nationality = (char*)realloc(P->nationality, strlen(nationality) + 1);
-    strcpy(P->nationality, nationality);
+    // La edad y la nacionalidad de users.json son las de los indices de filtros: solo se completan si no venian
+    if(P->age == 0){
+        P->age = age;
+    }
+    if(P->nationality == NULL || strcmp(P->nationality, "NULL") == 0){
+        P->nationality = (char*)realloc(P->nationality, strlen(nationality) + 1);
+        strcpy(P->nationality, nationality);
+    }
 
     P->description = (char*)realloc(P->description, strlen(description) + 1);
     strcpy(P->description, description);
@@ -513,6 +793,12 @@ UserPosition complete_userList_node(UserPosition P, int age, const char *nationa
     P->comments = comments;
     P->genres = genres;
     P->bands = bands;
+
+    // Los gustos cambiaron, los conjuntos se vuelven a construir al necesitarse
+    delete_bitmap(P->genreSet);
+    delete_bitmap(P->bandSet);
+    P->genreSet = NULL;
+    P->bandSet = NULL;
     return P;
 }
 
@@ -537,6 +823,8 @@ bool delete_UserList_node(UserPosition P, UserList userList){
     delete_userLinkList(P->friends);
     delete_genreLinkList(P->genres);
     delete_bandLinkList(P->bands);
+    delete_bitmap(P->genreSet);
+    delete_bitmap(P->bandSet);
     free(P->username);
     free(P->nationality);
     free(P->description);
@@ -606,12 +894,33 @@ UserTable create_userTable(UserTable table){
         print_error(200,NULL,NULL);
     }
 
-    for(int i = 0; i < USER_TABLE_SIZE; i++)
+    table->bucketCount = USER_TABLE_SIZE;
+    table->buckets = (UserList*)malloc(sizeof(UserList) * table->bucketCount);
+    if(!table->buckets){
+        print_error(200,NULL,NULL);
+    }
+    for(int i = 0; i < table->bucketCount; i++)
     {
         table->buckets[i] = create_empty_UserList(NULL);
-        table->userCount = 0;
-        table->modified = false;
     }
+    table->userCount = 0;
+    table->modified = false;
+    table->usersByID = NULL;
+    table->idCount = 0;
+    table->idCapacity = 0;
+    table->version = 0;
+    table->graph = NULL;
+    table->genreNames = create_internTable(NULL);
+    table->bandNames = create_internTable(NULL);
+    table->tasteIndex = NULL;
+    table->tasteGraph = NULL;
+    table->popularity = NULL;
+    table->nameIndex = NULL;
+    table->nameTrigrams = NULL;
+    table->ageIndex = NULL;
+    table->nationalityIndex = NULL;
+    table->pool = NULL;
+    init_table_lock(&table->lock);
 
     return table;
 }
@@ -622,9 +931,23 @@ UserTable create_userTable(UserTable table){
  * @param table Puntero a la tabla de usuarios a borrar
 */
 void delete_userTable(UserTable table){
-    for(int i = 0; i < USER_TABLE_SIZE; i++){
+    for(int i = 0; i < table->bucketCount; i++){
         delete_UserList(table->buckets[i]);
     }
+    free(table->buckets);
+    delete_friendGraph(table->graph);
+    delete_internTable(table->genreNames);
+    delete_internTable(table->bandNames);
+    delete_tasteIndex(table->tasteIndex);
+    delete_tasteGraph(table->tasteGraph);
+    delete_popularity(table->popularity);
+    delete_userIndex(table->nameIndex);
+    delete_trigramIndex(table->nameTrigrams);
+    delete_ageIndex(table->ageIndex);
+    delete_nationalityIndex(table->nationalityIndex);
+    delete_threadPool(table->pool);
+    pthread_rwlock_destroy(&table->lock);
+    free(table->usersByID);
     free(table);
 }
 
@@ -644,7 +967,7 @@ UserPosition insert_userTable_node(UserTable table, const char *username, int ag
         return NULL;
     }
 
-    unsigned int index = jenkins_hash((char*)username) % USER_TABLE_SIZE;
+    unsigned int index = userTable_bucket(table, username);
 
     PtrToUser newUser = create_new_user(username, age, nationality, description, genres, bands, friends, comments);
     if (!newUser) {
@@ -652,7 +975,39 @@ UserPosition insert_userTable_node(UserTable table, const char *username, int ag
     }
     if(insert_UserList_node(table->buckets[index], newUser)){
         table->userCount++;
+        table->version += user_version_hash(username);
         table->modified = true;
+        if(table->userCount > USER_TABLE_LOAD * table->bucketCount){
+            resize_userTable(table, 2 * table->bucketCount);
+        }
+    }
+
+    // Asignamos el ID denso del usuario
+    if(table->idCount == table->idCapacity){
+        int newCapacity = table->idCapacity ? 2*table->idCapacity : 64;
+        PtrToUser* newUsersByID = (PtrToUser*)realloc(table->usersByID, sizeof(PtrToUser) * newCapacity);
+        if(newUsersByID == NULL){
+            print_error(200, NULL, NULL);
+        }
+        table->usersByID = newUsersByID;
+        table->idCapacity = newCapacity;
+    }
+    newUser->ID = table->idCount++;
+    table->usersByID[newUser->ID] = newUser;
+    if(table->graph){
+        ensure_friendGraph_node(table->graph, newUser->ID);
+    }
+    if(table->nameIndex){
+        insert_userIndex_user(table->nameIndex, newUser);
+    }
+    if(table->nameTrigrams){
+        insert_trigramIndex_name(table->nameTrigrams, newUser->ID, newUser->username);
+    }
+    if(table->ageIndex){
+        insert_ageIndex_user(table->ageIndex, newUser);
+    }
+    if(table->nationalityIndex){
+        insert_nationalityIndex_user(table->nationalityIndex, newUser);
     }
 
     return newUser;
@@ -666,8 +1021,65 @@ UserPosition insert_userTable_node(UserTable table, const char *username, int ag
  * @return Puntero al nodo del usuario encontrado, NULL si no existe
 */
 UserPosition find_userTable_node(UserTable table, const char *username){
-    unsigned int index = jenkins_hash((char*)username) % USER_TABLE_SIZE;
-    return find_UserList_node(table->buckets[index], username);
+    return find_UserList_node(table->buckets[userTable_bucket(table, username)], username);
+}
+
+/**
+ * @brief Calcula el bucket de la tabla de usuarios que corresponde a un nombre
+ *
+ * @param table Puntero a la tabla de usuarios
+ * @param username Nombre del usuario
+ * @return Indice del bucket
+*/
+unsigned int userTable_bucket(UserTable table, const char *username){
+    return jenkins_hash((char*)username) % table->bucketCount;
+}
+
+/**
+ * @brief Cambia la cantidad de buckets de la tabla de usuarios, moviendo cada usuario a su nuevo bucket
+ *
+ * Se llama al insertar cuando hay mas de USER_TABLE_LOAD usuarios por bucket, asi las busquedas por nombre siguen
+ * costando O(1) en redes grandes. Los nodos no se copian, por lo que los punteros a usuarios siguen siendo validos.
+ *
+ * @param table Puntero a la tabla de usuarios
+ * @param bucketCount Nueva cantidad de buckets
+*/
+void resize_userTable(UserTable table, int bucketCount){
+    UserList* buckets = (UserList*)malloc(sizeof(UserList) * bucketCount);
+    if(!buckets){
+        print_error(200,NULL,NULL);
+    }
+    for(int i = 0; i < bucketCount; i++){
+        buckets[i] = create_empty_UserList(NULL);
+    }
+    UserList* oldBuckets = table->buckets;
+    int oldCount = table->bucketCount;
+    table->buckets = buckets;
+    table->bucketCount = bucketCount;
+    for(int i = 0; i < oldCount; i++){
+        UserPosition aux = oldBuckets[i]->next;
+        while(aux != NULL){
+            UserPosition next = aux->next;
+            insert_UserList_node(table->buckets[userTable_bucket(table, aux->username)], aux);
+            aux = next;
+        }
+        free(oldBuckets[i]); // Solo el nodo cabecera, los usuarios ya se movieron
+    }
+    free(oldBuckets);
+}
+
+/**
+ * @brief Busca un usuario en una tabla de usuarios por su ID denso
+ *
+ * @param table Puntero a la tabla de usuarios
+ * @param ID ID del usuario a buscar
+ * @return Puntero al nodo del usuario, NULL si el ID no existe o fue borrado
+*/
+UserPosition find_userTable_node_byID(UserTable table, int ID){
+    if(ID < 0 || ID >= table->idCount){
+        return NULL;
+    }
+    return table->usersByID[ID];
 }
 
 /**
@@ -677,13 +1089,54 @@ UserPosition find_userTable_node(UserTable table, const char *username){
  * @param username Nombre del usuario a borrar
 */
 void delete_userTable_node(UserTable table, const char* username){
-    unsigned int index = jenkins_hash((char*)username) % USER_TABLE_SIZE;
-    if(delete_UserList_node(find_UserList_node(table->buckets[index], username), table->buckets[index])){
+    unsigned int index = userTable_bucket(table, username);
+    UserPosition userNode = find_UserList_node(table->buckets[index], username);
+    if(userNode && userNode->ID >= 0){
+        table->usersByID[userNode->ID] = NULL;
+        table->version -= user_version_hash(userNode->username);
+        for(UserLinkPosition aux = userNode->friends ? userNode->friends->next : NULL; aux != NULL; aux = aux->next){
+            table->version -= friendship_version_hash(userNode->username, aux->userName);
+        }
+        if(table->tasteIndex){
+            remove_tasteIndex_user(table->tasteIndex, userNode->ID);
+        }
+        // Los enlaces de amistad pueden apuntar al usuario borrado, el grafo se reconstruye al necesitarse
+        delete_friendGraph(table->graph);
+        table->graph = NULL;
+        delete_tasteGraph(table->tasteGraph);
+        table->tasteGraph = NULL;
+        if(table->nameIndex){
+            remove_userIndex_user(table->nameIndex, userNode);
+        }
+        if(table->nameTrigrams){
+            remove_trigramIndex_name(table->nameTrigrams, userNode->ID);
+        }
+        if(table->ageIndex){
+            remove_ageIndex_user(table->ageIndex, userNode);
+        }
+        if(table->nationalityIndex){
+            remove_nationalityIndex_user(table->nationalityIndex, userNode);
+        }
+    }
+    if(delete_UserList_node(userNode, table->buckets[index])){
         table->userCount--;
         table->modified = true;
     }
 }
 
+/**
+ * @brief Obtiene el pool de hilos de una tabla de usuarios, creandolo si aun no existe
+ *
+ * @param table Puntero a la tabla de usuarios
+ * @return Pool con un hilo por nucleo disponible
+*/
+ThreadPool get_userTable_threadPool(UserTable table){
+    if(table->pool == NULL){
+        table->pool = create_threadPool(0);
+    }
+    return table->pool;
+}
+
 /**
  * @brief Imprime la tabla de usuarios en la consola
  *
@@ -691,7 +1144,7 @@ void delete_userTable_node(UserTable table, const char* username){
 */
 void print_userTable(UserTable table){
     printf("Usuarios de la red (%d):\n", table->userCount);
-    for(int i=0; i<USER_TABLE_SIZE; i++){
+    for(int i=0; i<table->bucketCount; i++){
         printf("Bucket %2d: ", i);
         print_UserList(table->buckets[i]);
     }
@@ -713,7 +1166,7 @@ void save_userTable(UserTable userTable)
 
     bool first = true;
     fprintf(userTableFile, "[\n");
-    for(int i=0; i<USER_TABLE_SIZE; i++)
+    for(int i=0; i<userTable->bucketCount; i++)
     {
         if(!userTable->buckets[i]->next){
             continue;
@@ -726,7 +1179,34 @@ void save_userTable(UserTable userTable)
         }
         UserPosition aux = userTable->buckets[i]->next;
         while(aux != NULL){
-            fprintf(userTableFile, "\t{\n\t\t\"userName\":\"%s\",\n\t\t\"friends\":[", aux->username);
+            fprintf(userTableFile, "\t{\n\t\t\"userName\":\"%s\",\n\t\t\"age\":%d,\n\t\t\"nationality\":\"%s\",\n\t\t\"genres\":[", aux->username, aux->age, aux->nationality);
+            // Los generos y bandas salen del perfil si ya se leyo, o de los IDs internados leidos desde esta tabla
+            if(aux->genres){
+                for(GenreLinkPosition genre = aux->genres->next; genre != NULL; genre = genre->next){
+                    fprintf(userTableFile, "\"%s\"%s", genre->genre, genre->next ? ", " : "");
+                }
+            }
+            else if(aux->genreSet){
+                for(int genre = next_bitmap_bit(aux->genreSet, 0); genre >= 0; ){
+                    int next = next_bitmap_bit(aux->genreSet, genre + 1);
+                    fprintf(userTableFile, "\"%s\"%s", get_interned_string(userTable->genreNames, genre), next >= 0 ? ", " : "");
+                    genre = next;
+                }
+            }
+            fprintf(userTableFile, "],\n\t\t\"bands\":[");
+            if(aux->bands){
+                for(BandLinkPosition band = aux->bands->next; band != NULL; band = band->next){
+                    fprintf(userTableFile, "\"%s\"%s", band->band, band->next ? ", " : "");
+                }
+            }
+            else if(aux->bandSet){
+                for(int band = next_bitmap_bit(aux->bandSet, 0); band >= 0; ){
+                    int next = next_bitmap_bit(aux->bandSet, band + 1);
+                    fprintf(userTableFile, "\"%s\"%s", get_interned_string(userTable->bandNames, band), next >= 0 ? ", " : "");
+                    band = next;
+                }
+            }
+            fprintf(userTableFile, "],\n\t\t\"friends\":[");
             if(aux->friends->next){
                 UserLinkPosition aux2 = aux->friends->next;
                 while(aux2 != NULL){
@@ -748,6 +1228,72 @@ void save_userTable(UserTable userTable)
     fclose(userTableFile);
 }
 
+/**
+ * @brief Guarda los perfiles de los usuarios marcados como modificados
+ *
+ * @param table Tabla de usuarios
+ * @return Cantidad de perfiles guardados
+*/
+int save_modified_users(UserTable table)
+{
+    int saved = 0;
+    for(int ID=0; ID<table->idCount; ID++){
+        UserPosition user = table->usersByID[ID];
+        if(user && user->modified){
+            save_userNode(user);
+            saved++;
+        }
+    }
+    return saved;
+}
+
+
+// Funciones de la version de la red
+
+/**
+ * @brief Calcula la huella de un usuario dentro de la version de la red
+ *
+ * La version de la red es la suma de las huellas de sus usuarios y amistades, asi no depende del orden en que se
+ * leen y se actualiza en O(1) con cada usuario o amistad nueva. Se guarda junto a los resultados que dependen de la
+ * red (recomendaciones precalculadas, popularidad) para saber si siguen vigentes sin mirar las fechas de los archivos.
+ *
+ * @param username Nombre del usuario
+ * @return Huella del usuario
+*/
+uint64_t user_version_hash(const char* username)
+{
+    return mix_hash(jenkins_hash((char*)username));
+}
+
+/**
+ * @brief Calcula la huella de una amistad (@p user tiene a @p other en su lista de amigos) dentro de la version de la red
+ *
+ * @param user Nombre del usuario
+ * @param other Nombre del amigo
+ * @return Huella de la amistad
+*/
+uint64_t friendship_version_hash(const char* user, const char* other)
+{
+    return mix_hash(((uint64_t)jenkins_hash((char*)user) << 32 | jenkins_hash((char*)other)) ^ 0x9e3779b97f4a7c15ULL);
+}
+
+/**
+ * @brief Agrega a la version de la red las amistades de todos los usuarios de la tabla (se llama al leer users.json)
+ *
+ * @param table Tabla de usuarios
+*/
+void add_userTable_friendships_version(UserTable table)
+{
+    for(int ID=0; ID<table->idCount; ID++){
+        UserPosition user = table->usersByID[ID];
+        if(user == NULL || user->friends == NULL){
+            continue;
+        }
+        for(UserLinkPosition aux = user->friends->next; aux != NULL; aux = aux->next){
+            table->version += friendship_version_hash(user->username, aux->userName);
+        }
+    }
+}
 
 // Funciones de LoopWeb relacionadas a usuarios
 
@@ -795,7 +1341,7 @@ void make_comment(char* userName, UserTable userTable, BandTable bandTable, Genr
         }
     }while(option != 0);
 
-    CommentPosition commentNode = create_new_comment(time(NULL), commentText, userName);
+    CommentPosition commentNode = create_new_comment(next_comment_ID(comments), commentText, userName);
     insert_commentTable_comment(commentNode, comments);
     complete_comment_tags(commentNode);
     // Revisamos las bandas del comentario
@@ -805,17 +1351,31 @@ void make_comment(char* userName, UserTable userTable, BandTable bandTable, Genr
         BandPosition bandPosition = find_bandTable_band(bandAux->band, bandTable);
         if(!bandPosition)
         {
-            printf("La banda "ANSI_COLOR_GREEN"%s"ANSI_COLOR_RESET" no se encuentra en la base de datos, desea agregarla?: (0:Si, 1:No): ", bandAux->band);
-            if(scanf("%d", &option) != 1){
-                print_error(103, NULL, NULL);
-                bandAux = bandAux->next;
-                continue;
+            // Puede ser una banda existente mal escrita
+            printf("La banda "ANSI_COLOR_GREEN"%s"ANSI_COLOR_RESET" no se encuentra en la base de datos\n", bandAux->band);
+            const char* bandName = ask_name_suggestion(get_bandTable_completions(bandTable), get_bandTable_trigrams(bandTable), bandAux->band);
+            if(bandName){
+                replace_comment_tag(commentNode, '@', bandAux->band, bandName);
+                replace_string(&bandAux->band, bandName);
+                bandPosition = find_bandTable_band(bandAux->band, bandTable);
             }
-            if(option == 0){
-                bandPosition = insert_bandTable_band(bandAux->band, bandTable);
+            else{
+                printf("Desea agregarla?: (0:Si, 1:No): ");
+                if(scanf("%d", &option) != 1){
+                    print_error(103, NULL, NULL);
+                    bandAux = bandAux->next;
+                    continue;
+                }
+                if(option == 0){
+                    bandPosition = insert_bandTable_band(bandAux->band, bandTable);
+                }
             }
         }
-        insert_commentLinkList_node_completeInfo(bandPosition->comments, commentNode); // Se agrega el comentario a la banda correspondiente
+        if(!bandPosition){ // La banda no se agrego a la red
+            bandAux = bandAux->next;
+            continue;
+        }
+        link_comment_band(commentNode, bandPosition, bandTable); // Se agrega el comentario a la banda correspondiente
         bandAux = bandAux->next;
     }
 
@@ -826,27 +1386,35 @@ void make_comment(char* userName, UserTable userTable, BandTable bandTable, Genr
         GenrePosition genrePosition = find_genresTable_genre(genreAux->genre, genreTable);
         if(!genrePosition)
         {
-            printf("El genero "ANSI_COLOR_RED"%s"ANSI_COLOR_RESET" no se encuentra en la base de datos, desea agregarlo?: (0:Si, 1:No): ", genreAux->genre);
-            if(scanf("%d", &option) != 1){
-                print_error(103, NULL, NULL);
-                genreAux = genreAux->next;
-                continue;
+            // Puede ser un genero existente mal escrito
+            printf("El genero "ANSI_COLOR_RED"%s"ANSI_COLOR_RESET" no se encuentra en la base de datos\n", genreAux->genre);
+            const char* genreName = ask_name_suggestion(get_genresTable_completions(genreTable), get_genresTable_trigrams(genreTable), genreAux->genre);
+            if(genreName){
+                replace_comment_tag(commentNode, '#', genreAux->genre, genreName);
+                replace_string(&genreAux->genre, genreName);
+                genrePosition = find_genresTable_genre(genreAux->genre, genreTable);
             }
-            if(option == 0){
-                genrePosition = insert_genre(genreAux->genre, genreTable);
+            else{
+                printf("Desea agregarlo?: (0:Si, 1:No): ");
+                if(scanf("%d", &option) != 1){
+                    print_error(103, NULL, NULL);
+                    genreAux = genreAux->next;
+                    continue;
+                }
+                if(option == 0){
+                    genrePosition = insert_genre(genreAux->genre, genreTable);
+                }
             }
         }
-        insert_commentLinkList_node_completeInfo(genrePosition->comments, commentNode); // Se agrega el comentario a la banda correspondiente
+        if(!genrePosition){ // El genero no se agrego a la red
+            genreAux = genreAux->next;
+            continue;
+        }
+        link_comment_genre(commentNode, genrePosition, genreTable); // Se agrega el comentario al genero correspondiente
         genreAux = genreAux->next;
     }
 
-    // Guardamos los comentarios en donde corresponde
-    save_commentNode(commentNode); // Se guarda en el archivo correspondiente
-    insert_commentLinkList_node_completeInfo(author->comments, commentNode); // Se guarda en la lista de comentarios del autor
-    save_userNode(author);
-    save_bandTable(bandTable);
-    save_genresTable(genreTable);
-    save_commentTable(comments);
+    publish_comment(commentNode, author, bandTable, genreTable, comments, true);
 
     sleep(1);
     printf(CLEAR_SCREEN"El siguiente comentario fue agregado a loopweb:\n\n");
@@ -854,6 +1422,110 @@ void make_comment(char* userName, UserTable userTable, BandTable bandTable, Genr
 
 }
 
+/**
+ * @brief Publica un comentario sin interactuar con el usuario
+ *
+ * Las etiquetas que no corresponden a una banda o genero de la red se dejan en el texto pero no se enlazan.
+ *
+ * @param author Autor del comentario
+ * @param text Texto del comentario
+ * @param bandTable Tabla de bandas
+ * @param genreTable Tabla de generos
+ * @param comments Tabla de comentarios
+ * @param save TRUE para guardar de inmediato, FALSE para solo marcar lo modificado (ver `publish_comment`)
+ * @return Comentario publicado
+*/
+CommentPosition post_comment(UserPosition author, const char* text, BandTable bandTable, GenreTable genreTable, CommentTable comments, bool save)
+{
+    author = complete_user_from_json(author);
+    CommentPosition commentNode = create_new_comment(next_comment_ID(comments), text, author->username);
+    insert_commentTable_comment(commentNode, comments);
+    complete_comment_tags(commentNode);
+
+    for(BandLinkPosition aux = commentNode->bands->next; aux != NULL; aux = aux->next){
+        BandPosition bandPosition = find_bandTable_band(aux->band, bandTable);
+        if(bandPosition){
+            link_comment_band(commentNode, bandPosition, bandTable);
+        }
+    }
+    for(GenreLinkPosition aux = commentNode->genres->next; aux != NULL; aux = aux->next){
+        GenrePosition genrePosition = find_genresTable_genre(aux->genre, genreTable);
+        if(genrePosition){
+            link_comment_genre(commentNode, genrePosition, genreTable);
+        }
+    }
+
+    publish_comment(commentNode, author, bandTable, genreTable, comments, save);
+    return commentNode;
+}
+
+/**
+ * @brief Enlaza un comentario a una banda
+ *
+ * @param comment Comentario
+ * @param band Banda mencionada en el comentario
+ * @param bandTable Tabla de bandas (para actualizar el peso de la banda en las sugerencias)
+*/
+void link_comment_band(CommentPosition comment, BandPosition band, BandTable bandTable)
+{
+    insert_commentLinkList_node_completeInfo(band->comments, comment);
+    if(bandTable->completions){
+        add_prefixTrie_weight(bandTable->completions, band->band, 1);
+    }
+}
+
+/**
+ * @brief Enlaza un comentario a un genero
+ *
+ * @param comment Comentario
+ * @param genre Genero mencionado en el comentario
+ * @param genreTable Tabla de generos (para actualizar el peso del genero en las sugerencias)
+*/
+void link_comment_genre(CommentPosition comment, GenrePosition genre, GenreTable genreTable)
+{
+    insert_commentLinkList_node_completeInfo(genre->comments, comment);
+    if(genreTable->completions){
+        add_prefixTrie_weight(genreTable->completions, genre->genre, 1);
+    }
+}
+
+/**
+ * @brief Termina de publicar un comentario ya enlazado a sus bandas y generos
+ *
+ * Agrega el comentario al indice de texto (si existe) y a la lista del autor. Con @p save se guardan de inmediato
+ * el comentario, el perfil del autor y las tablas; sin el, solo se marcan como modificados y quien llama debe
+ * guardar el archivo del comentario con `save_commentNode` antes de terminar.
+ *
+ * @param comment Comentario a publicar
+ * @param author Autor del comentario
+ * @param bandTable Tabla de bandas
+ * @param genreTable Tabla de generos
+ * @param comments Tabla de comentarios
+ * @param save TRUE para guardar de inmediato
+*/
+void publish_comment(CommentPosition comment, UserPosition author, BandTable bandTable, GenreTable genreTable, CommentTable comments, bool save)
+{
+    // El texto ya no cambia, se agregan sus palabras al indice si ya fue construido
+    if(comments->textIndex){
+        insert_textIndex_comment(comments->textIndex, comment);
+    }
+    insert_commentLinkList_node_completeInfo(author->comments, comment); // Se guarda en la lista de comentarios del autor
+
+    if(save){
+        save_commentNode(comment); // Se guarda en el archivo correspondiente
+        save_userNode(author);
+        save_bandTable(bandTable);
+        save_genresTable(genreTable);
+        save_commentTable(comments);
+    }
+    else{
+        author->modified = true;
+        bandTable->modified = true;
+        genreTable->modified = true;
+        comments->modified = true;
+    }
+}
+
 /**
  * @brief Imprime de manera estetica la tabla de usuarios y devuelve la lista de enlaces a todos los usuarios
  *
@@ -865,7 +1537,7 @@ UserLinkList get_loopweb_users(UserTable table, bool print)
 {
     UserLinkList allUsers = create_empty_userLinkList(NULL);
 
-    for(int i=0; i<USER_TABLE_SIZE; i++){
+    for(int i=0; i<table->bucketCount; i++){
         UserPosition aux = table->buckets[i]->next;
         while(aux != NULL){
             insert_userLinkList_node_completeInfo(allUsers, aux);
@@ -914,34 +1586,13 @@ void request_for_friendship(UserPosition user, UserLinkList possibleFriends, Use
         aux = possibleFriends->next;
         while(aux != NULL){
             if(counter == friendOption){
-                if(find_userLinkList_node(user->friends, aux->userName)){
+                aux = complete_userLinkList_node(aux, table);
+                if(make_friendship(user, aux->userNode, table, true)){
+                    printf("Ahora eres amigo/a de "ANSI_COLOR_CYAN"%s"ANSI_COLOR_RESET"\n", aux->userNode->username);
+                }
+                else{
                     printf("Ya eres amigo/a de "ANSI_COLOR_CYAN"%s"ANSI_COLOR_RESET"\n", aux->userName);
-                    counter++;
-                    aux = aux->next;
-                    continue;
                 }
-                // Evitamos errores por ausencia de punteros
-                aux = complete_userLinkList_node(aux, table);
-                aux->userNode = complete_user_from_json(aux->userNode);
-                user = complete_user_from_json(user);
-
-                // Generamos amistad
-                insert_userLinkList_node_completeInfo(user->friends, aux->userNode);
-                #ifdef DEBUG
-                    printf("Lista de amigos de "ANSI_COLOR_CYAN"%s"ANSI_COLOR_RESET" actualizada:\n", user->username);
-                    print_userLinkList(user->friends);
-                    printf("\n");
-                #endif
-                save_userNode(user);
-                insert_userLinkList_node_completeInfo(aux->userNode->friends, user);
-                #ifdef DEBUG
-                    printf("Lista de amigos de "ANSI_COLOR_CYAN"%s"ANSI_COLOR_RESET" actualizada:\n", aux->userNode->username);
-                    print_userLinkList(aux->userNode->friends);
-                    printf("\n");
-                #endif
-                save_userNode(aux->userNode);
-                printf("Ahora eres amigo/a de "ANSI_COLOR_CYAN"%s"ANSI_COLOR_RESET"\n", aux->userNode->username);
-                table->modified = true;
                 break;
             }
             counter++;
@@ -953,6 +1604,52 @@ void request_for_friendship(UserPosition user, UserLinkList possibleFriends, Use
     }
 }
 
+/**
+ * @brief Crea una amistad entre dos usuarios
+ *
+ * @param user Primer usuario
+ * @param other Segundo usuario
+ * @param table Tabla de usuarios (se actualizan el grafo de amistades y la popularidad si ya existen)
+ * @param save TRUE para guardar ambos perfiles de inmediato, FALSE para solo marcarlos como modificados
+ * @return TRUE si se creo la amistad, FALSE si ya eran amigos o son el mismo usuario
+*/
+bool make_friendship(UserPosition user, UserPosition other, UserTable table, bool save)
+{
+    // Evitamos errores por ausencia de punteros
+    user = complete_user_from_json(user);
+    other = complete_user_from_json(other);
+    if(user == other || find_userLinkList_node(user->friends, other->username)){
+        return false;
+    }
+
+    insert_userLinkList_node_completeInfo(user->friends, other);
+    table->version += friendship_version_hash(user->username, other->username);
+    if(!find_userLinkList_node(other->friends, user->username)){ // Puede que ya fuera una amistad de un solo sentido
+        insert_userLinkList_node_completeInfo(other->friends, user);
+        table->version += friendship_version_hash(other->username, user->username);
+    }
+    #ifdef DEBUG
+        printf("Lista de amigos de "ANSI_COLOR_CYAN"%s"ANSI_COLOR_RESET" actualizada:\n", user->username);
+        print_userLinkList(user->friends);
+        printf("\n");
+    #endif
+    if(save){
+        save_userNode(user);
+        save_userNode(other);
+    }
+    else{
+        user->modified = true;
+        other->modified = true;
+    }
+    if(table->graph){
+        add_friendGraph_edge(table->graph, user->ID, other->ID);
+        add_friendGraph_edge(table->graph, other->ID, user->ID);
+    }
+    refresh_popularity(table, user->ID, other->ID);
+    table->modified = true;
+    return true;
+}
+
 /**
  * @brief Interactua con un usuario para crear su perfil
  *
@@ -1028,7 +1725,7 @@ UserPosition create_user_profile(UserTable users, BandTable bands, GenreTable ge
         }
         while (getchar() != '\n'); // Limpiamos el buffer de entrada
 
-        if(age >= 18 && age <= 99){
+        if(age >= USER_MIN_AGE && age <= USER_MAX_AGE){
             notValid = false;
         }
 
@@ -1125,9 +1822,10 @@ UserPosition create_user_profile(UserTable users, BandTable bands, GenreTable ge
     printf("A continuacion, ingrese los gustos musicales de su perfil (Puede no estar en la lista): \n");
     GenreLinkList programGenreList = get_loopweb_genres(genres);
     GenrePosition genrePosition;
+    const char* genreName;
     do{
         printf("Genro: ");
-        if(scanf("%s", genreText) != 1){
+        if(scanf("%19s", genreText) != 1){
             print_error(103, NULL, NULL);
             continue;
         }
@@ -1137,6 +1835,11 @@ UserPosition create_user_profile(UserTable users, BandTable bands, GenreTable ge
             insert_genreLinkList_node_completeInfo(genresList, genrePosition);
             notValid = false;
         }
+        else if((genreName = ask_name_suggestion(get_genresTable_completions(genres), get_genresTable_trigrams(genres), genreText)) != NULL){
+            // El usuario eligio un genero existente que completa o se parece al ingresado
+            insert_genreLinkList_node_completeInfo(genresList, find_genresTable_genre((char*)genreName, genres));
+            notValid = false;
+        }
         else{
             printf("El genero "ANSI_COLOR_RED"\"%s\""ANSI_COLOR_RESET" no existe, desea ingresarlo en la tabla de generos? (0:si, 1:no): ", genreText);
             if(scanf("%d", &option) != 1){
@@ -1168,9 +1871,10 @@ UserPosition create_user_profile(UserTable users, BandTable bands, GenreTable ge
     printf("A continuacion, ingrese las bandas de su perfil (Puede no estar en la lista): \n");
     BandLinkList programBandList = get_loopweb_bands(bands);
     BandPosition bandPosition;
+    const char* bandName;
     do{
         printf("Banda: ");
-        if(scanf("%s", bandText) != 1){
+        if(scanf("%19s", bandText) != 1){
             print_error(103, NULL, NULL);
             continue;
         }
@@ -1180,6 +1884,11 @@ UserPosition create_user_profile(UserTable users, BandTable bands, GenreTable ge
             insert_bandLinkList_node_completeInfo(bandsList, bandPosition);
             notValid = false;
         }
+        else if((bandName = ask_name_suggestion(get_bandTable_completions(bands), get_bandTable_trigrams(bands), bandText)) != NULL){
+            // El usuario eligio una banda existente que completa o se parece a la ingresada
+            insert_bandLinkList_node_completeInfo(bandsList, find_bandTable_band((char*)bandName, bands));
+            notValid = false;
+        }
         else{
             printf("La banda "ANSI_COLOR_GREEN"\"%s\""ANSI_COLOR_RESET" no existe, desea ingresarla en la tabla de bandas? (0:si, 1:no): ", bandText);
             if(scanf("%d", &option) != 1){
@@ -1212,31 +1921,8 @@ UserPosition create_user_profile(UserTable users, BandTable bands, GenreTable ge
     print_user(user);
 
     // Damos la posibilidad de tener amigos
-    UserLinkList possibleFriends = find_possible_friends(user, users);
-    UserLinkPosition aux = possibleFriends->next;
-    while(aux != NULL){
-        complete_userLinkList_node(aux, users);
-        if(aux == NULL){
-            continue;
-        }
-        complete_user_from_json(aux->userNode);
-        /* Se calcula el coeficiente para cada usuario como sigue:
-            - Un 20% del valor dado por la diferencia de edades
-            - Un 40% del valor dado por el indice de Jaccard entre los generos de ambos usuarios
-            - Un 60% del valor dado por el indice de Jaccard entre las bandas de ambos usuarios
-        Esto da un maximo del indice de 1.0 */
-        aux->coefficient = 0;
-        #ifdef DEBUG
-            printf("%s AND %s\n", aux->userName, user->username);
-        #endif
-        aux->coefficient += 0.2 * pow(EULER, -0.09*abs(user->age - aux->userNode->age)); // Coeficiente de edad (Lo tomamos como una variable aleatoria de tipo exponencial)
-        aux->coefficient += 0.4 * jacardIndex_genreLinkList(user->genres, aux->userNode->genres);
-        aux->coefficient += 0.4 * jacardIndex_bandLinkList(user->bands, aux->userNode->bands);
-
-        aux = aux->next;
-    }
-    sort_userLinkList_byCoefficient(&possibleFriends->next);
-    print_user_recommendations(user, possibleFriends);
+    UserLinkList possibleFriends = compute_user_recommendations(user, users, get_userTable_threadPool(users), RECOMMENDATIONS_SIZE);
+    print_user_recommendations(user, possibleFriends, users);
     request_for_friendship(user, possibleFriends, users);
 
     // Liberamos toda la memoria utilizada
@@ -0,0 +1,449 @@
+/**
+ * @file userFilter.c
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Indices secundarios de edad y nacionalidad para filtrar usuarios sin leer sus perfiles
+*/
+#include "userFilter.h"
+
+// Funciones del indice de edades
+
+/**
+ * @brief Crea un indice de edades vacio
+ *
+ * @param capacity Cantidad de usuarios a reservar inicialmente
+ * @return Puntero al indice creado
+*/
+AgeIndex create_ageIndex(int capacity)
+{
+    AgeIndex index = (AgeIndex)malloc(sizeof(struct _ageIndex));
+    if(index == NULL){
+        print_error(200, NULL, NULL);
+    }
+    index->capacity = capacity > 0 ? capacity : 64;
+    index->users = (PtrToUser*)malloc(sizeof(PtrToUser) * index->capacity);
+    if(index->users == NULL){
+        print_error(200, NULL, NULL);
+    }
+    index->count = 0;
+    return index;
+}
+
+/**
+ * @brief Borra un indice de edades (los usuarios no se borran)
+ *
+ * @param index Indice a borrar
+*/
+void delete_ageIndex(AgeIndex index)
+{
+    if(index == NULL){
+        return;
+    }
+    free(index->users);
+    free(index);
+}
+
+/**
+ * @brief Completa desde su perfil a los usuarios cuya edad o nacionalidad no venia en users.json
+ *
+ * Se llama antes de construir los indices de filtros: despues `complete_userList_node` ya no cambia esos campos,
+ * por lo que ningun usuario queda en un lugar del indice que no corresponde a su edad o nacionalidad.
+ *
+ * @param table Tabla de usuarios
+*/
+void complete_filter_fields(UserTable table)
+{
+    for(int ID=0; ID<table->idCount; ID++){
+        PtrToUser user = table->usersByID[ID];
+        if(user && (user->age == 0 || strcmp(user->nationality, "NULL") == 0)){
+            complete_user_from_json(user);
+        }
+    }
+}
+
+/**
+ * @brief Construye el indice de edades con todos los usuarios de la tabla
+ *
+ * @param table Tabla de usuarios
+ * @return Indice construido
+ * @note Los usuarios se recorren por ID, por lo que basta un ordenamiento estable por edad: counting sort sobre las
+ * edades (que no son negativas), O(n + edad maxima)
+*/
+AgeIndex build_ageIndex(UserTable table)
+{
+    complete_filter_fields(table);
+    AgeIndex index = create_ageIndex(table->userCount);
+    int maxAge = 0;
+    for(int ID=0; ID<table->idCount; ID++){
+        if(table->usersByID[ID] && table->usersByID[ID]->age > maxAge){
+            maxAge = table->usersByID[ID]->age;
+        }
+    }
+    int* starts = (int*)calloc(maxAge + 2, sizeof(int));
+    if(starts == NULL){
+        print_error(200, NULL, NULL);
+    }
+    for(int ID=0; ID<table->idCount; ID++){
+        if(table->usersByID[ID]){
+            starts[table->usersByID[ID]->age + 1]++;
+        }
+    }
+    for(int age=1; age<=maxAge + 1; age++){
+        starts[age] += starts[age - 1];
+    }
+    for(int ID=0; ID<table->idCount; ID++){
+        PtrToUser user = table->usersByID[ID];
+        if(user){
+            index->users[starts[user->age]++] = user;
+            index->count++;
+        }
+    }
+    free(starts);
+    return index;
+}
+
+/**
+ * @brief Obtiene el indice de edades de una tabla de usuarios, construyendolo si aun no existe
+ *
+ * @param table Tabla de usuarios
+ * @return Indice de edades de la tabla
+*/
+AgeIndex get_ageIndex(UserTable table)
+{
+    if(table->ageIndex == NULL){
+        table->ageIndex = build_ageIndex(table);
+    }
+    return table->ageIndex;
+}
+
+/**
+ * @brief Busca la primera posicion del indice cuyo usuario va despues de (@p age, @p ID) o en su lugar
+ *
+ * @param index Indice de edades
+ * @param age Edad a buscar
+ * @param ID ID a igual edad (-1 para la primera posicion con la edad)
+ * @return Posicion encontrada (index->count si todos los usuarios van antes)
+*/
+int find_ageIndex_position(AgeIndex index, int age, int ID)
+{
+    int low = 0, high = index->count;
+    while(low < high){
+        int mid = low + (high - low)/2;
+        PtrToUser user = index->users[mid];
+        if(user->age < age || (user->age == age && user->ID < ID)){
+            low = mid + 1;
+        }
+        else{
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/**
+ * @brief Inserta un usuario en el indice manteniendo el orden
+ *
+ * @param index Indice de edades
+ * @param user Usuario a insertar
+*/
+void insert_ageIndex_user(AgeIndex index, PtrToUser user)
+{
+    if(index->count == index->capacity){
+        int newCapacity = 2*index->capacity;
+        PtrToUser* newUsers = (PtrToUser*)realloc(index->users, sizeof(PtrToUser) * newCapacity);
+        if(newUsers == NULL){
+            print_error(200, NULL, NULL);
+        }
+        index->users = newUsers;
+        index->capacity = newCapacity;
+    }
+    int position = find_ageIndex_position(index, user->age, user->ID);
+    memmove(&index->users[position + 1], &index->users[position], sizeof(PtrToUser) * (index->count - position));
+    index->users[position] = user;
+    index->count++;
+}
+
+/**
+ * @brief Quita un usuario del indice
+ *
+ * @param index Indice de edades
+ * @param user Usuario a quitar
+*/
+void remove_ageIndex_user(AgeIndex index, PtrToUser user)
+{
+    int position = find_ageIndex_position(index, user->age, user->ID);
+    if(position == index->count || index->users[position] != user){
+        return;
+    }
+    memmove(&index->users[position], &index->users[position + 1], sizeof(PtrToUser) * (index->count - position - 1));
+    index->count--;
+}
+
+/**
+ * @brief Busca el rango de usuarios con edad entre @p minAge y @p maxAge (inclusive)
+ *
+ * @param index Indice de edades
+ * @param minAge Edad minima
+ * @param maxAge Edad maxima
+ * @param first Donde se guarda la posicion del primer usuario del rango
+ * @return Cantidad de usuarios del rango
+ * @note Costo O(log n)
+*/
+int find_ageIndex_range(AgeIndex index, int minAge, int maxAge, int* first)
+{
+    *first = find_ageIndex_position(index, minAge, -1);
+    if(maxAge < minAge){
+        return 0;
+    }
+    return find_ageIndex_position(index, maxAge + 1, -1) - *first;
+}
+
+// Funciones del indice de nacionalidades
+
+/**
+ * @brief Crea un indice de nacionalidades vacio
+ *
+ * @return Puntero al indice creado
+*/
+NationalityIndex create_nationalityIndex()
+{
+    NationalityIndex index = (NationalityIndex)malloc(sizeof(struct _nationalityIndex));
+    if(index == NULL){
+        print_error(200, NULL, NULL);
+    }
+    index->names = create_internTable(NULL);
+    index->users = NULL;
+    index->capacity = 0;
+    return index;
+}
+
+/**
+ * @brief Borra un indice de nacionalidades
+ *
+ * @param index Indice a borrar
+*/
+void delete_nationalityIndex(NationalityIndex index)
+{
+    if(index == NULL){
+        return;
+    }
+    for(int i=0; i<index->names->count; i++){
+        delete_bitmap(index->users[i]);
+    }
+    free(index->users);
+    delete_internTable(index->names);
+    free(index);
+}
+
+/**
+ * @brief Construye el indice de nacionalidades con todos los usuarios de la tabla
+ *
+ * @param table Tabla de usuarios
+ * @return Indice construido
+*/
+NationalityIndex build_nationalityIndex(UserTable table)
+{
+    complete_filter_fields(table);
+    NationalityIndex index = create_nationalityIndex();
+    for(int ID=0; ID<table->idCount; ID++){
+        if(table->usersByID[ID]){
+            insert_nationalityIndex_user(index, table->usersByID[ID]);
+        }
+    }
+    return index;
+}
+
+/**
+ * @brief Obtiene el indice de nacionalidades de una tabla de usuarios, construyendolo si aun no existe
+ *
+ * @param table Tabla de usuarios
+ * @return Indice de nacionalidades de la tabla
+*/
+NationalityIndex get_nationalityIndex(UserTable table)
+{
+    if(table->nationalityIndex == NULL){
+        table->nationalityIndex = build_nationalityIndex(table);
+    }
+    return table->nationalityIndex;
+}
+
+/**
+ * @brief Agrega un usuario al bitmap de su nacionalidad
+ *
+ * @param index Indice de nacionalidades
+ * @param user Usuario a agregar
+*/
+void insert_nationalityIndex_user(NationalityIndex index, PtrToUser user)
+{
+    int nationality = intern_string(index->names, user->nationality);
+    if(nationality >= index->capacity){
+        int newCapacity = index->capacity > 0 ? 2*index->capacity : 16;
+        Bitmap* newUsers = (Bitmap*)realloc(index->users, sizeof(Bitmap) * newCapacity);
+        if(newUsers == NULL){
+            print_error(200, NULL, NULL);
+        }
+        for(int i=index->capacity; i<newCapacity; i++){
+            newUsers[i] = NULL;
+        }
+        index->users = newUsers;
+        index->capacity = newCapacity;
+    }
+    if(index->users[nationality] == NULL){
+        index->users[nationality] = create_bitmap(user->ID + 1);
+    }
+    set_bitmap_bit(index->users[nationality], user->ID);
+}
+
+/**
+ * @brief Quita un usuario del bitmap de su nacionalidad
+ *
+ * @param index Indice de nacionalidades
+ * @param user Usuario a quitar
+*/
+void remove_nationalityIndex_user(NationalityIndex index, PtrToUser user)
+{
+    Bitmap users = find_nationalityIndex_users(index, user->nationality);
+    if(users){
+        unset_bitmap_bit(users, user->ID);
+    }
+}
+
+/**
+ * @brief Obtiene los usuarios de una nacionalidad
+ *
+ * @param index Indice de nacionalidades
+ * @param nationality Nacionalidad buscada
+ * @return Bitmap con los IDs de los usuarios (pertenece al indice), NULL si no hay usuarios con esa nacionalidad
+*/
+Bitmap find_nationalityIndex_users(NationalityIndex index, const char* nationality)
+{
+    int ID = find_internTable_ID(index->names, (char*)nationality);
+    return ID >= 0 ? index->users[ID] : NULL;
+}
+
+// Funciones de filtrado
+
+/**
+ * @brief Indica si a un usuario le gusta un genero sin leer su perfil si no es necesario
+ *
+ * @param user Usuario a revisar
+ * @param genreID ID internado del genero (-1 si ningun usuario leido desde la tabla lo tiene)
+ * @param genre Nombre del genero
+ * @return TRUE si el genero esta entre los gustos del usuario
+*/
+bool user_has_genre(PtrToUser user, int genreID, const char* genre)
+{
+    if(user->genreSet){ // Leido desde la tabla de usuarios o ya calculado
+        return test_bitmap_bit(user->genreSet, genreID);
+    }
+    if(user->genres == NULL){ // No deberia pasar, la tabla trae los generos o el usuario se leyo al cargarla
+        complete_user_from_json(user);
+    }
+    for(GenreLinkPosition aux = user->genres->next; aux != NULL; aux = aux->next){
+        if(strcmp(aux->genre, genre) == 0){
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Busca los usuarios que cumplen un filtro de edad, nacionalidad y genero
+ *
+ * Se recorre el rango de edades del indice de edades y de el se conservan los usuarios cuyo bit esta encendido en
+ * el bitmap de la nacionalidad y que tienen el genero entre sus gustos. Todo se responde con los datos de la tabla
+ * de usuarios, sin abrir ningun perfil.
+ *
+ * @param table Tabla de usuarios
+ * @param minAge Edad minima
+ * @param maxAge Edad maxima
+ * @param nationality Nacionalidad buscada (FILTER_ANY para cualquiera)
+ * @param genre Genero buscado (FILTER_ANY para cualquiera)
+ * @return Lista de enlaces a los usuarios encontrados, de menor a mayor edad
+*/
+UserLinkList filter_users(UserTable table, int minAge, int maxAge, const char* nationality, const char* genre)
+{
+    UserLinkList users = create_empty_userLinkList(NULL);
+    Bitmap countryUsers = NULL;
+    if(strcmp(nationality, FILTER_ANY) != 0){
+        countryUsers = find_nationalityIndex_users(get_nationalityIndex(table), nationality);
+        if(countryUsers == NULL){
+            return users;
+        }
+    }
+    bool anyGenre = strcmp(genre, FILTER_ANY) == 0;
+    int genreID = anyGenre ? -1 : find_internTable_ID(table->genreNames, (char*)genre);
+
+    AgeIndex ages = get_ageIndex(table);
+    int first;
+    int count = find_ageIndex_range(ages, minAge, maxAge, &first);
+    UserLinkPosition last = users;
+    for(int i=first; i<first + count; i++){
+        PtrToUser user = ages->users[i];
+        if(countryUsers && !test_bitmap_bit(countryUsers, user->ID)){
+            continue;
+        }
+        if(!anyGenre && !user_has_genre(user, genreID, genre)){
+            continue;
+        }
+        last = insert_userLinkList_node_completeInfo(last, user);
+    }
+    return users;
+}
+
+// Funciones de interaccion con el usuario
+
+/**
+ * @brief Imprime una tabla con los usuarios de un filtro
+ *
+ * @param users Lista de usuarios (ver `filter_users`)
+ * @param table Tabla de usuarios
+*/
+void print_filtered_users(UserLinkList users, UserTable table)
+{
+    FriendGraph graph = get_friendGraph(table);
+    int counter = 0;
+    printf("______________________________________________________________\n");
+    printf("| ID |        Nombre       |    Edad   |  Nacionalidad  | Amigos |\n");
+    for(UserLinkPosition aux = users->next; aux != NULL; aux = aux->next){
+        counter++;
+        printf("| %-3d|        "ANSI_COLOR_CYAN"%-13s"ANSI_COLOR_RESET"|"ANSI_COLOR_MAGENTA"    %-7d"ANSI_COLOR_RESET"|"ANSI_COLOR_YELLOW" %-15s"ANSI_COLOR_RESET"|  %-6d|\n", counter, aux->userName, aux->userNode->age, aux->userNode->nationality, friendGraph_degree(graph, aux->userNode->ID));
+    }
+    printf("______________________________________________________________\n");
+    printf("%d usuarios encontrados\n\n", counter);
+}
+
+/**
+ * @brief Pide un filtro de edad, nacionalidad y genero y muestra los usuarios que lo cumplen
+ *
+ * @param table Tabla de usuarios
+*/
+void filter_users_menu(UserTable table)
+{
+    int minAge, maxAge;
+    char nationality[50];
+    char genre[50];
+
+    printf("Ingrese la edad minima y maxima (Ej: 20 25): ");
+    if(scanf("%d %d", &minAge, &maxAge) != 2){
+        print_error(103, NULL, NULL);
+        return;
+    }
+    // Limpiamos el buffer de entrada (la nacionalidad puede tener espacios, Ej: South Africa)
+    while (getchar() != '\n');
+    printf("Ingrese la nacionalidad ("FILTER_ANY" para cualquiera): ");
+    if(fgets(nationality, sizeof(nationality), stdin) == NULL){
+        print_error(103, NULL, NULL);
+        return;
+    }
+    nationality[strcspn(nationality, "\n")] = '\0';
+    printf("Ingrese el genero ("FILTER_ANY" para cualquiera): ");
+    if(scanf("%49s", genre) != 1){
+        print_error(103, NULL, NULL);
+        return;
+    }
+
+    UserLinkList users = filter_users(table, minAge, maxAge, nationality, genre);
+    printf(CLEAR_SCREEN);
+    print_filtered_users(users, table);
+    delete_userLinkList(users);
+}
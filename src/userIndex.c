@@ -0,0 +1,293 @@
+/**
+ * @file userIndex.c
+ * @author Constanza Araya, Rodolfo Cifuentes, Bruno Martinez, Milton Hernández, Guliana Ruiz
+ * @brief Indice ordenado de nombres de usuario para busquedas por prefijo y listados por paginas
+*/
+#include "userIndex.h"
+
+// Funciones del indice de nombres de usuario
+
+/**
+ * @brief Crea un indice de nombres vacio
+ *
+ * @param capacity Cantidad de usuarios a reservar inicialmente
+ * @return Puntero al indice creado
+*/
+UserIndex create_userIndex(int capacity)
+{
+    UserIndex index = (UserIndex)malloc(sizeof(struct _userIndex));
+    if(index == NULL){
+        print_error(200, NULL, NULL);
+    }
+    index->capacity = capacity > 0 ? capacity : 64;
+    index->users = (PtrToUser*)malloc(sizeof(PtrToUser) * index->capacity);
+    if(index->users == NULL){
+        print_error(200, NULL, NULL);
+    }
+    index->count = 0;
+    return index;
+}
+
+/**
+ * @brief Borra un indice de nombres (los usuarios no se borran)
+ *
+ * @param index Indice a borrar
+*/
+void delete_userIndex(UserIndex index)
+{
+    if(index == NULL){
+        return;
+    }
+    free(index->users);
+    free(index);
+}
+
+/**
+ * @brief Funcion de comparacion de usuarios por nombre para qsort
+ *
+ * @param a Puntero al primer usuario
+ * @param b Puntero al segundo usuario
+ * @return Negativo, cero o positivo segun el orden alfabetico de los nombres
+*/
+int compare_users_byName(const void* a, const void* b)
+{
+    return strcmp((*(const PtrToUser*)a)->username, (*(const PtrToUser*)b)->username);
+}
+
+/**
+ * @brief Construye el indice de nombres con todos los usuarios de la tabla
+ *
+ * @param table Tabla de usuarios
+ * @return Indice construido
+ * @note Costo O(n log n), no carga ningun perfil
+*/
+UserIndex build_userIndex(UserTable table)
+{
+    UserIndex index = create_userIndex(table->userCount);
+    for(int ID=0; ID<table->idCount; ID++){
+        if(table->usersByID[ID]){
+            index->users[index->count++] = table->usersByID[ID];
+        }
+    }
+    qsort(index->users, index->count, sizeof(PtrToUser), compare_users_byName);
+    return index;
+}
+
+/**
+ * @brief Obtiene el indice de nombres de una tabla de usuarios, construyendolo si aun no existe
+ *
+ * @param table Tabla de usuarios
+ * @return Indice de nombres de la tabla
+*/
+UserIndex get_userIndex(UserTable table)
+{
+    if(table->nameIndex == NULL){
+        table->nameIndex = build_userIndex(table);
+    }
+    return table->nameIndex;
+}
+
+/**
+ * @brief Busca la primera posicion del indice cuyo nombre es mayor o igual a @p username (busqueda binaria)
+ *
+ * @param index Indice de nombres
+ * @param username Nombre a buscar
+ * @return Posicion encontrada (index->count si todos los nombres son menores)
+*/
+int find_userIndex_position(UserIndex index, const char* username)
+{
+    int low = 0, high = index->count;
+    while(low < high){
+        int mid = low + (high - low)/2;
+        if(strcmp(index->users[mid]->username, username) < 0){
+            low = mid + 1;
+        }
+        else{
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/**
+ * @brief Inserta un usuario en el indice manteniendo el orden
+ *
+ * @param index Indice de nombres
+ * @param user Usuario a insertar
+*/
+void insert_userIndex_user(UserIndex index, PtrToUser user)
+{
+    if(index->count == index->capacity){
+        int newCapacity = 2*index->capacity;
+        PtrToUser* newUsers = (PtrToUser*)realloc(index->users, sizeof(PtrToUser) * newCapacity);
+        if(newUsers == NULL){
+            print_error(200, NULL, NULL);
+        }
+        index->users = newUsers;
+        index->capacity = newCapacity;
+    }
+    int position = find_userIndex_position(index, user->username);
+    memmove(&index->users[position + 1], &index->users[position], sizeof(PtrToUser) * (index->count - position));
+    index->users[position] = user;
+    index->count++;
+}
+
+/**
+ * @brief Quita un usuario del indice
+ *
+ * @param index Indice de nombres
+ * @param user Usuario a quitar
+*/
+void remove_userIndex_user(UserIndex index, PtrToUser user)
+{
+    int position = find_userIndex_position(index, user->username);
+    if(position == index->count || index->users[position] != user){
+        return;
+    }
+    memmove(&index->users[position], &index->users[position + 1], sizeof(PtrToUser) * (index->count - position - 1));
+    index->count--;
+}
+
+/**
+ * @brief Busca el rango de usuarios cuyo nombre comienza con @p prefix
+ *
+ * El rango empieza en el primer nombre mayor o igual al prefijo y termina antes del primer nombre cuyos primeros
+ * caracteres ya son mayores que el prefijo.
+ *
+ * @param index Indice de nombres
+ * @param prefix Prefijo a buscar (vacio para todos los usuarios)
+ * @param first Donde se guarda la posicion del primer usuario del rango
+ * @return Cantidad de usuarios con el prefijo
+ * @note Costo O(log n)
+*/
+int find_userIndex_prefix(UserIndex index, const char* prefix, int* first)
+{
+    int length = strlen(prefix);
+    *first = find_userIndex_position(index, prefix);
+    if(length == 0){
+        return index->count;
+    }
+
+    // Buscamos el limite superior: el primer nombre que ya no comienza con el prefijo
+    int low = *first, high = index->count;
+    while(low < high){
+        int mid = low + (high - low)/2;
+        if(strncmp(index->users[mid]->username, prefix, length) <= 0){
+            low = mid + 1;
+        }
+        else{
+            high = mid;
+        }
+    }
+    return low - *first;
+}
+
+/**
+ * @brief Obtiene el indice de trigramas de los nombres de usuario, construyendolo si aun no existe
+ *
+ * @param table Tabla de usuarios
+ * @return Indice de trigramas, cuyos IDs son los IDs densos de los usuarios
+*/
+TrigramIndex get_user_trigrams(UserTable table)
+{
+    if(table->nameTrigrams == NULL){
+        table->nameTrigrams = create_trigramIndex(table->idCount);
+        for(int ID=0; ID<table->idCount; ID++){
+            if(table->usersByID[ID]){
+                insert_trigramIndex_name(table->nameTrigrams, ID, table->usersByID[ID]->username);
+            }
+        }
+    }
+    return table->nameTrigrams;
+}
+
+// Funciones de interaccion con el usuario
+
+/**
+ * @brief Imprime una pagina de un rango del indice de nombres
+ *
+ * @param index Indice de nombres
+ * @param first Posicion del primer usuario del rango
+ * @param count Cantidad de usuarios del rango
+ * @param page Pagina a imprimir (desde 0)
+*/
+void print_userIndex_page(UserIndex index, int first, int count, int page)
+{
+    int start = page * USER_PAGE_SIZE;
+    int end = start + USER_PAGE_SIZE < count ? start + USER_PAGE_SIZE : count;
+    int pages = (count + USER_PAGE_SIZE - 1) / USER_PAGE_SIZE;
+    for(int i=start; i<end; i++){
+        printf("%3d. "ANSI_COLOR_CYAN"%-10s"ANSI_COLOR_RESET, i + 1, index->users[first + i]->username);
+        if((i - start + 1) % 5 == 0){
+            printf("\n");
+        }
+    }
+    printf("\n\nPagina "ANSI_COLOR_MAGENTA"%d"ANSI_COLOR_RESET" de "ANSI_COLOR_MAGENTA"%d"ANSI_COLOR_RESET" (%d usuarios)\n\n", page + 1, pages > 0 ? pages : 1, count);
+}
+
+/**
+ * @brief Permite buscar usuarios por prefijo, recorrer los resultados por paginas y ver sus perfiles
+ *
+ * @param table Tabla de usuarios
+*/
+void browse_users(UserTable table)
+{
+    UserIndex index = get_userIndex(table);
+    char prefix[200];
+    printf("Ingrese el comienzo del nombre a buscar (* para todos): ");
+    if(scanf("%199s", prefix) != 1){
+        print_error(103, NULL, NULL);
+        return;
+    }
+    if(strcmp(prefix, "*") == 0){
+        prefix[0] = '\0';
+    }
+
+    int first;
+    int count = find_userIndex_prefix(index, prefix, &first);
+    if(count == 0){
+        printf("No hay usuarios cuyo nombre comience con "ANSI_COLOR_CYAN"%s"ANSI_COLOR_RESET"\n", prefix);
+        UserPosition suggestion = suggest_user(table, prefix);
+        if(suggestion){
+            printf(CLEAR_SCREEN);
+            print_user(suggestion);
+        }
+        return;
+    }
+
+    int page = 0, option = 0;
+    int pages = (count + USER_PAGE_SIZE - 1) / USER_PAGE_SIZE;
+    while(true){
+        printf(CLEAR_SCREEN);
+        print_userIndex_page(index, first, count, page);
+        printf("Ingrese el numero de un usuario para ver su perfil (0: siguiente pagina, -1: pagina anterior, -2: salir): ");
+        if(scanf("%d", &option) != 1){
+            print_error(103, NULL, NULL);
+            return;
+        }
+        if(option == -2){
+            return;
+        }
+        if(option == 0 || option == -1){
+            page = (page + (option == 0 ? 1 : pages - 1)) % pages;
+            continue;
+        }
+        if(option >= 1 && option <= count){
+            printf(CLEAR_SCREEN);
+            print_user(index->users[first + option - 1]);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Ofrece los usuarios con nombre parecido a uno que no existe y permite elegir uno
+ *
+ * @param table Tabla de usuarios
+ * @param username Nombre buscado, posiblemente mal escrito
+ * @return Usuario elegido, NULL si no hay nombres parecidos o no se eligio ninguno
+*/
+UserPosition suggest_user(UserTable table, const char* username)
+{
+    return find_userTable_node_byID(table, ask_trigramIndex_suggestion(get_user_trigrams(table), username));
+}
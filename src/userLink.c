@@ -129,6 +129,8 @@ UserLinkPosition insert_userLinkList_node_basicInfo(UserLinkPosition prevPositio
         print_error(200, NULL, NULL);
     }
     strcpy(newNode->userName, userName);
+    newNode->coefficient = 0;
+    newNode->userNode = NULL;
     newNode->next = prevPosition->next;
     prevPosition->next = newNode;
     return newNode;
@@ -151,6 +153,7 @@ UserLinkPosition insert_userLinkList_node_completeInfo(UserLinkPosition prevPosi
         print_error(200, NULL, NULL);
     }
     strcpy(newNode->userName, userNode->username);
+    newNode->coefficient = 0;
     newNode->userNode = userNode;
     newNode->next = prevPosition->next;
     prevPosition->next = newNode;
@@ -359,118 +362,146 @@ UserLinkPosition userLinkList_advance(UserLinkPosition P){
 /**
  * @brief encuentra recomendaciones de amigos para un usuario
  *
+ * Se realiza una busqueda en anchura sobre el grafo de amistades (IDs densos) usando un bitmap de visitados
+ * y una cola circular, por lo que el costo es lineal en los nodos y aristas alcanzados. A estos se suman los
+ * usuarios con gustos parecidos que entrega el indice LSH, sin importar su distancia en el grafo.
+ *
  * @param user Usuario a recomendar amigos
  * @param table Tabla de usuarios
- * @return Lista de amigos recomendados (amigos en tercer nivel)
- * @name Los usuarios son completados por esta funcion
+ * @param maxDepth Distancia maxima (en amistades) a la que se buscan usuarios (ver FRIENDS_SEARCH_DEPTH)
+ * @return Lista de amigos recomendados (usuarios a distancia 2 hasta @p maxDepth con la distancia en coefficient,
+ * seguidos de los usuarios parecidos segun el indice de gustos con coefficient 0)
+ * @name Los enlaces de la lista apuntan a su nodo de usuario
 */
-UserLinkPosition find_possible_friends(UserPosition user, UserTable table)
+UserLinkPosition find_possible_friends(UserPosition user, UserTable table, int maxDepth)
 {
-    //iniciaciones
-    UserLinkList friends;
-    UserLinkList visited = create_empty_userLinkList(NULL);
-    UserLinkList vecino;
-    UserLinkList queue = create_empty_userLinkList(NULL);
-
-    insert_userLinkList_node_basicInfo(queue, user->username);
-    UserLinkPosition rear = insert_userLinkList_node_basicInfo(visited, user->username);
-    rear->coefficient = 1.0; //nivel inicial (nivel 1)
-
-    //mientas que la cola no este vacia coefficient sea menor a 5.0
-    while(queue->next != NULL && visited->next->coefficient < 5.0){
-        //procesar nodo actual
-
-        #ifdef DEBUG
-            printf(" - %-10s: ---->   ",rear->userName);
-        #endif
-
-
-        // Obtener nodo de usuario correspondiente
-        UserPosition userNode = find_userTable_node(table, rear->userName);
-        if(userNode == NULL){
-            print_error(300, rear->userName, NULL);
-            return NULL;
-        }
-        complete_user_from_json(userNode);
-        friends = userNode->friends;
-
-        // Iterar sobre vecinos
-        vecino = friends->next;
-
-        while(vecino != NULL){
-            //si el amigo es nuevo, agregarlo a visitados
-            if(!find_userLinkList_node(visited, vecino->userName)&& rear->coefficient + 1 <= 4.0)
-                {
-                    //enqueue
-                    insert_userLinkList_node_basicInfo(queue, vecino->userName);
-                    queue->next->coefficient = rear->coefficient +1;
-                    #ifdef DEBUG
-                        printf("%-10s",vecino->userName);
-                    #endif
-                    insert_userLinkList_node_basicInfo(visited, vecino->userName);
-                    visited->next->coefficient = rear->coefficient +1;
+    FriendGraph graph = get_friendGraph(table);
+    UserLinkList candidates = create_empty_userLinkList(NULL);
+    UserLinkPosition last = candidates;
+    Bitmap visited = create_bitmap(table->idCount);
+    IDQueue queue = create_idQueue(64);
+
+    set_bitmap_bit(visited, user->ID);
+    enqueue_idQueue(queue, user->ID);
+
+    // Recorremos nivel por nivel, queue->count al inicio de cada nivel es su cantidad de nodos
+    for(int depth = 1; depth <= maxDepth && !is_empty_idQueue(queue); depth++){
+        int levelSize = queue->count;
+        for(int i=0; i<levelSize; i++){
+            int current = dequeue_idQueue(queue);
+            int* neighbors = friendGraph_neighbors(graph, current);
+            int degree = friendGraph_degree(graph, current);
+            #ifdef DEBUG
+                printf(" - %-10s: ---->   ", table->usersByID[current]->username);
+            #endif
+            for(int j=0; j<degree; j++){
+                if(!set_bitmap_bit(visited, neighbors[j])){ // Ya visitado
+                    continue;
                 }
-            vecino = vecino->next;
-        }
-        #ifdef DEBUG
-            printf("\n");
-        #endif
-
-        //dequeue
-        rear = find_userLinkList_prev_node(rear, queue);
-        if(rear == queue){
-            break;
+                #ifdef DEBUG
+                    printf("%-10s", table->usersByID[neighbors[j]]->username);
+                #endif
+                if(depth < maxDepth){
+                    enqueue_idQueue(queue, neighbors[j]);
+                }
+                // Los amigos directos (distancia 1) no se recomiendan
+                UserPosition neighbor = find_userTable_node_byID(table, neighbors[j]);
+                if(depth >= 2 && neighbor){
+                    last = insert_userLinkList_node_completeInfo(last, neighbor);
+                    last->coefficient = depth;
+                }
+            }
+            #ifdef DEBUG
+                printf("\n");
+            #endif
         }
-        delete_userLinkList_node(rear->next, queue);
     }
 
-    // Eliminamos el nodo correspondiente al usuario
-    delete_userLinkList_node(find_userLinkList_node(visited, user->username), visited);
+    // Marcamos como visitados a los amigos directos (pueden no haberse recorrido si maxDepth < 1)
+    int* neighbors = friendGraph_neighbors(graph, user->ID);
+    for(int j=0; j<friendGraph_degree(graph, user->ID); j++){
+        set_bitmap_bit(visited, neighbors[j]);
+    }
 
-    // Eliminamos los nodos que tengan coeficiente 2 (amigos directos)
-    UserLinkPosition aux = visited->next;
-    while(aux != NULL){
-        UserLinkPosition aux2 = aux->next;
-        if(aux->coefficient == 2.0){
-            delete_userLinkList_node(aux, visited);
+    // Agregamos a los usuarios con gustos parecidos aunque esten lejos en el grafo (coefficient 0: sin distancia)
+    complete_user_tasteSets(user, table);
+    Bitmap similar = create_bitmap(table->idCount);
+    query_tasteIndex(get_tasteIndex(table), user->ID, similar);
+    for(int ID = next_bitmap_bit(similar, 0); ID != -1; ID = next_bitmap_bit(similar, ID + 1)){
+        UserPosition similarUser = find_userTable_node_byID(table, ID);
+        if(similarUser && set_bitmap_bit(visited, ID)){
+            last = insert_userLinkList_node_completeInfo(last, similarUser);
+            last->coefficient = 0;
         }
-        aux = aux2;
     }
+    delete_bitmap(similar);
 
-    if(visited->next == NULL){ // Si no hay recomendaciones las recomendaciones son todos los usuarios de la web
+    if(candidates->next == NULL){ // Si no hay recomendaciones las recomendaciones son todos los usuarios de la web
         UserLinkList allUsers = get_loopweb_users(table, false); // Obtenemos todos los usuarios
         UserLinkPosition aux = allUsers->next;
         while(aux != NULL){
             // Si el usuario no es el propio y no esta en la lista de amigos, lo agregamos
-            if(aux->userName != user->username && !find_userLinkList_node(user->friends, aux->userName)){
-                insert_userLinkList_node_completeInfo(visited, aux->userNode);
+            if(!test_bitmap_bit(visited, aux->userNode->ID)){
+                last = insert_userLinkList_node_completeInfo(last, aux->userNode);
             }
             aux = aux->next;
         }
-
-        // Eliminamos el nodo correspondiente al usuario
-        delete_userLinkList_node(find_userLinkList_node(visited, user->username), visited);
         // Eliminamos las referencias a todos los usuarios de la tabla
         delete_userLinkList(allUsers);
     }
 
-    delete_userLinkList(queue);
-    return visited;
+    delete_idQueue(queue);
+    delete_bitmap(visited);
+    return candidates;
 }
 
-void print_user_recommendations(UserPosition user, UserLinkList recommendations)
+/**
+ * @brief Imprime una tabla con las recomendaciones de amistad de un usuario
+ *
+ * Junto al coeficiente se muestran los amigos en comun y los indices de Adamic-Adar y de asignacion de recursos.
+ *
+ * @param user Usuario al que se le recomienda
+ * @param recommendations Lista de recomendaciones
+ * @param table Tabla de usuarios
+*/
+void print_user_recommendations(UserPosition user, UserLinkList recommendations, UserTable table)
 {
     UserLinkPosition aux = recommendations->next;
+    FriendGraph graph = get_friendGraph(table);
     int counter = 1;
 
     printf("\t\t Posibles amigos para: "ANSI_COLOR_CYAN"%s"ANSI_COLOR_RESET" ("ANSI_COLOR_MAGENTA"%d"ANSI_COLOR_RESET"):\n", user->username, user->age);
-    printf("___________________________________________________________________________\n");
-    printf("| ID |        Nombre       |    Edad   |      Nacionalidad      |  Coef.  |\n");
+    printf("__________________________________________________________________________________________________\n");
+    printf("| ID |        Nombre       |    Edad   |      Nacionalidad      | Mutuos |  A-A  |  R.A. |  Coef.  |\n");
     while(aux != NULL){
-        printf("| %-3d|        "ANSI_COLOR_CYAN"%-13s"ANSI_COLOR_RESET"|"ANSI_COLOR_MAGENTA"    %-7d"ANSI_COLOR_RESET"|"ANSI_COLOR_YELLOW"      %-18s"ANSI_COLOR_RESET"|  %-5.3f  |\n", counter, aux->userName, aux->userNode->age, aux->userNode->nationality, aux->coefficient);
+        GraphSignals signals = friendGraph_signals(graph, user->ID, aux->userNode->ID);
+        printf("| %-3d|        "ANSI_COLOR_CYAN"%-13s"ANSI_COLOR_RESET"|"ANSI_COLOR_MAGENTA"    %-7d"ANSI_COLOR_RESET"|"ANSI_COLOR_YELLOW"      %-18s"ANSI_COLOR_RESET"|  %-4d  | %-5.2f | %-5.2f |  %-5.3f  |\n", counter, aux->userName, aux->userNode->age, aux->userNode->nationality, signals.mutualFriends, signals.adamicAdar, signals.resourceAllocation, aux->coefficient);
         counter++;
         aux = aux->next;
     }
-    printf("___________________________________________________________________________\n");
+    printf("__________________________________________________________________________________________________\n");
     printf("\n");
+}
+
+/**
+ * @brief Imprime el camino de amistades entre dos usuarios
+ *
+ * @param user Usuario de origen
+ * @param target Usuario de destino
+ * @param path Lista con los usuarios del camino (ver `find_friendship_path`), NULL si no estan conectados
+*/
+void print_friendship_path(UserPosition user, UserPosition target, UserLinkList path)
+{
+    if(path == NULL){
+        printf(ANSI_COLOR_CYAN"%s"ANSI_COLOR_RESET" y "ANSI_COLOR_CYAN"%s"ANSI_COLOR_RESET" no estan conectados (a %d grados o menos)\n", user->username, target->username, GRAPH_PATH_MAX_DEPTH);
+        return;
+    }
+    int degrees = -1;
+    for(UserLinkPosition aux = path->next; aux != NULL; aux = aux->next){
+        degrees++;
+    }
+    printf("Grados de separacion entre "ANSI_COLOR_CYAN"%s"ANSI_COLOR_RESET" y "ANSI_COLOR_CYAN"%s"ANSI_COLOR_RESET": "ANSI_COLOR_MAGENTA"%d"ANSI_COLOR_RESET"\n", user->username, target->username, degrees);
+    for(UserLinkPosition aux = path->next; aux != NULL; aux = aux->next){
+        printf(ANSI_COLOR_CYAN"%s"ANSI_COLOR_RESET"%s", aux->userName, aux->next ? " -> " : "\n");
+    }
 }
\ No newline at end of file
@@ -42,6 +42,21 @@ void remove_punctuation(char* s1)
     }
 }
 
+/**
+ * @brief Reemplaza una cadena con memoria reservada por una copia de otra
+ * @param str Puntero a la cadena a reemplazar (se libera)
+ * @param value Nueva cadena
+*/
+void replace_string(char** str, const char* value){
+    char* copy = malloc(strlen(value) + 1);
+    if(copy == NULL){
+        print_error(200,NULL,NULL);
+    }
+    strcpy(copy, value);
+    free(*str);
+    *str = copy;
+}
+
 /**
  * @brief conserva solo el nombre del archivo sin extension
  * @param file Nombre del archivo
@@ -116,44 +131,12 @@ bool is_valid_extension(char* extension)
  * @brief Esta funcion imprime una cadena de caracteres en la consola, resaltando las palabras que comienzan con @ y con #.
  *
  * @param str Cadena de caracteres a imprimir
+ * @note Para imprimir muchos textos seguidos conviene usar `render_loopweb` con un solo buffer
 */
 void print_loopweb(char* str){
-    char* line = malloc(sizeof(char) * strlen(str) + 1); // Copiamos la cadena de caracteres
-    strcpy(line, str);
-
-    char *token = strtok(line, " "); // Dividimos la linea en palabras
-    while (token != NULL) {
-        char *ptr = token; // Puntero para recorrer la palabra
-        while (*ptr != '\0') {
-            if (*ptr == '@') {
-                // Imprime y colorea todo el segmento que empieza con '@'
-                printf(ANSI_COLOR_GREEN"@");
-                ptr++;
-                while (*ptr != '\0' && *ptr != '@' && *ptr != '#' && *ptr != '\n') {
-                    putchar(*ptr);
-                    ptr++;
-                }
-                printf(ANSI_COLOR_RESET);
-            } else if (*ptr == '#') {
-                // Imprime y colorea todo el segmento que empieza con '#'
-                printf(ANSI_COLOR_RED"#");
-                ptr++;
-                while (*ptr != '\0' && *ptr != '@' && *ptr != '#' && *ptr != '\n') {
-                    putchar(*ptr);
-                    ptr++;
-                }
-                printf(ANSI_COLOR_RESET);
-            } else {
-                // Imprime caracteres normales sin colorear
-                putchar(*ptr);
-                ptr++;
-            }
-        }
-        token = strtok(NULL, " "); // Siguiente palabra
-        printf(" "); // Espacio entre palabras
-    }
-    printf("\b"); // Borra el ultimo espacio
-    free(line);
+    RenderBuffer buffer = create_renderBuffer(STDOUT_FILENO);
+    render_loopweb(buffer, str);
+    delete_renderBuffer(buffer);
 }
 
 // Funciones para usar como parametros
@@ -178,29 +161,6 @@ bool decreasing(double a, double b){
     return a >= b;
 }
 
-// Tiempo
-
-/**
- * @brief Imprime una fecha en formato YYYY-MM-DD HH:MM:SS +ZZZZ
- *
- * @param time Tiempo a imprimir
-*/
-void print_date(time_t time)
-{
-    struct tm *local = localtime(&time);  // Convertir a tiempo local
-    tzset(); // Inicializar la información de la zona horaria
-
-    char string[24];
-
-    if(strftime(string, 24, "%Y-%m-%d %H:%M:%S %Z",local) == 0)
-    {
-        print_error(102, NULL, NULL);
-        return;
-    }
-
-    printf("%s", string);
-}
-
 // Otras funciones
 
 /**
@@ -215,6 +175,12 @@ void print_loopweb_help()
     printf("║  Para ver la " ANSI_COLOR_GREEN "ayuda del programa" ANSI_COLOR_RESET ", ingrese la opción '-h' o '--help'                ║\n");
     printf("║  Para ingresar como " ANSI_COLOR_BLUE "administrador" ANSI_COLOR_RESET ", ingrese la opción '-a' o '--admin'             ║\n");
     printf("║  Para ingresar como " ANSI_COLOR_CYAN "usuario" ANSI_COLOR_RESET ", ingrese la opción '-u <nombre>' o '--user <nombre>'  ║\n");
+    printf("║  Para " ANSI_COLOR_MAGENTA "precalcular recomendaciones" ANSI_COLOR_RESET ", ingrese la opción '-p' o '--precompute-recs'   ║\n");
+    printf("║  Para ejecutar " ANSI_COLOR_YELLOW "comandos" ANSI_COLOR_RESET ", ingrese la opción '-s <archivo>' o '--script <archivo>'  ║\n");
+    printf("║  Para iniciar el " ANSI_COLOR_GREEN "servidor" ANSI_COLOR_RESET ", ingrese la opción '-S <socket>' o '--serve <socket>'   ║\n");
+    printf("║  Para usar el " ANSI_COLOR_BLUE "cliente" ANSI_COLOR_RESET ", ingrese la opción '-c <socket>' o '--client <socket>'      ║\n");
+    printf("║  Para " ANSI_COLOR_RED "medir el servidor" ANSI_COLOR_RESET ", ingrese la opción '-L <socket>' o '--load <socket>'       ║\n");
+    printf("║  Para " ANSI_COLOR_YELLOW "medir el rendimiento" ANSI_COLOR_RESET ", ingrese la opción '-b' o '--bench'                    ║\n");
     printf("║                                                                                   ║\n");
     printf("║      La ejecusión del programa es de la forma "ANSI_COLOR_RED"./build/loopweb.out [opción]"ANSI_COLOR_RESET"        ║\n");
     printf("╚═══════════════════════════════════════════════════════════════════════════════════╝\n");